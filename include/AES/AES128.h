@@ -19,6 +19,8 @@
 #include <string.h>
 
 #include "AES_common.h"
+#include "AES_gcm.h"
+#include "AES_mb.h"
 #include "PKCS7.h"
 
 #ifdef __cplusplus
@@ -26,9 +28,10 @@ extern "C" {
 #endif
 
 /**
- * @brief Macro para definición de máximo tamaño de buffer, para los casos en
+ * @brief Macro para definición de tamaño de buffer sugerido, para los casos en
  * los que no se requiere asignación dinámica de memoria. Por ejemplo:
- * microcontroladores.
+ * microcontroladores. Las funciones no limitan la longitud de entrada; para
+ * datos más grandes se puede usar la API de streaming.
  *
  */
 #define AES128_MAX_BUFFER_SIZE 256
@@ -62,13 +65,87 @@ typedef struct AES128_ctx {
         uint32_t words[AES128_FIXED_KEY_SIZE / 4];
     } key;                      // Key with both byte and word access
     uint8_t iv[AES_BLOCK_LEN];  // Initialization vector for CBC and CTR modes
+    uint8_t round_keys[AES128_KEY_EXP_SIZE];      // Expanded encryption key
+    uint8_t inv_round_keys[AES128_KEY_EXP_SIZE];  // Equivalent inverse key
     size_t input_len_normalized;
     uint32_t encrypted_chunks;
     uint32_t decrypted_chunks;
+    AES_stream_t stream;  // Streaming state (partial block, CBC chaining)
+    AES_ctr_t ctr;        // CTR mode counter and unused keystream
+    AES_gcm_key_t gcm_key;  // GHASH tables derived from the key
+    bool gcm_key_ready;     // gcm_key matches the key, built on first use
+    AES_gcm_t gcm;          // GCM message state
 } AES128_ctx_t;
 
 void AES128_init_ctx(AES128_ctx_t *ctx, const uint8_t *key, const uint8_t *iv);
 
+/**
+ * @brief Replaces the key of an AES-128 context
+ *
+ * Both key schedules are expanded once here and reused for every block, so
+ * this is the only place where key expansion cost is paid. The GHASH key is
+ * derived on the next GCM message instead. The IV and chunk counters are
+ * left untouched.
+ *
+ * @param ctx AES context to update
+ * @param key New 16-byte (128-bit) key
+ */
+void AES128_rekey(AES128_ctx_t *ctx, const uint8_t *key);
+
+/**
+ * @brief Starts a streaming AES-128 encryption
+ *
+ * The CBC chaining value starts from the IV stored in the context. The
+ * context IV itself is not modified by streaming operations.
+ *
+ * @param ctx AES context containing key and IV
+ * @param mode Block cipher mode (ECB or CBC)
+ * @param use_padding Boolean flag to enable PKCS7 padding (zero padding
+ * otherwise)
+ */
+void AES128_encrypt_init(AES128_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding);
+
+/**
+ * @brief Starts a streaming AES-128 decryption
+ *
+ * @param ctx AES context containing key and IV
+ * @param mode Block cipher mode (ECB or CBC)
+ * @param use_padding Boolean flag to enable PKCS7 padding removal
+ */
+void AES128_decrypt_init(AES128_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding);
+
+/**
+ * @brief Feeds the next piece of data to a streaming operation
+ *
+ * Input may have any length. Whole blocks are written straight to out and
+ * the remainder is kept in the context, so out must have room for
+ * input_len + 15 bytes. in and out may point to the same buffer.
+ *
+ * @param ctx AES context initialized with encrypt_init or decrypt_init
+ * @param in Input data buffer
+ * @param out Output data buffer
+ * @param input_len Length of input data in bytes
+ * @param output_len Pointer to store the number of bytes written
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_update(AES128_ctx_t *ctx, const void *in, void *out,
+                            size_t input_len, size_t *output_len);
+
+/**
+ * @brief Finishes a streaming operation
+ *
+ * Encryption writes the last (padded) block. Decryption checks that the
+ * ciphertext was a whole number of blocks and strips the PKCS7 padding.
+ *
+ * @param ctx AES context
+ * @param out Output data buffer (at most 16 bytes are written)
+ * @param output_len Pointer to store the number of bytes written
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_final(AES128_ctx_t *ctx, void *out, size_t *output_len);
+
 /**
  * @brief AES-128 ECB mode encryption with optional PKCS7 padding
  *
@@ -129,6 +206,188 @@ AES_errcode_t AES128_CBC_decrypt(AES128_ctx_t *ctx, void *in, void *out,
                                  size_t input_len, size_t *output_len,
                                  bool use_padding);
 
+/**
+ * @brief Restarts CTR mode from the IV with a given counter width
+ *
+ * The IV is the initial counter block. Only its lowest counter_bits bits are
+ * incremented, as a big-endian number that wraps around; the other bits are
+ * a fixed nonce. The context starts with a 128-bit counter.
+ *
+ * @param ctx AES context containing key and IV
+ * @param counter_bits Counter width in bits (1 to 128, e.g. 32 or 64)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT if the
+ * width is out of range
+ */
+AES_errcode_t AES128_CTR_init(AES128_ctx_t *ctx, size_t counter_bits);
+
+/**
+ * @brief Moves CTR mode to a block offset from the start of the message
+ *
+ * The next byte processed is byte 16 * block_offset of the message.
+ *
+ * @param ctx AES context containing key and IV
+ * @param block_offset Offset in 16-byte blocks
+ */
+void AES128_CTR_seek(AES128_ctx_t *ctx, uint64_t block_offset);
+
+/**
+ * @brief Encrypts or decrypts data in CTR mode (both are the same operation)
+ *
+ * Any length is accepted and no padding is added, the output has the same
+ * length as the input. Consecutive calls continue the same keystream, so a
+ * message can be processed in pieces of any size. Large buffers are split
+ * across the AES thread pool (see AES_set_thread_pool()).
+ *
+ * @param ctx AES context containing key and IV
+ * @param in Input data buffer
+ * @param out Output data buffer, may be the same as in
+ * @param len Length of data in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_CTR_xcrypt(AES128_ctx_t *ctx, const void *in, void *out,
+                                size_t len);
+
+/**
+ * @brief Starts a GCM encryption
+ *
+ * GCM does not use the IV stored in the context: every message takes its own
+ * IV, which must never repeat for the same key.
+ *
+ * @param ctx AES context containing key
+ * @param iv Initialization vector
+ * @param iv_len IV length in bytes (12 recommended, any non-zero length)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * empty IV
+ */
+AES_errcode_t AES128_GCM_encrypt_init(AES128_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len);
+
+/**
+ * @brief Starts a GCM decryption
+ *
+ * @param ctx AES context containing key
+ * @param iv Initialization vector used for encryption
+ * @param iv_len IV length in bytes
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * empty IV
+ */
+AES_errcode_t AES128_GCM_decrypt_init(AES128_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len);
+
+/**
+ * @brief Adds additional authenticated data (authenticated, not encrypted)
+ *
+ * May be called several times, but only before the first AES128_GCM_update().
+ *
+ * @param ctx AES context containing key
+ * @param aad Additional authenticated data
+ * @param aad_len Length of aad in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_GCM_update_aad(AES128_ctx_t *ctx, const void *aad,
+                                    size_t aad_len);
+
+/**
+ * @brief Encrypts or decrypts the next piece of a GCM message
+ *
+ * Pieces may have any length; the output has the same length as the input.
+ * Decrypted data must not be used before AES128_GCM_decrypt_final() succeeds.
+ *
+ * @param ctx AES context containing key
+ * @param in Input data buffer
+ * @param out Output data buffer, may be the same as in
+ * @param len Length of data in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_GCM_update(AES128_ctx_t *ctx, const void *in, void *out,
+                                size_t len);
+
+/**
+ * @brief Finishes a GCM encryption and writes the authentication tag
+ *
+ * @param ctx AES context containing key
+ * @param tag Output tag buffer
+ * @param tag_len Tag length in bytes (4 to 16, 16 recommended)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * unsupported tag length
+ */
+AES_errcode_t AES128_GCM_encrypt_final(AES128_ctx_t *ctx, uint8_t *tag,
+                                       size_t tag_len);
+
+/**
+ * @brief Finishes a GCM decryption and checks the authentication tag
+ *
+ * @param ctx AES context containing key
+ * @param tag Expected tag
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t AES_CODE_OK if the message is authentic,
+ * AES_CODE_AUTHENTICATION_FAILED otherwise
+ */
+AES_errcode_t AES128_GCM_decrypt_final(AES128_ctx_t *ctx, const uint8_t *tag,
+                                       size_t tag_len);
+
+/**
+ * @brief One-shot GCM authenticated encryption
+ *
+ * @param ctx AES context containing key
+ * @param iv Initialization vector
+ * @param iv_len IV length in bytes
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len Length of aad in bytes
+ * @param in Plaintext buffer
+ * @param out Ciphertext buffer (same length), may be the same as in
+ * @param len Length of data in bytes (may be 0)
+ * @param tag Output tag buffer
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES128_GCM_encrypt(AES128_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief One-shot GCM authenticated decryption
+ *
+ * On authentication failure the output is cleared, so unauthenticated
+ * plaintext is never released.
+ *
+ * @param ctx AES context containing key
+ * @param iv Initialization vector used for encryption
+ * @param iv_len IV length in bytes
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len Length of aad in bytes
+ * @param in Ciphertext buffer
+ * @param out Plaintext buffer (same length), may be the same as in
+ * @param len Length of data in bytes (may be 0)
+ * @param tag Expected tag
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t AES_CODE_OK if the message is authentic,
+ * AES_CODE_AUTHENTICATION_FAILED otherwise
+ */
+AES_errcode_t AES128_GCM_decrypt(AES128_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 const uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief Prepares a multi-buffer CBC encryption job (see AES_mb.h)
+ *
+ * The job takes a copy of the context IV and points to its key schedule, so
+ * the context must stay unchanged until the job completes. The result is
+ * the same as AES128_CBC_encrypt().
+ *
+ * @param ctx AES context containing key and IV
+ * @param job Job to fill; user_data is cleared
+ * @param in Input data buffer
+ * @param out Output data buffer, room for the padded length, may be the same
+ * as in
+ * @param input_len Length of input data in bytes
+ * @param use_padding Boolean flag to enable/disable PKCS7 padding
+ */
+void AES128_CBC_mb_job(AES128_ctx_t *ctx, AES_mb_job_t *job, const void *in,
+                       void *out, size_t input_len, bool use_padding);
+
 #ifdef __cplusplus
 }
 #endif
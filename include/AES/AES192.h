@@ -18,6 +18,8 @@
 #include <string.h>
 
 #include "AES_common.h"
+#include "AES_gcm.h"
+#include "AES_mb.h"
 #include "PKCS7.h"
 
 /**
@@ -42,10 +44,10 @@
 #define AES192_KEY_EXP_SIZE 208
 
 /**
- * @brief Maximum buffer size for operations
+ * @brief Suggested buffer size for statically allocated buffers
  *
- * Defines the maximum allowed buffer size for encryption/decryption operations.
- * This limit helps prevent buffer overflow in memory-constrained environments.
+ * Useful in memory-constrained environments. Operations do not limit the
+ * input length; larger data can also be processed with the streaming API.
  */
 #define AES192_MAX_BUFFER_SIZE 1024
 
@@ -60,10 +62,17 @@ typedef struct {
         uint8_t array[AES192_FIXED_KEY_SIZE];      /* Byte-level key access */
         uint32_t words[AES192_FIXED_KEY_SIZE / 4]; /* Word-level key access */
     } key;
-    uint8_t iv[AES_BLOCK_LEN];   /* Initialization vector for CBC mode */
+    uint8_t iv[AES_BLOCK_LEN];   /* IV for CBC, initial counter for CTR */
+    uint8_t round_keys[AES192_KEY_EXP_SIZE];     /* Expanded encryption key */
+    uint8_t inv_round_keys[AES192_KEY_EXP_SIZE]; /* Equivalent inverse key */
     size_t input_len_normalized; /* Normalized input length */
     uint32_t encrypted_chunks;   /* Count of encrypted blocks */
     uint32_t decrypted_chunks;   /* Count of decrypted blocks */
+    AES_stream_t stream;         /* Streaming state */
+    AES_ctr_t ctr;               /* CTR counter and unused keystream */
+    AES_gcm_key_t gcm_key;       /* GHASH tables derived from the key */
+    bool gcm_key_ready;          /* gcm_key matches the key, built on use */
+    AES_gcm_t gcm;               /* GCM message state */
 } AES192_ctx_t;
 
 /**
@@ -84,6 +93,71 @@ void AES192_init_ctx(AES192_ctx_t *ctx, const uint8_t *key, const uint8_t *iv);
  */
 void AES192_init_ctx_ecb(AES192_ctx_t *ctx, const uint8_t *key);
 
+/**
+ * @brief Replace the key of an AES-192 context
+ *
+ * Expands the encryption and decryption key schedules once so that they are
+ * reused by every block operation. The GHASH key is derived on the next GCM
+ * message. IV and chunk counters are preserved.
+ *
+ * @param ctx Pointer to AES-192 context structure
+ * @param key New 24-byte (192-bit) encryption key
+ */
+void AES192_rekey(AES192_ctx_t *ctx, const uint8_t *key);
+
+/**
+ * @brief Start a streaming AES-192 encryption
+ *
+ * The CBC chaining value starts from the IV stored in the context, which is
+ * not modified by streaming operations.
+ *
+ * @param ctx AES-192 context with initialized key (and IV for CBC)
+ * @param mode Block cipher mode (ECB or CBC)
+ * @param use_padding True for PKCS7 padding, false for zero padding
+ */
+void AES192_encrypt_init(AES192_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding);
+
+/**
+ * @brief Start a streaming AES-192 decryption
+ *
+ * @param ctx AES-192 context with initialized key (and IV for CBC)
+ * @param mode Block cipher mode (ECB or CBC)
+ * @param use_padding True for PKCS7 padding removal
+ */
+void AES192_decrypt_init(AES192_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding);
+
+/**
+ * @brief Process the next piece of a streaming operation
+ *
+ * Input may have any length. Whole blocks are written directly to out and
+ * the remainder is kept in the context, so out must have room for
+ * input_len + 15 bytes. In-place operation (in == out) is supported.
+ *
+ * @param ctx AES-192 context started with encrypt_init or decrypt_init
+ * @param in Input data buffer
+ * @param out Output data buffer
+ * @param input_len Length of input data in bytes
+ * @param output_len Pointer to store the number of bytes written
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_update(AES192_ctx_t *ctx, const void *in, void *out,
+                            size_t input_len, size_t *output_len);
+
+/**
+ * @brief Finish a streaming operation
+ *
+ * Encryption writes the last padded block; decryption validates the length
+ * and removes the PKCS7 padding.
+ *
+ * @param ctx AES-192 context
+ * @param out Output data buffer (at most 16 bytes are written)
+ * @param output_len Pointer to store the number of bytes written
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_final(AES192_ctx_t *ctx, void *out, size_t *output_len);
+
 /**
  * @brief Encrypt data using AES-192 in ECB mode
  *
@@ -144,4 +218,186 @@ AES_errcode_t AES192_CBC_decrypt(AES192_ctx_t *ctx, const void *in, void *out,
                                  size_t input_len, size_t *output_len,
                                  bool usePKCS7);
 
+/**
+ * @brief Restarts CTR mode from the IV with a given counter width
+ *
+ * The IV is the initial counter block. Only its lowest counter_bits bits are
+ * incremented, as a big-endian number that wraps around; the other bits are
+ * a fixed nonce. The context starts with a 128-bit counter.
+ *
+ * @param ctx AES-192 context with initialized key and IV
+ * @param counter_bits Counter width in bits (1 to 128, e.g. 32 or 64)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT if the
+ * width is out of range
+ */
+AES_errcode_t AES192_CTR_init(AES192_ctx_t *ctx, size_t counter_bits);
+
+/**
+ * @brief Moves CTR mode to a block offset from the start of the message
+ *
+ * The next byte processed is byte 16 * block_offset of the message.
+ *
+ * @param ctx AES-192 context with initialized key and IV
+ * @param block_offset Offset in 16-byte blocks
+ */
+void AES192_CTR_seek(AES192_ctx_t *ctx, uint64_t block_offset);
+
+/**
+ * @brief Encrypts or decrypts data in CTR mode (both are the same operation)
+ *
+ * Any length is accepted and no padding is added, the output has the same
+ * length as the input. Consecutive calls continue the same keystream, so a
+ * message can be processed in pieces of any size. Large buffers are split
+ * across the AES thread pool (see AES_set_thread_pool()).
+ *
+ * @param ctx AES-192 context with initialized key and IV
+ * @param in Input data buffer
+ * @param out Output data buffer, may be the same as in
+ * @param len Length of data in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_CTR_xcrypt(AES192_ctx_t *ctx, const void *in, void *out,
+                                size_t len);
+
+/**
+ * @brief Starts a GCM encryption
+ *
+ * GCM does not use the IV stored in the context: every message takes its own
+ * IV, which must never repeat for the same key.
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param iv Initialization vector
+ * @param iv_len IV length in bytes (12 recommended, any non-zero length)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * empty IV
+ */
+AES_errcode_t AES192_GCM_encrypt_init(AES192_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len);
+
+/**
+ * @brief Starts a GCM decryption
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param iv Initialization vector used for encryption
+ * @param iv_len IV length in bytes
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * empty IV
+ */
+AES_errcode_t AES192_GCM_decrypt_init(AES192_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len);
+
+/**
+ * @brief Adds additional authenticated data (authenticated, not encrypted)
+ *
+ * May be called several times, but only before the first AES192_GCM_update().
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param aad Additional authenticated data
+ * @param aad_len Length of aad in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_GCM_update_aad(AES192_ctx_t *ctx, const void *aad,
+                                    size_t aad_len);
+
+/**
+ * @brief Encrypts or decrypts the next piece of a GCM message
+ *
+ * Pieces may have any length; the output has the same length as the input.
+ * Decrypted data must not be used before AES192_GCM_decrypt_final() succeeds.
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param in Input data buffer
+ * @param out Output data buffer, may be the same as in
+ * @param len Length of data in bytes
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_GCM_update(AES192_ctx_t *ctx, const void *in, void *out,
+                                size_t len);
+
+/**
+ * @brief Finishes a GCM encryption and writes the authentication tag
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param tag Output tag buffer
+ * @param tag_len Tag length in bytes (4 to 16, 16 recommended)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * unsupported tag length
+ */
+AES_errcode_t AES192_GCM_encrypt_final(AES192_ctx_t *ctx, uint8_t *tag,
+                                       size_t tag_len);
+
+/**
+ * @brief Finishes a GCM decryption and checks the authentication tag
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param tag Expected tag
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t AES_CODE_OK if the message is authentic,
+ * AES_CODE_AUTHENTICATION_FAILED otherwise
+ */
+AES_errcode_t AES192_GCM_decrypt_final(AES192_ctx_t *ctx, const uint8_t *tag,
+                                       size_t tag_len);
+
+/**
+ * @brief One-shot GCM authenticated encryption
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param iv Initialization vector
+ * @param iv_len IV length in bytes
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len Length of aad in bytes
+ * @param in Plaintext buffer
+ * @param out Ciphertext buffer (same length), may be the same as in
+ * @param len Length of data in bytes (may be 0)
+ * @param tag Output tag buffer
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t Error code (AES_CODE_OK on success)
+ */
+AES_errcode_t AES192_GCM_encrypt(AES192_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief One-shot GCM authenticated decryption
+ *
+ * On authentication failure the output is cleared, so unauthenticated
+ * plaintext is never released.
+ *
+ * @param ctx AES-192 context with initialized key
+ * @param iv Initialization vector used for encryption
+ * @param iv_len IV length in bytes
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len Length of aad in bytes
+ * @param in Ciphertext buffer
+ * @param out Plaintext buffer (same length), may be the same as in
+ * @param len Length of data in bytes (may be 0)
+ * @param tag Expected tag
+ * @param tag_len Tag length in bytes (4 to 16)
+ * @return AES_errcode_t AES_CODE_OK if the message is authentic,
+ * AES_CODE_AUTHENTICATION_FAILED otherwise
+ */
+AES_errcode_t AES192_GCM_decrypt(AES192_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 const uint8_t *tag, size_t tag_len);
+
+/**
+ * @brief Prepares a multi-buffer CBC encryption job (see AES_mb.h)
+ *
+ * The job takes a copy of the context IV and points to its key schedule, so
+ * the context must stay unchanged until the job completes. The result is
+ * the same as AES192_CBC_encrypt().
+ *
+ * @param ctx AES-192 context with initialized key and IV
+ * @param job Job to fill; user_data is cleared
+ * @param in Input data buffer
+ * @param out Output data buffer, room for the padded length, may be the same
+ * as in
+ * @param input_len Length of input data in bytes
+ * @param use_padding Boolean flag to enable/disable PKCS7 padding
+ */
+void AES192_CBC_mb_job(AES192_ctx_t *ctx, AES_mb_job_t *job, const void *in,
+                       void *out, size_t input_len, bool use_padding);
+
 #endif /* AES192_H */
@@ -12,16 +12,65 @@
 #ifndef AES_COMMON_H
 #define AES_COMMON_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
+#include "thread_pool.h"
+
 /**
  * @brief AES block size in bytes. This value MUST NOT be modified.
  *
  */
 #define AES_BLOCK_LEN 16
 
+/**
+ * @brief Selects the AES round engine
+ *
+ * When enabled (set to 1), SubBytes, ShiftRows and MixColumns are merged into
+ * four 256-entry 32-bit lookup tables per direction (8 KiB of program memory)
+ * and every round is computed with word XORs. When disabled, the compact
+ * byte-oriented round functions are used, which is the preferred choice for
+ * memory-constrained targets.
+ */
+#ifndef AES_USE_T_TABLES
+#define AES_USE_T_TABLES 0
+#endif
+
+/**
+ * @brief Default width in bits of the CTR mode counter (the whole block)
+ */
+#define AES_CTR_DEFAULT_COUNTER_BITS 128
+
+/**
+ * @brief Number of CTR keystream blocks generated per batch
+ */
+#define AES_CTR_BATCH_BLOCKS 8
+
+/**
+ * @brief Minimum CTR input length in bytes before the work is split across
+ * the threads of the AES thread pool
+ */
+#ifndef AES_CTR_PARALLEL_THRESHOLD
+#define AES_CTR_PARALLEL_THRESHOLD (1024 * 1024)
+#endif
+
+/**
+ * @brief Number of blocks per batch in the portable CBC decryption. The
+ * blocks of a batch are independent; their ciphertext is saved once for the
+ * chaining of the whole batch
+ */
+#define AES_CBC_BATCH_BLOCKS 4
+
+/**
+ * @brief Minimum CBC ciphertext length in bytes before decryption is split
+ * across the threads of the AES thread pool
+ */
+#ifndef AES_CBC_PARALLEL_THRESHOLD
+#define AES_CBC_PARALLEL_THRESHOLD (1024 * 1024)
+#endif
+
 /**
  * @brief Enumeration of error codes for AES functions
  *
@@ -29,10 +78,62 @@
 typedef enum AES_errcode {
     AES_CODE_OK,                     // Operation completed successfully
     AES_CODE_EMPTY_INPUT_BUFFER,     // Empty input buffer
-    AES_CODE_INCORRECT_BUFFER_SIZE,  // Normalized input length exceeds max
-                                     // buffer size
+    AES_CODE_INCORRECT_BUFFER_SIZE,  // Input length is not valid for the
+                                     // selected mode
+    AES_CODE_INVALID_PADDING,        // Decrypted PKCS7 padding is malformed
+    AES_CODE_INVALID_ARGUMENT,       // Parameter out of range
+    AES_CODE_AUTHENTICATION_FAILED,  // Authentication tag mismatch
 } AES_errcode_t;
 
+/**
+ * @brief Block cipher backends available at runtime
+ *
+ */
+typedef enum AES_backend {
+    AES_BACKEND_PORTABLE,  // Portable C implementation (byte or T-table engine)
+    AES_BACKEND_AESNI,     // x86 AES-NI instructions
+} AES_backend_t;
+
+/**
+ * @brief Block cipher modes supported by the streaming API
+ *
+ */
+typedef enum AES_mode {
+    AES_MODE_ECB,  // Electronic codebook
+    AES_MODE_CBC,  // Cipher block chaining
+} AES_mode_t;
+
+/**
+ * @brief Streaming state shared by every key size
+ *
+ * Carries the bytes of an incomplete block and the CBC chaining value between
+ * update calls, so input can be fed in pieces of any size.
+ */
+typedef struct AES_stream {
+    uint8_t buffer[AES_BLOCK_LEN];  // Partial block (or held back last block)
+    uint8_t chain[AES_BLOCK_LEN];   // CBC chaining value
+    size_t buffered;                // Number of valid bytes in buffer
+    size_t blocks;                  // Blocks processed since init
+    AES_mode_t mode;                // Block cipher mode
+    bool encrypt;                   // Direction, true for encryption
+    bool use_padding;               // PKCS7 padding (true) or zero padding
+} AES_stream_t;
+
+/**
+ * @brief CTR mode state shared by every key size
+ *
+ * The counter block is a 128-bit big-endian number. Only its lowest
+ * counter_bits bits are incremented (wrapping around), the rest of the block
+ * stays fixed as a nonce. Unused keystream bytes of the last block are kept
+ * so a message can be processed in pieces of any size.
+ */
+typedef struct AES_ctr {
+    uint8_t counter[AES_BLOCK_LEN];    // Next counter block
+    uint8_t keystream[AES_BLOCK_LEN];  // Keystream of the last partial block
+    size_t keystream_used;             // Consumed keystream bytes (16: none)
+    size_t counter_bits;               // Width of the incrementing counter
+} AES_ctr_t;
+
 /**
  * @brief Data structure for initialization vector
  *
@@ -130,7 +231,7 @@ uint8_t gmul(uint8_t rhs, uint8_t lhs);
  * @param plain_text Pointer to state array
  * @param roundKey Pointer to round key
  */
-void AddRoundKey(uint8_t *plain_text, uint8_t *roundKey);
+void AddRoundKey(uint8_t *plain_text, const uint8_t *roundKey);
 
 /**
  * @brief Applies S-Box substitution to state
@@ -168,4 +269,245 @@ void ReverseShiftRows(uint8_t *plain_text);
  */
 void ReverseMixColumns(uint8_t *plain_text);
 
+/**
+ * @brief Derives the decryption key schedule of the "equivalent inverse
+ * cipher" (FIPS-197, section 5.3.5) from an expanded encryption key schedule
+ *
+ * Round keys are stored in the order the inverse cipher consumes them, and
+ * the inner ones already have InvMixColumns applied.
+ *
+ * @param expandedKeys Expanded encryption key ((num_rounds + 1) * 16 bytes)
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param decryptionKeys Output decryption key schedule, same size as input
+ */
+void EquivalentInverseKeyExpansion(const uint8_t *expandedKeys,
+                                   size_t num_rounds, uint8_t *decryptionKeys);
+
+/**
+ * @brief Encrypts a single 16-byte block with an expanded key schedule
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input block (plaintext)
+ * @param out Output block (ciphertext), may alias the input block
+ */
+void AES_encrypt_block(const uint8_t *round_keys, size_t num_rounds,
+                       const uint8_t *in, uint8_t *out);
+
+/**
+ * @brief Decrypts a single 16-byte block with an equivalent inverse cipher key
+ * schedule
+ * @param inv_round_keys Key schedule from EquivalentInverseKeyExpansion()
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input block (ciphertext)
+ * @param out Output block (plaintext), may alias the input block
+ */
+void AES_decrypt_block(const uint8_t *inv_round_keys, size_t num_rounds,
+                       const uint8_t *in, uint8_t *out);
+
+/**
+ * @brief Returns the backend used for block operations
+ *
+ * On first use the fastest backend supported by the running CPU is selected.
+ *
+ * @return AES_backend_t Active backend
+ */
+AES_backend_t AES_get_backend(void);
+
+/**
+ * @brief Forces a block cipher backend, e.g. to cross-check the hardware
+ * backend against the portable reference
+ *
+ * Key schedules have the same layout for every backend, so contexts do not
+ * need to be re-initialized after switching.
+ *
+ * @param backend Backend to use
+ * @return true if the backend is available, false otherwise (no change)
+ */
+bool AES_set_backend(AES_backend_t backend);
+
+/**
+ * @brief Encrypts consecutive blocks in ECB mode with the active backend
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ECB_encrypt_blocks(const uint8_t *round_keys, size_t num_rounds,
+                            const uint8_t *in, uint8_t *out,
+                            size_t num_blocks);
+
+/**
+ * @brief Decrypts consecutive blocks in ECB mode with the active backend
+ * @param inv_round_keys Equivalent inverse cipher key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ECB_decrypt_blocks(const uint8_t *inv_round_keys, size_t num_rounds,
+                            const uint8_t *in, uint8_t *out,
+                            size_t num_blocks);
+
+/**
+ * @brief Encrypts consecutive blocks in CBC mode with the active backend
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param iv Chaining value, updated with the last ciphertext block
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_CBC_encrypt_blocks(const uint8_t *round_keys, size_t num_rounds,
+                            uint8_t *iv, const uint8_t *in, uint8_t *out,
+                            size_t num_blocks);
+
+/**
+ * @brief Decrypts consecutive blocks in CBC mode with the active backend
+ *
+ * Every plaintext block only depends on two ciphertext blocks, so blocks are
+ * decrypted in independent batches (AES_CBC_BATCH_BLOCKS, or 8 at once in
+ * the AES-NI pipeline). Inputs of at least AES_CBC_PARALLEL_THRESHOLD bytes
+ * are also split into contiguous segments that run on the AES thread pool.
+ *
+ * @param inv_round_keys Equivalent inverse cipher key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param iv Chaining value, updated with the last ciphertext block
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_CBC_decrypt_blocks(const uint8_t *inv_round_keys, size_t num_rounds,
+                            uint8_t *iv, const uint8_t *in, uint8_t *out,
+                            size_t num_blocks);
+
+/**
+ * @brief Starts a streaming operation
+ * @param stream Streaming state
+ * @param mode Block cipher mode
+ * @param encrypt true for encryption, false for decryption
+ * @param use_padding true for PKCS7 padding, false for zero padding
+ * @param iv Initialization vector (CBC only, can be NULL for ECB)
+ */
+void AES_stream_init(AES_stream_t *stream, AES_mode_t mode, bool encrypt,
+                     bool use_padding, const uint8_t *iv);
+
+/**
+ * @brief Processes the next piece of a stream
+ *
+ * Only whole blocks are written. Up to 15 bytes are kept in the stream (16
+ * when decrypting with padding, as the last block may hold the padding), so
+ * out must have room for input_len + 15 bytes. in == out is supported; other
+ * partial overlaps are not.
+ *
+ * @param stream Streaming state
+ * @param round_keys Encryption key schedule, or equivalent inverse schedule
+ * when decrypting
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input data
+ * @param out Output data
+ * @param input_len Length of input data in bytes
+ * @return size_t Number of bytes written to out
+ */
+size_t AES_stream_update(AES_stream_t *stream, const uint8_t *round_keys,
+                         size_t num_rounds, const uint8_t *in, uint8_t *out,
+                         size_t input_len);
+
+/**
+ * @brief Finishes a stream, flushing the buffered block
+ *
+ * Encryption writes the final padded block (at most 16 bytes). Decryption
+ * with padding validates and strips the PKCS7 padding.
+ *
+ * @param stream Streaming state
+ * @param round_keys Encryption key schedule, or equivalent inverse schedule
+ * when decrypting
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param out Output data (at most 16 bytes are written)
+ * @param output_len Pointer to store the number of bytes written
+ * @return AES_errcode_t AES_CODE_OK on success, AES_CODE_INCORRECT_BUFFER_SIZE
+ * if the ciphertext length is not a multiple of the block size or
+ * AES_CODE_INVALID_PADDING if the padding is malformed
+ */
+AES_errcode_t AES_stream_final(AES_stream_t *stream, const uint8_t *round_keys,
+                               size_t num_rounds, uint8_t *out,
+                               size_t *output_len);
+
+/**
+ * @brief Adds n to the incrementing part of a counter block
+ * @param counter Big-endian counter block
+ * @param counter_bits Width of the counter in bits (1 to 128)
+ * @param n Value to add, modulo 2^counter_bits
+ */
+void AES_ctr_add(uint8_t *counter, size_t counter_bits, uint64_t n);
+
+/**
+ * @brief Starts CTR mode from an initial counter block
+ * @param ctr CTR state
+ * @param iv Initial counter block (nonce and counter)
+ * @param counter_bits Width of the counter in bits (1 to 128)
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT if the
+ * width is out of range (the state is left unchanged)
+ */
+AES_errcode_t AES_ctr_init(AES_ctr_t *ctr, const uint8_t *iv,
+                           size_t counter_bits);
+
+/**
+ * @brief Positions CTR mode at a block offset from the initial counter block
+ * @param ctr CTR state
+ * @param iv Initial counter block
+ * @param block_offset Number of 16-byte blocks to skip
+ */
+void AES_ctr_seek(AES_ctr_t *ctr, const uint8_t *iv, uint64_t block_offset);
+
+/**
+ * @brief Encrypts or decrypts whole blocks in CTR mode with the active
+ * backend, AES_CTR_BATCH_BLOCKS keystream blocks at a time
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param counter Counter block, advanced by num_blocks
+ * @param counter_bits Width of the counter in bits (1 to 128)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_CTR_xcrypt_blocks(const uint8_t *round_keys, size_t num_rounds,
+                           uint8_t *counter, size_t counter_bits,
+                           const uint8_t *in, uint8_t *out,
+                           size_t num_blocks);
+
+/**
+ * @brief Encrypts or decrypts data of any length in CTR mode
+ *
+ * Continues from where the previous call stopped. Inputs of at least
+ * AES_CTR_PARALLEL_THRESHOLD bytes are split into contiguous segments that
+ * run on the AES thread pool, each starting from its own counter value.
+ *
+ * @param ctr CTR state
+ * @param round_keys Expanded encryption key schedule (also for decryption)
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input data
+ * @param out Output data, may alias the input
+ * @param len Length of data in bytes
+ */
+void AES_ctr_xcrypt(AES_ctr_t *ctr, const uint8_t *round_keys,
+                    size_t num_rounds, const uint8_t *in, uint8_t *out,
+                    size_t len);
+
+/**
+ * @brief Selects the pool used to split large buffers across threads
+ *
+ * Must not be changed while AES operations are running in other threads.
+ *
+ * @param pool Pool to use, or NULL for the process-wide default pool. A pool
+ * with a single thread disables multi-threading.
+ */
+void AES_set_thread_pool(thread_pool_t *pool);
+
+/**
+ * @brief Returns the pool used to split large buffers across threads
+ * @return thread_pool_t* Selected pool, or the default pool
+ */
+thread_pool_t *AES_get_thread_pool(void);
+
 #endif /*AES_COMMON_H*/
@@ -0,0 +1,166 @@
+/**
+ * @file AES_gcm.h
+ * @brief Galois/Counter Mode (NIST SP 800-38D) shared by every key size
+ * @version 0.1
+ * @date 2025-03-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Data is encrypted with the CTR core and authenticated with GHASH in the
+ * same pass. GHASH uses a 4-bit multiplication table of the hash key
+ * (portable backend) or carry-less multiplication fused with the AES-NI
+ * round pipeline (AES-NI backend).
+ */
+
+#ifndef AES_GCM_H
+#define AES_GCM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AES_common.h"
+
+/**
+ * @brief Recommended IV length in bytes (96 bits), the only length that does
+ * not need an extra GHASH pass
+ */
+#define AES_GCM_IV_LEN 12
+
+/**
+ * @brief Full authentication tag length in bytes
+ */
+#define AES_GCM_TAG_LEN 16
+
+/**
+ * @brief Shortest accepted authentication tag in bytes
+ */
+#define AES_GCM_MIN_TAG_LEN 4
+
+/**
+ * @brief Longest message accepted for one IV (2^39 - 256 bits)
+ */
+#define AES_GCM_MAX_DATA_LEN ((((uint64_t)1) << 36) - 32)
+
+/**
+ * @brief Number of hash key powers kept for aggregated GHASH
+ */
+#define AES_GCM_HASH_POWERS 8
+
+/**
+ * @brief Key-dependent GHASH material, derived once per key
+ */
+typedef struct AES_gcm_key {
+    uint64_t htable_hi[16];  // Multiples of H by every 4-bit value, high half
+    uint64_t htable_lo[16];  // Multiples of H by every 4-bit value, low half
+    uint8_t hash_powers[AES_GCM_HASH_POWERS][AES_BLOCK_LEN];  // H^1 .. H^8
+} AES_gcm_key_t;
+
+/**
+ * @brief State of one GCM message
+ */
+typedef struct AES_gcm {
+    uint8_t j0[AES_BLOCK_LEN];       // Pre-counter block, masks the tag
+    uint8_t ghash[AES_BLOCK_LEN];    // GHASH accumulator
+    uint8_t partial[AES_BLOCK_LEN];  // Bytes of an incomplete GHASH block
+    size_t partial_len;              // Number of valid bytes in partial
+    AES_ctr_t ctr;                   // 32-bit counter, starts at J0 + 1
+    uint64_t aad_len;                // AAD bytes hashed so far
+    uint64_t data_len;               // Data bytes processed so far
+    bool encrypt;                    // Direction, true for encryption
+    bool aad_done;                   // Data has started, no more AAD
+} AES_gcm_t;
+
+/**
+ * @brief Derives the GHASH key material from an expanded key
+ * @param key Output GHASH key material
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ */
+void AES_gcm_set_key(AES_gcm_key_t *key, const uint8_t *round_keys,
+                     size_t num_rounds);
+
+/**
+ * @brief Multiplies GHASH blocks into an accumulator with the active backend:
+ * x = (...((x ^ d[0]) * H ^ d[1]) * H ...) * H
+ * @param key GHASH key material
+ * @param x Accumulator (16 bytes)
+ * @param data Input blocks
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ghash_blocks(const AES_gcm_key_t *key, uint8_t *x,
+                      const uint8_t *data, size_t num_blocks);
+
+/**
+ * @brief Starts a GCM message
+ * @param gcm Message state
+ * @param key GHASH key material
+ * @param iv Initialization vector, must never repeat for the same key
+ * @param iv_len IV length in bytes (12 recommended, any non-zero length)
+ * @param encrypt true for encryption, false for decryption
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT for an
+ * empty IV
+ */
+AES_errcode_t AES_gcm_init(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                           const uint8_t *iv, size_t iv_len, bool encrypt);
+
+/**
+ * @brief Adds additional authenticated data, can be called several times
+ * before the first AES_gcm_update()
+ * @param gcm Message state
+ * @param key GHASH key material
+ * @param aad Additional authenticated data
+ * @param aad_len Length of aad in bytes
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INVALID_ARGUMENT if data
+ * has already been processed
+ */
+AES_errcode_t AES_gcm_update_aad(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                                 const uint8_t *aad, size_t aad_len);
+
+/**
+ * @brief Encrypts or decrypts the next piece of a message and hashes the
+ * ciphertext in the same pass
+ * @param gcm Message state
+ * @param key GHASH key material
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input data
+ * @param out Output data (same length as the input), may alias the input
+ * @param len Length of data in bytes
+ * @return AES_errcode_t AES_CODE_OK, or AES_CODE_INCORRECT_BUFFER_SIZE if
+ * the message would exceed AES_GCM_MAX_DATA_LEN
+ */
+AES_errcode_t AES_gcm_update(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                             const uint8_t *round_keys, size_t num_rounds,
+                             const uint8_t *in, uint8_t *out, size_t len);
+
+/**
+ * @brief Finishes a message and computes the full authentication tag
+ * @param gcm Message state
+ * @param key GHASH key material
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param tag Output tag (16 bytes)
+ */
+void AES_gcm_final(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                   const uint8_t *round_keys, size_t num_rounds,
+                   uint8_t *tag);
+
+/**
+ * @brief Finishes a message and compares its tag with an expected one in
+ * constant time
+ * @param gcm Message state
+ * @param key GHASH key material
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param tag Expected tag (possibly truncated)
+ * @param tag_len Length of tag in bytes (4 to 16)
+ * @return AES_errcode_t AES_CODE_OK if the tags match,
+ * AES_CODE_AUTHENTICATION_FAILED if they do not, or
+ * AES_CODE_INVALID_ARGUMENT for an unsupported tag length
+ */
+AES_errcode_t AES_gcm_verify(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                             const uint8_t *round_keys, size_t num_rounds,
+                             const uint8_t *tag, size_t tag_len);
+
+#endif /*AES_GCM_H*/
@@ -0,0 +1,159 @@
+/**
+ * @file AES_mb.h
+ * @brief Multi-buffer CBC encryption of many independent messages
+ * @version 0.1
+ * @date 2025-03-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * CBC encryption is serial within one message, but messages are independent
+ * of each other. The job manager keeps up to AES_MB_LANES messages in
+ * flight and encrypts one block of each per step, so the AES-NI pipeline is
+ * as full as with ECB. Only the AES-NI backend gains from this: the
+ * portable engines encrypt the lanes one after another, at the speed of
+ * single-message CBC (the T-table rounds already keep the loads busy, so
+ * interleaving lanes does not help them). Messages may use different keys;
+ * messages of different key sizes are kept in separate lane sets.
+ */
+
+#ifndef AES_MB_H
+#define AES_MB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AES_common.h"
+
+/**
+ * @brief Number of messages encrypted side by side
+ */
+#define AES_MB_LANES 8
+
+/**
+ * @brief Number of lane sets, one per key size (10, 12 and 14 rounds)
+ */
+#define AES_MB_LANE_SETS 3
+
+/**
+ * @brief One CBC encryption request
+ *
+ * Fill it with AES128_CBC_mb_job() (or the 192/256 versions) and keep it,
+ * the key context and both buffers alive until the manager returns it.
+ */
+typedef struct AES_mb_job {
+    const uint8_t *round_keys;  // Expanded encryption key of the message
+    size_t num_rounds;          // Number of cipher rounds (10, 12 or 14)
+    uint8_t iv[AES_BLOCK_LEN];  // Chaining value, last ciphertext block after
+    const uint8_t *in;          // Plaintext
+    uint8_t *out;               // Ciphertext, room for the padded length
+    size_t len;                 // Plaintext length in bytes
+    bool use_padding;           // PKCS7 padding (zero padding otherwise)
+    size_t out_len;             // Ciphertext length, set on completion
+    AES_errcode_t status;       // Result, set on completion
+    void *user_data;            // Free for the caller
+} AES_mb_job_t;
+
+/**
+ * @brief Throughput figures of a batch or of a manager
+ */
+typedef struct AES_mb_stats {
+    size_t jobs;              // Completed jobs
+    uint64_t bytes;           // Plaintext bytes of the completed jobs
+    uint64_t blocks;          // Ciphertext blocks produced
+    uint64_t steps;           // Lane steps, one block of every busy lane each
+    double seconds;           // Time spent encrypting
+    double bytes_per_second;  // bytes / seconds
+    double lane_occupancy;    // Average fraction of lanes busy per step
+} AES_mb_stats_t;
+
+/**
+ * @brief State of one message in a lane
+ */
+typedef struct AES_mb_lane {
+    AES_mb_job_t *job;            // NULL if the lane is free
+    const uint8_t *in;            // Next plaintext block
+    uint8_t *out;                 // Next ciphertext block
+    size_t blocks;                // Whole blocks left before the tail block
+    bool tail_pending;            // The padded tail block is still due
+    uint8_t tail[AES_BLOCK_LEN];  // Last partial block, padded
+} AES_mb_lane_t;
+
+/**
+ * @brief Job manager: submit jobs as they arrive, collect them as they
+ * complete (not necessarily in submission order)
+ */
+typedef struct AES_mb_mgr {
+    AES_mb_lane_t lanes[AES_MB_LANE_SETS][AES_MB_LANES];
+    size_t lanes_used[AES_MB_LANE_SETS];
+    AES_mb_job_t *done[AES_MB_LANE_SETS * AES_MB_LANES + 1];  // Ring buffer
+    size_t done_head;
+    size_t done_count;
+    AES_mb_stats_t stats;
+} AES_mb_mgr_t;
+
+/**
+ * @brief Prepares an empty job manager
+ * @param mgr Job manager
+ */
+void AES_mb_mgr_init(AES_mb_mgr_t *mgr);
+
+/**
+ * @brief Hands a job to the manager
+ *
+ * The job is only queued while free lanes remain. Once all lanes of its key
+ * size are busy, blocks are encrypted until the shortest message finishes.
+ *
+ * @param mgr Job manager
+ * @param job Job to encrypt
+ * @return AES_mb_job_t* A completed job (maybe another one), or NULL if none
+ * has completed yet
+ */
+AES_mb_job_t *AES_mb_submit(AES_mb_mgr_t *mgr, AES_mb_job_t *job);
+
+/**
+ * @brief Completes queued jobs with the lanes that are in use
+ *
+ * Call repeatedly until it returns NULL to drain the manager.
+ *
+ * @param mgr Job manager
+ * @return AES_mb_job_t* A completed job, or NULL if the manager is empty
+ */
+AES_mb_job_t *AES_mb_flush(AES_mb_mgr_t *mgr);
+
+/**
+ * @brief Throughput of the manager since AES_mb_mgr_init()
+ * @param mgr Job manager
+ * @param stats Output figures
+ */
+void AES_mb_mgr_get_stats(const AES_mb_mgr_t *mgr, AES_mb_stats_t *stats);
+
+/**
+ * @brief Encrypts a batch of jobs
+ * @param jobs Jobs to encrypt, each one gets its own status
+ * @param num_jobs Number of jobs
+ * @param stats Output throughput of this batch, may be NULL
+ * @return AES_errcode_t AES_CODE_OK if every job succeeded, otherwise the
+ * status of the first job that failed
+ */
+AES_errcode_t AES_mb_process(AES_mb_job_t *jobs, size_t num_jobs,
+                             AES_mb_stats_t *stats);
+
+/**
+ * @brief Encrypts consecutive blocks of several messages in CBC mode with the
+ * active backend, one block of every lane per step (AES-NI), or lane by lane
+ * (portable backend)
+ * @param round_keys Expanded encryption key of every lane
+ * @param num_rounds Number of cipher rounds, common to all lanes
+ * @param iv Chaining value of every lane, updated
+ * @param in First plaintext block of every lane
+ * @param out First ciphertext block of every lane, may alias the input
+ * @param num_lanes Number of lanes (1 to AES_MB_LANES)
+ * @param num_blocks Number of 16-byte blocks in every lane
+ */
+void AES_mb_CBC_encrypt_lanes(const uint8_t *const *round_keys,
+                              size_t num_rounds, uint8_t *const *iv,
+                              const uint8_t *const *in, uint8_t *const *out,
+                              size_t num_lanes, size_t num_blocks);
+
+#endif /*AES_MB_H*/
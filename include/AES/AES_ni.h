@@ -0,0 +1,189 @@
+/**
+ * @file AES_ni.h
+ * @brief AES-NI hardware backend for x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * All functions use the same key schedule layout as the portable
+ * implementation in AES_common.c (round keys as consecutive 16-byte blocks,
+ * decryption keys in equivalent inverse cipher order), so contexts can be
+ * processed by either backend interchangeably.
+ */
+
+#ifndef AES_NI_H
+#define AES_NI_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AES_common.h"
+
+/**
+ * @brief Enables the AES-NI backend
+ *
+ * When enabled (set to 1) on GCC/Clang x86 builds, the AES-NI code paths are
+ * compiled in and selected at runtime when CPUID reports AES support. Has no
+ * effect on other targets.
+ */
+#ifndef AES_USE_AESNI
+#define AES_USE_AESNI 0
+#endif
+
+#if (AES_USE_AESNI == 1) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define AES_NI_SUPPORTED 1
+#else
+#define AES_NI_SUPPORTED 0
+#endif
+
+/**
+ * @brief Number of blocks processed in parallel by the pipelined routines
+ */
+#define AES_NI_PIPELINE_BLOCKS 8
+
+/**
+ * @brief Checks whether the running CPU supports the AES-NI instructions
+ * (and PCLMULQDQ, used by GCM)
+ * @return true if the backend is compiled in and the CPU supports it
+ */
+bool AES_ni_available(void);
+
+/**
+ * @brief Expands a key into encryption and equivalent inverse key schedules
+ * using AESKEYGENASSIST and AESIMC
+ * @param key Cipher key
+ * @param key_size Key size in bytes (16, 24 or 32)
+ * @param round_keys Output encryption key schedule
+ * @param inv_round_keys Output decryption key schedule
+ */
+void AES_ni_expand_key(const uint8_t *key, size_t key_size,
+                       uint8_t *round_keys, uint8_t *inv_round_keys);
+
+/**
+ * @brief ECB encryption of consecutive blocks, 8 blocks interleaved
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_ECB_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *in, uint8_t *out, size_t num_blocks);
+
+/**
+ * @brief ECB decryption of consecutive blocks, 8 blocks interleaved
+ * @param inv_round_keys Equivalent inverse cipher key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_ECB_decrypt(const uint8_t *inv_round_keys, size_t num_rounds,
+                        const uint8_t *in, uint8_t *out, size_t num_blocks);
+
+/**
+ * @brief CBC encryption of consecutive blocks (inherently serial)
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param iv Chaining value, updated with the last ciphertext block
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_CBC_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        uint8_t *iv, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks);
+
+/**
+ * @brief CBC decryption of consecutive blocks, 8 blocks interleaved
+ * @param inv_round_keys Equivalent inverse cipher key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param iv Chaining value, updated with the last ciphertext block
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_CBC_decrypt(const uint8_t *inv_round_keys, size_t num_rounds,
+                        uint8_t *iv, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks);
+
+/**
+ * @brief CTR mode encryption/decryption of consecutive blocks, 8 keystream
+ * blocks interleaved
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param counter Big-endian counter block, advanced by num_blocks
+ * @param counter_bits Width of the incrementing counter in bits (1 to 128)
+ * @param in Input blocks
+ * @param out Output blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_CTR_xcrypt(const uint8_t *round_keys, size_t num_rounds,
+                       uint8_t *counter, size_t counter_bits,
+                       const uint8_t *in, uint8_t *out, size_t num_blocks);
+
+/**
+ * @brief GHASH of consecutive blocks with carry-less multiplication, 8 blocks
+ * per reduction
+ * @param hash_powers H^1 .. H^8, 16 bytes each
+ * @param x GHASH accumulator (16 bytes)
+ * @param data Input blocks
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_GHASH(const uint8_t *hash_powers, uint8_t *x, const uint8_t *data,
+                  size_t num_blocks);
+
+/**
+ * @brief GCM encryption of consecutive blocks: 32-bit counter keystream and
+ * GHASH of the ciphertext in a single pass
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param hash_powers H^1 .. H^8, 16 bytes each
+ * @param counter Big-endian counter block, advanced by num_blocks
+ * @param x GHASH accumulator (16 bytes)
+ * @param in Plaintext blocks
+ * @param out Ciphertext blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_GCM_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *hash_powers, uint8_t *counter,
+                        uint8_t *x, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks);
+
+/**
+ * @brief GCM decryption of consecutive blocks: GHASH of the ciphertext and
+ * 32-bit counter keystream in a single pass
+ * @param round_keys Expanded encryption key schedule
+ * @param num_rounds Number of cipher rounds (10, 12 or 14)
+ * @param hash_powers H^1 .. H^8, 16 bytes each
+ * @param counter Big-endian counter block, advanced by num_blocks
+ * @param x GHASH accumulator (16 bytes)
+ * @param in Ciphertext blocks
+ * @param out Plaintext blocks, may alias the input
+ * @param num_blocks Number of 16-byte blocks
+ */
+void AES_ni_GCM_decrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *hash_powers, uint8_t *counter,
+                        uint8_t *x, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks);
+
+/**
+ * @brief CBC encryption of up to 8 independent messages, one block of each
+ * per pipeline pass
+ * @param round_keys Expanded encryption key of every lane
+ * @param num_rounds Number of cipher rounds, common to all lanes
+ * @param iv Chaining value of every lane, updated
+ * @param in First plaintext block of every lane
+ * @param out First ciphertext block of every lane, may alias the input
+ * @param num_lanes Number of lanes (1 to 8)
+ * @param num_blocks Number of 16-byte blocks in every lane
+ */
+void AES_ni_CBC_encrypt_lanes(const uint8_t *const *round_keys,
+                              size_t num_rounds, uint8_t *const *iv,
+                              const uint8_t *const *in, uint8_t *const *out,
+                              size_t num_lanes, size_t num_blocks);
+
+#endif /*AES_NI_H*/
@@ -6,16 +6,27 @@
  * @date 2024-01-19
  *
  * This implementation provides Base64 encoding and decoding functionality with
- * fixed buffer sizes and no dynamic memory allocation, making it suitable for
- * embedded systems and memory-constrained environments.
+ * no dynamic memory allocation, making it suitable for embedded systems and
+ * memory-constrained environments. The converter API works in a fixed
+ * working buffer; base64_encode_to() and base64_decode_to() write inputs of
+ * any size straight into a caller buffer sized with base64_encoded_size() and
+ * base64_decoded_size(). The streaming functions (base64_encode_update() and
+ * friends) take the data in chunks of any size and keep the incomplete group
+ * between calls in the converter. base64_encode_ex() and base64_decode_ex()
+ * take options for the URL alphabet, unpadded output, line wrapping and
+ * whitespace skipping (JWT, MIME and PEM). base64_encode_parallel() and
+ * base64_decode_parallel() split large buffers across a thread pool.
  */
 
 #ifndef BASE64_H
 #define BASE64_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include "thread_pool.h"
+
 /**
  * @brief Size of a binary data chunk before Base64 encoding
  *
@@ -33,15 +44,15 @@
 #define BASE64_ENCODED_CHUNK_SIZE 4
 
 /**
- * @brief Maximum allowed input size in bytes
+ * @brief Reference input size in bytes for sizing converter buffers
  *
- * Limits the maximum size of input data to prevent buffer overflow
- * in memory-constrained environments.
+ * A converter buffer of BASE64_MAX_ENCODED_BUFFER bytes encodes inputs of up
+ * to this size. Larger inputs need a larger buffer, or base64_encode_to().
  */
 #define BASE64_MAX_INPUT_SIZE 1024
 
 /**
- * @brief Maximum size needed for Base64 encoded output
+ * @brief Converter buffer size needed for BASE64_MAX_INPUT_SIZE bytes
  *
  * Calculated as: (input_size + 2) / 3 * 4 + 1
  * The formula accounts for:
@@ -51,6 +62,14 @@
  */
 #define BASE64_MAX_ENCODED_BUFFER (((BASE64_MAX_INPUT_SIZE + 2) / 3) * 4 + 1)
 
+/**
+ * @brief Minimum input length in bytes before base64_encode_parallel() and
+ * base64_decode_parallel() split the work across the Base64 thread pool
+ */
+#ifndef BASE64_PARALLEL_THRESHOLD
+#define BASE64_PARALLEL_THRESHOLD (1024 * 1024)
+#endif
+
 /**
  * @brief Marker for invalid Base64 characters
  *
@@ -79,36 +98,282 @@ typedef enum {
     BASE64_INVALID_LENGTH     /**< Input length is not valid for decoding */
 } base64_status_t;
 
+/**
+ * @brief Kernels converting whole blocks, selected at runtime
+ *
+ * The scalar code always handles the tail of the data (and decodes any
+ * block a vector kernel refused), so every backend gives the same results.
+ */
+typedef enum {
+    BASE64_BACKEND_SCALAR, /**< One 3-byte/4-character group at a time */
+    BASE64_BACKEND_SSSE3,  /**< 24 bytes / 32 characters per iteration */
+    BASE64_BACKEND_AVX2    /**< 48 bytes / 64 characters per iteration */
+} base64_backend_t;
+
+/**
+ * @brief Characters of values 62 and 63
+ */
+typedef enum {
+    BASE64_ALPHABET_STANDARD, /**< RFC 4648 section 4: '+' and '/' */
+    BASE64_ALPHABET_URL       /**< RFC 4648 section 5: '-' and '_' */
+} base64_alphabet_t;
+
+/**
+ * @brief Characters per line of PEM (RFC 7468)
+ */
+#define BASE64_PEM_LINE_LENGTH 64
+
+/**
+ * @brief Characters per line of MIME (RFC 2045)
+ */
+#define BASE64_MIME_LINE_LENGTH 76
+
+/**
+ * @brief Variant of the encoding for base64_encode_ex() and
+ * base64_decode_ex()
+ */
+typedef struct {
+    base64_alphabet_t alphabet; /**< Characters of values 62 and 63 */
+    bool padding;         /**< Encoding: pad the last group with '='.
+                               Decoding: require it (it is always accepted) */
+    size_t line_length;   /**< Encoding: characters per line, a multiple of 4;
+                               lines are separated by CRLF. 0 for one line */
+    bool skip_whitespace; /**< Decoding: ignore spaces, tabs, CR and LF */
+} base64_options_t;
+
+/** @brief Standard alphabet, padded, one line (the default) */
+extern const base64_options_t base64_options_standard;
+
+/** @brief URL alphabet, unpadded, one line (JWT) */
+extern const base64_options_t base64_options_url;
+
+/** @brief Standard alphabet, padded, 76-character lines, whitespace skipped */
+extern const base64_options_t base64_options_mime;
+
+/** @brief Standard alphabet, padded, 64-character lines, whitespace skipped */
+extern const base64_options_t base64_options_pem;
+
 /**
  * @brief Base64 converter context structure
  *
  * Maintains state information for encoding and decoding operations.
- * Must be initialized with base64_init() before use.
+ * Must be initialized with base64_init() before use. A converter streams
+ * one message at a time, either encoding or decoding.
  */
 typedef struct {
     uint8_t *buffer;        /**< Working buffer for encoding/decoding */
     size_t buffer_size;     /**< Size of the working buffer */
     size_t bytes_processed; /**< Number of bytes processed in last operation */
+    uint8_t carry[4];  /**< Incomplete group kept between streaming calls */
+    size_t carry_len;  /**< Bytes (encoding) or characters (decoding) kept */
+    bool padded;       /**< Streaming decoder has seen the padded last group */
 } base64_converter_t;
 
 /**
  * @brief Initialize a Base64 converter instance
  *
- * The provided buffer must be at least BASE64_MAX_ENCODED_BUFFER bytes.
+ * The buffer limits the size of the data converted by base64_encode() and
+ * base64_decode(); BASE64_MAX_ENCODED_BUFFER bytes handle
+ * BASE64_MAX_INPUT_SIZE bytes of input. The streaming functions write into
+ * caller buffers, so a converter used only for streaming may be initialized
+ * with no buffer (NULL and 0). Also resets the streaming state.
  *
  * @param converter Pointer to converter structure to initialize
- * @param buffer Working buffer for encoding/decoding operations
- * @param buffer_size Size of the working buffer
+ * @param buffer Working buffer for encoding/decoding operations (or NULL)
+ * @param buffer_size Size of the working buffer (0 if buffer is NULL)
  * @return base64_status_t Status code indicating success or failure
  */
 base64_status_t base64_init(base64_converter_t *converter, uint8_t *buffer,
                             size_t buffer_size);
 
+/**
+ * @brief Length of the Base64 encoding of an input, padding included and
+ * terminator excluded
+ * @param input_size Size of the binary input in bytes
+ * @return size_t Encoded length, or 0 if it does not fit in a size_t
+ */
+size_t base64_encoded_size(size_t input_size);
+
+/**
+ * @brief Length of the Base64 encoding of an input with the given options,
+ * line breaks included and terminator excluded
+ * @param input_size Size of the binary input in bytes
+ * @param options Encoding options (NULL for base64_options_standard)
+ * @return size_t Encoded length, or 0 if it does not fit in a size_t or the
+ * options are invalid
+ */
+size_t base64_encoded_size_ex(size_t input_size,
+                              const base64_options_t *options);
+
+/**
+ * @brief Largest length a Base64 input of the given size may decode to,
+ * for base64_decode_ex() (whitespace and padding counted as data)
+ * @param input_size Size of the Base64 input in bytes
+ * @return size_t Upper bound of the decoded length
+ */
+size_t base64_decoded_max_size(size_t input_size);
+
+/**
+ * @brief Exact length of the data a Base64 input decodes to
+ *
+ * Only the length and trailing padding are inspected, not the characters.
+ *
+ * @param input Base64 input
+ * @param input_size Size of the input in bytes
+ * @return size_t Decoded length, or 0 if input_size is not a multiple of 4
+ */
+size_t base64_decoded_size(const uint8_t *input, size_t input_size);
+
+/**
+ * @brief Encode binary data of any size into a caller buffer
+ *
+ * The output is not null-terminated.
+ *
+ * @param input Binary data to encode (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes
+ * @param output Buffer receiving the encoded characters
+ * @param output_capacity Size of the output buffer, at least
+ * base64_encoded_size(input_size)
+ * @param output_size Pointer to variable that will receive the encoded size
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_encode_to(const void *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size);
+
+/**
+ * @brief Decode Base64 data of any size into a caller buffer
+ *
+ * The output may be the input buffer itself (in-place decoding): the
+ * decoded bytes never overtake the characters still to be read.
+ *
+ * @param input Base64 encoded input data (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes (must be multiple of 4)
+ * @param output Buffer receiving the decoded data
+ * @param output_capacity Size of the output buffer, at least
+ * base64_decoded_size(input, input_size)
+ * @param output_size Pointer to variable that will receive the decoded size
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_decode_to(const uint8_t *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size);
+
+/**
+ * @brief Encode binary data of any size into a caller buffer, with options
+ *
+ * Line breaks are CRLF and are only written between lines. The output is
+ * not null-terminated.
+ *
+ * @param input Binary data to encode (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes
+ * @param output Buffer receiving the encoded characters
+ * @param output_capacity Size of the output buffer, at least
+ * base64_encoded_size_ex(input_size, options)
+ * @param output_size Pointer to variable that will receive the encoded size
+ * @param options Alphabet, padding and line length (NULL for
+ * base64_options_standard)
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_encode_ex(const void *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size,
+                                 const base64_options_t *options);
+
+/**
+ * @brief Decode Base64 data of any size into a caller buffer, with options
+ *
+ * The input may end with an unpadded group of 2 or 3 characters unless the
+ * options require padding. The output may be the input buffer itself.
+ *
+ * @param input Base64 encoded input data (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes
+ * @param output Buffer receiving the decoded data
+ * @param output_capacity Size of the output buffer, at least
+ * base64_decoded_max_size(input_size)
+ * @param output_size Pointer to variable that will receive the decoded size
+ * @param options Alphabet, padding and whitespace skipping (NULL for
+ * base64_options_standard)
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_decode_ex(const uint8_t *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size,
+                                 const base64_options_t *options);
+
+/**
+ * @brief Encode a large buffer on several threads
+ *
+ * Same result as base64_encode_ex(). Inputs of at least
+ * BASE64_PARALLEL_THRESHOLD bytes are split into one segment per thread of
+ * the Base64 thread pool, at multiples of 3 bytes (of a whole line when
+ * wrapping), and every segment is encoded straight to its place in the
+ * output, which follows from its offset in the input.
+ *
+ * @param input Binary data to encode (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes
+ * @param output Buffer receiving the encoded characters, not overlapping
+ * the input
+ * @param output_capacity Size of the output buffer, at least
+ * base64_encoded_size_ex(input_size, options)
+ * @param output_size Pointer to variable that will receive the encoded size
+ * @param options Alphabet, padding and line length (NULL for
+ * base64_options_standard)
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_encode_parallel(const void *input, size_t input_size,
+                                       uint8_t *output,
+                                       size_t output_capacity,
+                                       size_t *output_size,
+                                       const base64_options_t *options);
+
+/**
+ * @brief Decode a large buffer on several threads
+ *
+ * Same result as base64_decode_ex(). Inputs of at least
+ * BASE64_PARALLEL_THRESHOLD bytes are split into one segment per thread of
+ * the Base64 thread pool at multiples of 4 characters, each decoded to 3/4
+ * of its input offset; padding may only end the last one. With
+ * skip_whitespace set, output offsets cannot be known before decoding, so
+ * the input is decoded by the calling thread alone.
+ *
+ * @param input Base64 encoded input data (may be NULL if input_size is 0)
+ * @param input_size Size of input data in bytes
+ * @param output Buffer receiving the decoded data, not overlapping the input
+ * @param output_capacity Size of the output buffer, at least
+ * base64_decoded_max_size(input_size)
+ * @param output_size Pointer to variable that will receive the decoded size
+ * @param options Alphabet and padding (NULL for base64_options_standard)
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_decode_parallel(const uint8_t *input, size_t input_size,
+                                       uint8_t *output,
+                                       size_t output_capacity,
+                                       size_t *output_size,
+                                       const base64_options_t *options);
+
+/**
+ * @brief Selects the pool used by base64_encode_parallel() and
+ * base64_decode_parallel()
+ *
+ * Must not be changed while Base64 operations are running in other threads.
+ *
+ * @param pool Pool to use, or NULL for the process-wide default pool. A pool
+ * with a single thread disables multi-threading.
+ */
+void base64_set_thread_pool(thread_pool_t *pool);
+
+/**
+ * @brief Returns the pool used to split large buffers across threads
+ * @return thread_pool_t* Selected pool, or the default pool
+ */
+thread_pool_t *base64_get_thread_pool(void);
+
 /**
  * @brief Encode binary data to Base64 format
  *
- * The output buffer is automatically sized based on the input length.
- * Maximum input size is BASE64_MAX_INPUT_SIZE bytes.
+ * The result is written, null-terminated, into the working buffer of the
+ * converter, which must hold base64_encoded_size(input_size) + 1 bytes.
  *
  * @param converter Initialized converter instance
  * @param input Binary data to encode
@@ -124,8 +389,8 @@ base64_status_t base64_encode(base64_converter_t *converter, const void *input,
 /**
  * @brief Decode Base64 data to binary
  *
- * Input size must be a multiple of 4 bytes.
- * Maximum input size is BASE64_MAX_ENCODED_BUFFER bytes.
+ * Input size must be a multiple of 4 bytes. The size of the converter
+ * working buffer is taken as the capacity of the output buffer.
  *
  * @param converter Initialized converter instance
  * @param input Base64 encoded input data
@@ -138,6 +403,97 @@ base64_status_t base64_decode(base64_converter_t *converter,
                               const uint8_t *input, size_t input_size,
                               uint8_t *output, size_t *output_size);
 
+/**
+ * @brief Encode the next chunk of a stream
+ *
+ * Encodes the whole 3-byte groups made of the bytes kept from the previous
+ * call followed by the chunk, and keeps the remaining 0-2 bytes in the
+ * converter for the next call. Chunks may have any size.
+ *
+ * @param converter Initialized converter instance
+ * @param input Next chunk of binary data (may be NULL if input_size is 0)
+ * @param input_size Size of the chunk in bytes
+ * @param output Buffer receiving the encoded characters (not terminated)
+ * @param output_capacity Size of the output buffer;
+ * base64_encoded_size(input_size) is always enough
+ * @param output_size Pointer to variable that will receive the encoded size
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_encode_update(base64_converter_t *converter,
+                                     const void *input, size_t input_size,
+                                     uint8_t *output, size_t output_capacity,
+                                     size_t *output_size);
+
+/**
+ * @brief Finish an encoding stream
+ *
+ * Encodes the 0-2 bytes kept by base64_encode_update() with their padding
+ * (at most 4 characters) and resets the converter for a new stream.
+ *
+ * @param converter Converter used for the stream
+ * @param output Buffer receiving the last characters (not terminated)
+ * @param output_capacity Size of the output buffer, 4 is always enough
+ * @param output_size Pointer to variable that will receive the encoded size
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_encode_final(base64_converter_t *converter,
+                                    uint8_t *output, size_t output_capacity,
+                                    size_t *output_size);
+
+/**
+ * @brief Decode the next chunk of a stream
+ *
+ * Decodes the whole 4-character groups made of the characters kept from
+ * the previous call followed by the chunk, and keeps the remaining 0-3
+ * characters in the converter for the next call. Chunks may have any size;
+ * padding may only appear in the last group of the stream. After an error
+ * the stream cannot continue and the converter must be re-initialized.
+ *
+ * @param converter Initialized converter instance
+ * @param input Next chunk of Base64 text (may be NULL if input_size is 0)
+ * @param input_size Size of the chunk in bytes
+ * @param output Buffer receiving the decoded data
+ * @param output_capacity Size of the output buffer;
+ * (input_size + 3) / 4 * 3 is always enough
+ * @param output_size Pointer to variable that will receive the decoded size
+ * @return base64_status_t Status code indicating success or failure
+ */
+base64_status_t base64_decode_update(base64_converter_t *converter,
+                                     const uint8_t *input, size_t input_size,
+                                     uint8_t *output, size_t output_capacity,
+                                     size_t *output_size);
+
+/**
+ * @brief Finish a decoding stream
+ *
+ * Checks that the stream ended on a group boundary and resets the
+ * converter for a new stream.
+ *
+ * @param converter Converter used for the stream
+ * @return base64_status_t BASE64_INVALID_LENGTH if characters of an
+ * incomplete group are left, BASE64_SUCCESS otherwise
+ */
+base64_status_t base64_decode_final(base64_converter_t *converter);
+
+/**
+ * @brief Returns the backend used for encoding and decoding
+ *
+ * On first use the fastest backend supported by the running CPU is selected
+ * (see BASE64_USE_SIMD in base64_simd.h).
+ *
+ * @return base64_backend_t Active backend
+ */
+base64_backend_t base64_get_backend(void);
+
+/**
+ * @brief Forces a backend, e.g. to cross-check the vector kernels against
+ * the scalar code
+ *
+ * @param backend Backend to use
+ * @return true if the backend is available, false otherwise (no change)
+ */
+bool base64_set_backend(base64_backend_t backend);
+
 /**
  * @brief Get human-readable error message for a status code
  *
@@ -0,0 +1,148 @@
+/**
+ * @file base64_simd.h
+ * @brief SSSE3 and AVX2 Base64 kernels for x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-04-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Encoding loads 12 bytes per 128-bit lane, spreads them into 16 bytes with
+ * a shuffle and extracts the 6-bit indices with two multiplies; a saturating
+ * subtract and a compare reduce each index to one of 14 ranges, and a
+ * shuffle of that range gives the offset to its ASCII character. Decoding
+ * classifies every character into the ranges of the alphabet with compares,
+ * flags anything outside them, adds the offset of its range and packs four
+ * 6-bit values into three bytes with multiply-adds and a shuffle.
+ *
+ * The characters of values 62 and 63 are parameters of both steps, so the
+ * same kernels serve the standard and URL alphabets. When encoding into
+ * lines, each line is encoded with whole blocks, the last one overlapping
+ * the previous, and followed by CRLF. When decoding with whitespace
+ * skipping, a block holding whitespace is decoded up to the group the
+ * whitespace starts, and the run of whitespace is stepped over.
+ *
+ * The kernels only handle whole blocks; base64.c runs the scalar code over
+ * the rest and over any block the decoder refused.
+ */
+
+#ifndef BASE64_SIMD_H
+#define BASE64_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Enables the SSSE3/AVX2 Base64 kernels
+ *
+ * When enabled (set to 1) on GCC/Clang x86 builds, the kernels are compiled
+ * in and selected at runtime from CPUID. Has no effect on other targets.
+ */
+#ifndef BASE64_USE_SIMD
+#define BASE64_USE_SIMD 0
+#endif
+
+#if (BASE64_USE_SIMD == 1) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define BASE64_SIMD_SUPPORTED 1
+#else
+#define BASE64_SIMD_SUPPORTED 0
+#endif
+
+/**
+ * @brief Alphabet and layout handled by the kernels
+ */
+typedef struct {
+    uint8_t char62;       /**< Character of value 62 ('+' or '-') */
+    uint8_t char63;       /**< Character of value 63 ('/' or '_') */
+    size_t line_length;   /**< Encoding: characters per line, 0 for none */
+    bool skip_whitespace; /**< Decoding: step over spaces, tabs, CR and LF */
+} base64_simd_format_t;
+
+/**
+ * @brief Checks whether the running CPU supports SSSE3
+ * @return true if the kernels are compiled in and the CPU supports them
+ */
+bool base64_ssse3_available(void);
+
+/**
+ * @brief Checks whether the running CPU and OS support AVX2
+ * @return true if the kernels are compiled in and the CPU supports them
+ */
+bool base64_avx2_available(void);
+
+/**
+ * @brief Encodes whole blocks of 24 (then 12) bytes with SSSE3
+ *
+ * Reads up to 4 bytes past the last block it encodes, never past len. With
+ * a line length (a multiple of 4, at least 16) only whole lines are
+ * encoded, each followed by CRLF, and only while more input follows them.
+ *
+ * @param src Binary input
+ * @param len Input length in bytes
+ * @param dst Output, not terminated
+ * @param format Alphabet and line length
+ * @param[out] written Characters written, line breaks included
+ * @return size_t Input bytes consumed, a multiple of 3
+ */
+size_t base64_ssse3_encode(const uint8_t *src, size_t len, uint8_t *dst,
+                           const base64_simd_format_t *format,
+                           size_t *written);
+
+/**
+ * @brief Decodes whole blocks of 32 (then 16) characters with SSSE3
+ *
+ * Stops before the first group holding a character outside the alphabet
+ * (padding included), unless it starts a run of whitespace to skip. Writes
+ * up to 4 bytes past the last group it decodes, but never more than 3 bytes
+ * per 4 characters consumed plus 16, and 16 bytes are within the output of
+ * the 24 characters always left unread. The output may overlap the input as
+ * long as dst does not start after src.
+ *
+ * @param src Base64 input
+ * @param len Input length in characters
+ * @param dst Output, 3 bytes per group decoded
+ * @param format Alphabet and whitespace skipping
+ * @param[out] written Bytes decoded
+ * @return size_t Input characters consumed, whitespace included
+ */
+size_t base64_ssse3_decode(const uint8_t *src, size_t len, uint8_t *dst,
+                           const base64_simd_format_t *format,
+                           size_t *written);
+
+/**
+ * @brief Encodes whole blocks of 48 (then 24) bytes with AVX2
+ *
+ * Lines shorter than 32 characters are left to base64_ssse3_encode().
+ *
+ * @param src Binary input
+ * @param len Input length in bytes
+ * @param dst Output, not terminated
+ * @param format Alphabet and line length
+ * @param[out] written Characters written, line breaks included
+ * @return size_t Input bytes consumed, a multiple of 3
+ * @see base64_ssse3_encode
+ */
+size_t base64_avx2_encode(const uint8_t *src, size_t len, uint8_t *dst,
+                          const base64_simd_format_t *format,
+                          size_t *written);
+
+/**
+ * @brief Decodes whole blocks of 64 (then 32) characters with AVX2
+ *
+ * Writes up to 8 bytes past the last group it decodes, within the output of
+ * the 48 characters always left unread.
+ *
+ * @param src Base64 input
+ * @param len Input length in characters
+ * @param dst Output, 3 bytes per group decoded
+ * @param format Alphabet and whitespace skipping
+ * @param[out] written Bytes decoded
+ * @return size_t Input characters consumed, whitespace included
+ * @see base64_ssse3_decode
+ */
+size_t base64_avx2_decode(const uint8_t *src, size_t len, uint8_t *dst,
+                          const base64_simd_format_t *format,
+                          size_t *written);
+
+#endif /* BASE64_SIMD_H */
@@ -9,7 +9,8 @@
  * @copyright Copyright (c) 2024
  *
  * This library provides comprehensive CRC calculation functionality supporting
- * multiple standard CRC algorithms including CRC8, CRC16, and CRC32 variants.
+ * multiple standard CRC algorithms including CRC8, CRC16, CRC32 and CRC64
+ * variants.
  * It implements both table-driven and direct calculation methods for optimal
  * performance and memory usage trade-offs.
  */
@@ -35,6 +36,10 @@
  * calculations. Each table consumes 256 bytes of program memory but
  * significantly improves calculation speed. Disable to save memory at the cost
  * of performance.
+ *
+ * Reflected variants use an LSB-first copy of the table instead, built in
+ * RAM on first use of each polynomial (256 bytes), so no input byte or result
+ * is bit reversed.
  */
 #ifndef CRC8_USE_LOOKUP_TABLE
 #define CRC8_USE_LOOKUP_TABLE 0
@@ -47,6 +52,10 @@
  * calculations. Each table consumes 512 bytes of program memory but
  * significantly improves calculation speed. Disable to save memory at the cost
  * of performance.
+ *
+ * Reflected variants use an LSB-first copy of the table instead, built in
+ * RAM on first use of each polynomial (512 bytes), so no input byte or result
+ * is bit reversed.
  */
 #ifndef CRC16_USE_LOOKUP_TABLE
 #define CRC16_USE_LOOKUP_TABLE 0
@@ -64,6 +73,39 @@
 #define CRC32_USE_LOOKUP_TABLE 0
 #endif
 
+/**
+ * @brief Number of input bytes folded per step by the CRC32 table engine
+ *
+ * With CRC32_USE_LOOKUP_TABLE enabled, CRC32 calculations use slicing tables
+ * (slice-by-8 by default) built in RAM on first use of each polynomial, in
+ * the bit order of the variant, so reflected variants need no per-byte bit
+ * reversal. Each set takes CRC32_SLICE_BY KiB. Valid values: 1, 8 and 16.
+ */
+#ifndef CRC32_SLICE_BY
+#define CRC32_SLICE_BY 8
+#endif
+
+/**
+ * @brief Controls the use of lookup tables for CRC64 calculations
+ *
+ * When enabled (set to 1), CRC64 calculations use slicing tables built in RAM
+ * on first use of each polynomial, in the bit order of the variant. Each set
+ * takes 2 KiB per CRC64_SLICE_BY. Disable to save memory at the cost of
+ * performance.
+ */
+#ifndef CRC64_USE_LOOKUP_TABLE
+#define CRC64_USE_LOOKUP_TABLE 0
+#endif
+
+/**
+ * @brief Number of input bytes folded per step by the CRC64 table engine
+ *
+ * 1 selects a plain byte table, 8 (the default) slice-by-8.
+ */
+#ifndef CRC64_SLICE_BY
+#define CRC64_SLICE_BY 8
+#endif
+
 /**
  * @brief Debug level definitions for CRC library
  *
@@ -194,6 +236,7 @@
  * - CRC8 variants (CCITT, CDMA2000, DARC, etc.)
  * - CRC16 variants (XMODEM, CCITT, KERMIT, etc.)
  * - CRC32 variants (IEEE 802.3, MPEG-2, POSIX, etc.)
+ * - CRC64 variants (ECMA-182, GO-ISO, XZ, NVMe)
  *
  * Each variant uses specific parameters (polynomial, initial value, etc.)
  * optimized for particular use cases.
@@ -255,6 +298,12 @@ typedef enum crc_t {
     CRC32_JAMCRC, /**< CRC-32/JAMCRC - JAM STAPL */
     CRC32_XFER,   /**< CRC-32/XFER - XFER protocol */
 
+    // CRC64 Variants
+    CRC64_ECMA_182, /**< CRC-64/ECMA-182 - DLT-1 tape cartridges */
+    CRC64_GO_ISO,   /**< CRC-64/GO-ISO - ISO 3309 (HDLC), Go hash/crc64 */
+    CRC64_XZ,       /**< CRC-64/XZ - XZ Utils, Go hash/crc64 ECMA */
+    CRC64_NVME,     /**< CRC-64/NVME - NVMe end-to-end data protection */
+
     CRC_IMPL_COUNT /**< Total number of CRC implementations */
 } crc_t;
 
@@ -271,6 +320,30 @@ typedef enum {
     CRC_ERROR_CRC_MISMATCH,       /**< Calculated CRC does not match expected value */
 } crc_error_t;
 
+/**
+ * @brief State of an incremental CRC8, CRC16, CRC32 or CRC64 calculation
+ *
+ * CRC_Init resolves the variant parameters and tables once, then CRC_Update
+ * can be called over any number of chunks before CRC_Finalize. The fields
+ * are internal to the library.
+ */
+typedef struct {
+    crc_t crc_type;                /**< CRC variant */
+    uint8_t width;                 /**< CRC width in bits: 8, 16, 32 or 64 */
+    bool input_reflected;          /**< Input bytes are reflected */
+    bool register_reflected;       /**< Register kept bit reversed (reflected
+                                        input) */
+    bool output_reflected;         /**< Register reversed at finalize */
+    bool hw_crc32c;                /**< CRC32C on the SSE4.2 instruction */
+    uint64_t poly;                 /**< Generator polynomial */
+    uint64_t final_xor;            /**< Final XOR mask */
+    uint64_t crc;                  /**< Running register */
+    const void *p_table;           /**< Byte lookup table in the bit order of
+                                        the register (CRC64: slicing tables),
+                                        or NULL */
+    const uint32_t (*slices)[256]; /**< CRC32 slicing tables, or NULL */
+} crc_ctx_t;
+
 #if defined(CRC8_USE_LOOKUP_TABLE) && (CRC8_USE_LOOKUP_TABLE == 1)
 #define CRC8_0x07_LOOKUP_TABLE  // 0x07 --> x^8 + x^5 + x^4 + 1
 #define CRC8_0x2F_LOOKUP_TABLE  // 0x2F --> x^8 + x^5 + x^3 + x^2 + x + 1
@@ -1128,6 +1201,13 @@ uint16_t CRC16_getPoly(crc_t crc_type);
  */
 uint32_t CRC32_getPoly(crc_t crc_type);
 
+/**
+ * @brief Function to obtain the generator polynomial for 64-bit CRC.
+ * @param crc_type (crc_t) enumeration data of the CRC type in question
+ * @return Polynomial in hexadecimal format for 64-bit CRC calculation.
+ */
+uint64_t CRC64_getPoly(crc_t crc_type);
+
 /**
  * @brief Function to obtain initial values (seed) for 8-bit CRC
  * @param crc_type (crc_t) enumeration data of the CRC type in question
@@ -1150,7 +1230,15 @@ uint16_t CRC16_getSeed(crc_t crc_type);
 uint32_t CRC32_getSeed(crc_t crc_type);
 
 /**
- * @brief Function to verify input reflected value for 8, 16 and 32-bit CRC.
+ * @brief Function to obtain initial values (seed) for 64-bit CRC
+ * @param crc_type (crc_t) enumeration data of the CRC type in question
+ * @return Initial value (seed) in hexadecimal format for 64-bit CRC calculation
+ */
+uint64_t CRC64_getSeed(crc_t crc_type);
+
+/**
+ * @brief Function to verify input reflected value for 8, 16, 32 and 64-bit
+ * CRC.
  * @param crc_type (crc_t) enumeration data of the CRC type in question.
  * @return true if the CRC in question requires reflected (inverted) input data,
  * false otherwise.
@@ -1158,7 +1246,8 @@ uint32_t CRC32_getSeed(crc_t crc_type);
 bool CRC_getInputReflected(crc_t crc_type);
 
 /**
- * @brief Function to verify output reflected value for 8, 16 and 32-bit CRC.
+ * @brief Function to verify output reflected value for 8, 16, 32 and 64-bit
+ * CRC.
  * @param crc_type (crc_t) enumeration data of the CRC type in question.
  * @return true if the CRC in question requires reflected (inverted) output
  * data, false otherwise.
@@ -1189,6 +1278,14 @@ uint16_t CRC16_getFinalXOR(crc_t crc_type);
  */
 uint32_t CRC32_getFinalXOR(crc_t crc_type);
 
+/**
+ * @brief Function to obtain XOR mask value for 64-bit CRC output.
+ * @param crc_type (crc_t) enumeration data of the CRC type in question.
+ * @return Final XOR mask depending on the required CRC. If 0,
+ * means the CRC algorithm doesn't require XOR mask.
+ */
+uint64_t CRC64_getFinalXOR(crc_t crc_type);
+
 /**
  * @brief Calculate CRC8 with error handling
  * @param data Pointer to input data
@@ -1249,6 +1346,27 @@ crc_error_t CRC32_Calculate(const void *data, size_t data_len, crc_t crc_type, u
  */
 uint32_t CRC32(const void *data, size_t data_len, crc_t crc_type);
 
+/**
+ * @brief Calculates CRC64 checksum with error handling
+ * @param data Pointer to input data
+ * @param data_len Length of input data
+ * @param crc_type Type of CRC64 implementation to use
+ * @param[out] result Pointer to store CRC result
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC64_Calculate(const void *data, size_t data_len, crc_t crc_type,
+                            uint64_t *result);
+
+/**
+ * @brief Calculates CRC64 checksum for given data
+ *
+ * @param data Pointer to input data buffer
+ * @param data_len Length of input data in bytes
+ * @param crc_type CRC algorithm variant to use
+ * @return uint64_t Calculated CRC64 checksum
+ */
+uint64_t CRC64(const void *data, size_t data_len, crc_t crc_type);
+
 /**
  * @brief Validates data integrity using CRC8 where CRC is appended to data
  * @param data Pointer to the data including appended CRC
@@ -1279,6 +1397,112 @@ crc_error_t CRC16_ValidateAppended(const void *data, size_t data_len, crc_t crc_
  */
 crc_error_t CRC32_ValidateAppended(const void *data, size_t data_len, crc_t crc_type);
 
+/**
+ * @brief Validates data integrity using CRC64 where CRC is appended to data
+ * @param data Pointer to the data including appended CRC
+ * @param data_len Length of the data including the appended CRC bytes
+ * @param crc_type Type of CRC64 algorithm to use
+ * @return crc_error_t Error code indicating success or failure
+ * @note The CRC is expected to be the last eight bytes of the data buffer,
+ * most significant byte first.
+ */
+crc_error_t CRC64_ValidateAppended(const void *data, size_t data_len,
+                                   crc_t crc_type);
+
+/**
+ * @brief Starts an incremental CRC calculation
+ * @param[out] ctx Context to initialize
+ * @param crc_type Any CRC8, CRC16, CRC32 or CRC64 variant
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Init(crc_ctx_t *ctx, crc_t crc_type);
+
+/**
+ * @brief Continues an incremental CRC calculation over a chunk of data
+ * @param ctx Context initialized by CRC_Init
+ * @param data Pointer to the chunk, may be NULL if data_len is 0
+ * @param data_len Length of the chunk in bytes
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Update(crc_ctx_t *ctx, const void *data, size_t data_len);
+
+/**
+ * @brief Returns the CRC of all the data passed to CRC_Update so far
+ *
+ * The context is left untouched, so more data can follow.
+ *
+ * @param ctx Context initialized by CRC_Init
+ * @param[out] result CRC value in the low ctx->width bits
+ * @return crc_error_t Error code indicating success or failure
+ * @note Unlike CRCx_Calculate with no data, an empty stream yields the
+ * seed with the output reflection applied, as in the Rocksoft model.
+ * CRC64 contexts are rejected with CRC_ERROR_INVALID_TYPE, see
+ * CRC64_Finalize.
+ */
+crc_error_t CRC_Finalize(const crc_ctx_t *ctx, uint32_t *result);
+
+/**
+ * @brief Returns the CRC64 of all the data passed to CRC_Update so far
+ * @param ctx Context initialized by CRC_Init with a CRC64 variant
+ * @param[out] result CRC64 value
+ * @return crc_error_t Error code indicating success or failure
+ * @see CRC_Finalize
+ */
+crc_error_t CRC64_Finalize(const crc_ctx_t *ctx, uint64_t *result);
+
+/**
+ * @brief Merges the CRC8 values of two consecutive segments
+ *
+ * Gives the CRC of segment A followed by segment B from their separate
+ * CRCs, in O(log len_b) time, without the data. Seed, reflection and final
+ * XOR of the variant are taken into account.
+ *
+ * @param crc_a CRC8 of the first segment
+ * @param crc_b CRC8 of the second segment
+ * @param len_b Length of the second segment in bytes
+ * @param crc_type CRC8 variant of both values
+ * @return uint8_t CRC8 of the concatenation, or 0 for an invalid type
+ * @note crc_a is returned as is when len_b is 0.
+ */
+uint8_t CRC8_combine(uint8_t crc_a, uint8_t crc_b, uint64_t len_b,
+                     crc_t crc_type);
+
+/**
+ * @brief Merges the CRC16 values of two consecutive segments
+ * @param crc_a CRC16 of the first segment
+ * @param crc_b CRC16 of the second segment
+ * @param len_b Length of the second segment in bytes
+ * @param crc_type CRC16 variant of both values
+ * @return uint16_t CRC16 of the concatenation, or 0 for an invalid type
+ * @see CRC8_combine
+ */
+uint16_t CRC16_combine(uint16_t crc_a, uint16_t crc_b, uint64_t len_b,
+                       crc_t crc_type);
+
+/**
+ * @brief Merges the CRC32 values of two consecutive segments
+ * @param crc_a CRC32 of the first segment
+ * @param crc_b CRC32 of the second segment
+ * @param len_b Length of the second segment in bytes
+ * @param crc_type CRC32 variant of both values
+ * @return uint32_t CRC32 of the concatenation, or 0 for an invalid type
+ * @see CRC8_combine
+ */
+uint32_t CRC32_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b,
+                       crc_t crc_type);
+
+/**
+ * @brief Merges the CRC64 values of two consecutive segments
+ * @param crc_a CRC64 of the first segment
+ * @param crc_b CRC64 of the second segment
+ * @param len_b Length of the second segment in bytes
+ * @param crc_type CRC64 variant of both values
+ * @return uint64_t CRC64 of the concatenation, or 0 for an invalid type
+ * @see CRC8_combine
+ */
+uint64_t CRC64_combine(uint64_t crc_a, uint64_t crc_b, uint64_t len_b,
+                       crc_t crc_type);
+
 #if defined(CRC_USE_IMPLEMENTATION_NAMES) && (CRC_USE_IMPLEMENTATION_NAMES == 1)
 /**
  * @brief Gets the string name of a CRC implementation
@@ -0,0 +1,84 @@
+/**
+ * @file crc_clmul.h
+ * @brief Carry-less multiplication (PCLMULQDQ) folding backend for CRC16,
+ * CRC32 and CRC64 on x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Long inputs are folded 64 bytes at a time into four 128-bit accumulators
+ * by multiplying them with x^n mod P, then merged into a 16-byte remainder
+ * congruent to the whole input. The table (or bit-by-bit) engine of crc.c
+ * finishes the remainder and the tail, so results are identical to it for
+ * every variant, reflected or not.
+ */
+
+#ifndef CRC_CLMUL_H
+#define CRC_CLMUL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crc.h"
+
+/**
+ * @brief Enables the carry-less multiplication backend
+ *
+ * When enabled (set to 1) on GCC/Clang x86 builds, CRC16, CRC32 and CRC64
+ * calculations of at least CRC_CLMUL_MIN_LEN bytes are folded with
+ * PCLMULQDQ when CPUID reports support for it. Has no effect on other
+ * targets.
+ */
+#ifndef CRC_USE_CLMUL
+#define CRC_USE_CLMUL 0
+#endif
+
+#if (CRC_USE_CLMUL == 1) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define CRC_CLMUL_SUPPORTED 1
+#else
+#define CRC_CLMUL_SUPPORTED 0
+#endif
+
+/**
+ * @brief Size of the remainder left by the folding, in bytes
+ */
+#define CRC_CLMUL_BLOCK_LEN 16
+
+/**
+ * @brief Shortest input folded with carry-less multiplication, shorter
+ * inputs go straight to the table engine
+ */
+#ifndef CRC_CLMUL_MIN_LEN
+#define CRC_CLMUL_MIN_LEN 128
+#endif
+
+/**
+ * @brief Checks whether the running CPU supports PCLMULQDQ (and SSSE3)
+ * @return true if the backend is compiled in and the CPU supports it
+ */
+bool CRC_clmul_available(void);
+
+/**
+ * @brief Folds the whole 16-byte blocks of a CRC16, CRC32 or CRC64 input into
+ * a 16-byte remainder
+ *
+ * The CRC of the input equals the CRC of the remainder computed from a zero
+ * register, continued over the bytes not consumed.
+ *
+ * @param crc_type CRC16, CRC32 or CRC64 variant
+ * @param crc Register value before the input, bit reversed for reflected
+ * input variants
+ * @param data Input data
+ * @param data_len Input length in bytes
+ * @param remainder Output remainder, in input byte order
+ * @return size_t Number of bytes consumed (a multiple of 16), or 0 if the
+ * input is shorter than CRC_CLMUL_MIN_LEN or the backend is not available
+ */
+size_t CRC_clmul_fold(crc_t crc_type, uint64_t crc, const uint8_t *data,
+                      size_t data_len,
+                      uint8_t remainder[CRC_CLMUL_BLOCK_LEN]);
+
+#endif /*CRC_CLMUL_H*/
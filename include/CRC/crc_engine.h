@@ -0,0 +1,109 @@
+/**
+ * @file crc_engine.h
+ * @brief Generic Rocksoft-model CRC engine with lazily generated tables
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Any CRC of 1 to 64 bits described by {width, poly, init, refin, refout,
+ * xorout}, as listed in the reveng catalogue, runs at slice-by-8 speed. The
+ * tables are built on first use of each (width, poly, refin) and cached for
+ * the whole process; init, refout and xorout only matter at the ends.
+ *
+ * Normal (MSB-first) registers are kept left-aligned in 64 bits and
+ * reflected ones right-aligned, so every width shares the same byte and
+ * 8-byte steps.
+ */
+
+#ifndef CRC_ENGINE_H
+#define CRC_ENGINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crc.h"
+
+/**
+ * @brief Number of parameter sets whose tables are cached. Each set takes
+ * 16 KiB of heap; sets beyond the cache run bit by bit.
+ */
+#ifndef CRC_ENGINE_CACHE_SLOTS
+#define CRC_ENGINE_CACHE_SLOTS 32
+#endif
+
+/**
+ * @brief Parameters of a CRC in the Rocksoft model
+ */
+typedef struct {
+    uint8_t width;   /**< Width in bits, 1 to 64 */
+    uint64_t poly;   /**< Generator polynomial without the x^width term */
+    uint64_t init;   /**< Initial register value, unreflected */
+    bool refin;      /**< Input bytes are processed LSB first */
+    bool refout;     /**< Register is reflected before the final XOR */
+    uint64_t xorout; /**< Final XOR mask */
+} crc_params_t;
+
+/**
+ * @brief State of a calculation with the generic engine
+ *
+ * The fields are internal to the library.
+ */
+typedef struct {
+    crc_params_t params;          /**< Model of the CRC */
+    const uint64_t (*tables)[256]; /**< Slicing tables, or NULL (bit by bit) */
+    uint64_t poly_aligned;        /**< Polynomial in register alignment */
+    uint64_t reg;                 /**< Running register */
+} crc_engine_ctx_t;
+
+/**
+ * @brief Fills the model parameters of a crc_t variant
+ * @param crc_type Any CRC8, CRC16, CRC32 or CRC64 variant
+ * @param[out] params Parameters of the variant
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_getParams(crc_t crc_type, crc_params_t *params);
+
+/**
+ * @brief Starts a calculation, building the tables of the parameters on
+ * first use
+ * @param[out] ctx Context to initialize
+ * @param params Model of the CRC, copied into the context
+ * @return crc_error_t CRC_ERROR_INVALID_TYPE for a width outside 1..64, or
+ * CRC_ERROR_INVALID_POLYNOMIAL for a polynomial wider than the CRC
+ */
+crc_error_t CRC_Engine_Init(crc_engine_ctx_t *ctx, const crc_params_t *params);
+
+/**
+ * @brief Continues a calculation over a chunk of data
+ * @param ctx Context initialized by CRC_Engine_Init
+ * @param data Pointer to the chunk, may be NULL if data_len is 0
+ * @param data_len Length of the chunk in bytes
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Engine_Update(crc_engine_ctx_t *ctx, const void *data,
+                              size_t data_len);
+
+/**
+ * @brief Returns the CRC of all the data passed so far, leaving the context
+ * untouched
+ * @param ctx Context initialized by CRC_Engine_Init
+ * @param[out] result CRC value in the low width bits
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Engine_Finalize(const crc_engine_ctx_t *ctx,
+                                uint64_t *result);
+
+/**
+ * @brief Calculates the CRC of a buffer with the generic engine
+ * @param params Model of the CRC
+ * @param data Pointer to input data
+ * @param data_len Length of input data
+ * @param[out] result CRC value in the low width bits
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Engine_Calculate(const crc_params_t *params, const void *data,
+                                 size_t data_len, uint64_t *result);
+
+#endif /*CRC_ENGINE_H*/
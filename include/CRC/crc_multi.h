@@ -0,0 +1,125 @@
+/**
+ * @file crc_multi.h
+ * @brief Several CRC variants over the same data in a single pass
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * The input is walked once, in blocks small enough to stay in cache. Variants
+ * with a hardware engine (SSE4.2 CRC32C, carry-less multiply folding) run over
+ * each block with CRC_Update; the others share one loop that loads every
+ * 8-byte word once and steps all their registers on the slicing tables of the
+ * generic engine, so their lookups interleave instead of waiting on each
+ * other.
+ */
+
+#ifndef CRC_MULTI_H
+#define CRC_MULTI_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crc.h"
+#include "crc_engine.h"
+
+/**
+ * @brief Maximum number of variants computed together, enough for every
+ * crc_t variant
+ */
+#ifndef CRC_MULTI_MAX_STREAMS
+#define CRC_MULTI_MAX_STREAMS 64
+#endif
+
+/**
+ * @brief Bytes of input handed to every variant in turn
+ */
+#ifndef CRC_MULTI_BLOCK_LEN
+#define CRC_MULTI_BLOCK_LEN (16 * 1024)
+#endif
+
+/**
+ * @brief State of one variant of a multi-stream calculation
+ */
+typedef struct {
+    bool interleaved;           /**< Runs on the shared engine loop */
+    crc_ctx_t ctx;              /**< State when run through CRC_Update */
+    crc_engine_ctx_t engine;    /**< State when interleaved */
+} crc_multi_stream_t;
+
+/**
+ * @brief State of a multi-stream calculation
+ *
+ * The fields are internal to the library.
+ */
+typedef struct {
+    size_t count;                                       /**< Variants */
+    crc_multi_stream_t streams[CRC_MULTI_MAX_STREAMS];  /**< In caller order */
+} crc_multi_ctx_t;
+
+/**
+ * @brief Starts a calculation of several variants
+ * @param[out] ctx Context to initialize
+ * @param crc_types Variants to compute, any width, repeats allowed
+ * @param count Number of variants, 1 to CRC_MULTI_MAX_STREAMS
+ * @return crc_error_t CRC_ERROR_INVALID_TYPE for an invalid variant or count
+ */
+crc_error_t CRC_Multi_Init(crc_multi_ctx_t *ctx, const crc_t *crc_types,
+                           size_t count);
+
+/**
+ * @brief Continues every variant over a chunk of data, read once
+ * @param ctx Context initialized by CRC_Multi_Init
+ * @param data Pointer to the chunk, may be NULL if data_len is 0
+ * @param data_len Length of the chunk in bytes
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Multi_Update(crc_multi_ctx_t *ctx, const void *data,
+                             size_t data_len);
+
+/**
+ * @brief Returns the CRC of every variant over the data passed so far,
+ * leaving the context untouched
+ * @param ctx Context initialized by CRC_Multi_Init
+ * @param[out] results One CRC per variant, in the order given to
+ * CRC_Multi_Init
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Multi_Finalize(const crc_multi_ctx_t *ctx, uint64_t *results);
+
+/**
+ * @brief Calculates several CRC variants of a buffer in one pass
+ *
+ * Each result equals CRC8/CRC16/CRC32/CRC64 of the buffer with that variant,
+ * empty input included.
+ *
+ * @param data Pointer to input data
+ * @param data_len Length of input data
+ * @param crc_types Variants to compute
+ * @param count Number of variants, 1 to CRC_MULTI_MAX_STREAMS
+ * @param[out] results One CRC per variant, in the order of crc_types
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC_Calculate_multi(const void *data, size_t data_len,
+                                const crc_t *crc_types, size_t count,
+                                uint64_t *results);
+
+/**
+ * @brief Finds the variants that give a known CRC over a capture
+ *
+ * Every crc_t variant wide enough to hold crc runs in one pass, so a frame
+ * with its checksum can be matched to its algorithm (see
+ * get_crc_implementation_name).
+ *
+ * @param data Pointer to the captured data, without the CRC
+ * @param data_len Length of the data
+ * @param crc Expected CRC value
+ * @param[out] matches Matching variants, in crc_t order
+ * @param max_matches Capacity of matches
+ * @return size_t Number of matching variants, which may exceed max_matches
+ */
+size_t CRC_Multi_Identify(const void *data, size_t data_len, uint64_t crc,
+                          crc_t *matches, size_t max_matches);
+
+#endif /*CRC_MULTI_H*/
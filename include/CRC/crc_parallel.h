@@ -0,0 +1,78 @@
+/**
+ * @file crc_parallel.h
+ * @brief Multi-threaded CRC16 and CRC32 over large buffers
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Large buffers are cut into slices whose CRCs are computed on the threads
+ * of a worker pool, each with the fastest available engine, then merged in
+ * order with CRC16_combine/CRC32_combine. The result is the exact CRC a
+ * serial pass would give.
+ */
+
+#ifndef CRC_PARALLEL_H
+#define CRC_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "crc.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Default minimum input length in bytes before the work is split
+ * across threads
+ */
+#ifndef CRC_PARALLEL_THRESHOLD
+#define CRC_PARALLEL_THRESHOLD (4 * 1024 * 1024)
+#endif
+
+/**
+ * @brief Settings of a parallel CRC calculation
+ *
+ * A zeroed structure (or a NULL pointer) selects the defaults.
+ */
+typedef struct {
+    size_t threshold;     /**< Minimum length split across threads, 0 for
+                               CRC_PARALLEL_THRESHOLD */
+    size_t num_threads;   /**< Maximum threads used, 0 for every thread of
+                               the pool. Holds with slice_len too: each
+                               thread then takes every num_threads-th
+                               slice */
+    size_t slice_len;     /**< Bytes per slice, 0 for one slice per
+                               thread */
+    thread_pool_t *pool;  /**< Pool owned by the caller, NULL for the
+                               process-wide pool (thread_pool_get_default) */
+} crc_parallel_config_t;
+
+/**
+ * @brief Calculates a CRC16 checksum, splitting large buffers across threads
+ * @param data Pointer to input data
+ * @param data_len Length of input data
+ * @param crc_type Type of CRC16 implementation to use
+ * @param config Settings, or NULL for the defaults
+ * @param[out] result Pointer to store CRC result
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC16_Calculate_parallel(const void *data, size_t data_len,
+                                     crc_t crc_type,
+                                     const crc_parallel_config_t *config,
+                                     uint16_t *result);
+
+/**
+ * @brief Calculates a CRC32 checksum, splitting large buffers across threads
+ * @param data Pointer to input data
+ * @param data_len Length of input data
+ * @param crc_type Type of CRC32 implementation to use
+ * @param config Settings, or NULL for the defaults
+ * @param[out] result Pointer to store CRC result
+ * @return crc_error_t Error code indicating success or failure
+ */
+crc_error_t CRC32_Calculate_parallel(const void *data, size_t data_len,
+                                     crc_t crc_type,
+                                     const crc_parallel_config_t *config,
+                                     uint32_t *result);
+
+#endif /*CRC_PARALLEL_H*/
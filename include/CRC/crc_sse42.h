@@ -0,0 +1,68 @@
+/**
+ * @file crc_sse42.h
+ * @brief CRC32C (Castagnoli) with the SSE4.2 crc32 instruction on x86-64
+ * processors
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * The crc32 instruction has a latency of three cycles but can start one per
+ * cycle, so long inputs are split in three blocks whose CRCs are computed
+ * interleaved and then merged, shifting the earlier ones over the length of
+ * a block with precomputed tables.
+ */
+
+#ifndef CRC_SSE42_H
+#define CRC_SSE42_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Enables the SSE4.2 CRC32C backend
+ *
+ * When enabled (set to 1) on GCC/Clang x86-64 builds, CRC32_C calculations
+ * use the crc32 instruction when CPUID reports support for SSE4.2. Has no
+ * effect on other targets or CRC variants.
+ */
+#ifndef CRC_USE_SSE42
+#define CRC_USE_SSE42 0
+#endif
+
+#if (CRC_USE_SSE42 == 1) && defined(__GNUC__) && defined(__x86_64__)
+#define CRC_SSE42_SUPPORTED 1
+#else
+#define CRC_SSE42_SUPPORTED 0
+#endif
+
+/**
+ * @brief Block lengths, in bytes, of the three interleaved streams: long
+ * blocks first, then short ones for the rest
+ */
+#define CRC_SSE42_LONG_BLOCK 8192
+#define CRC_SSE42_SHORT_BLOCK 256
+
+/**
+ * @brief Checks whether the running CPU supports SSE4.2
+ * @return true if the backend is compiled in and the CPU supports it
+ */
+bool CRC_sse42_available(void);
+
+/**
+ * @brief Continues a CRC32C register over the input
+ *
+ * The register is kept bit reversed (LSB-first), as with the reflected
+ * table algorithm, with no initial or final XOR applied.
+ *
+ * @param crc Register value before the input
+ * @param data Input data
+ * @param data_len Input length in bytes
+ * @return uint32_t Register value after the input, or crc unchanged if the
+ * backend is not available
+ */
+uint32_t CRC32C_sse42_update(uint32_t crc, const uint8_t *data,
+                             size_t data_len);
+
+#endif /*CRC_SSE42_H*/
@@ -83,10 +83,28 @@ typedef struct SHA1_ctx
 #pragma endregion
 
 #pragma region Function prototypes
-    static void sha1_init(SHA1_ctx_t *ctx);
-    static void sha1_compile(SHA1_ctx_t *ctx);
-    static void sha1_hash(SHA1_ctx_t *ctx, const uint8_t *data, size_t len);
-    static void sha1_end(SHA1_ctx_t *ctx, uint8_t *hval);
+
+    /**
+     * @brief Starts a streamed SHA1 calculation
+     * @param ctx Context to initialize
+     */
+    void sha1_init(SHA1_ctx_t *ctx);
+
+    /**
+     * @brief Continues a streamed SHA1 calculation over a chunk of data
+     * @param ctx Context initialized by sha1_init
+     * @param data Chunk of the message
+     * @param len Length of the chunk in bytes, any size
+     */
+    void sha1_hash(SHA1_ctx_t *ctx, const uint8_t *data, size_t len);
+
+    /**
+     * @brief Ends a streamed SHA1 calculation
+     * @param ctx Context initialized by sha1_init
+     * @param hval Output digest of SHA1_DIGEST_SIZE_BYTES bytes
+     */
+    void sha1_end(SHA1_ctx_t *ctx, uint8_t *hval);
+
     void sha1(const void *in, const void *out, size_t len);
 
 #pragma endregion
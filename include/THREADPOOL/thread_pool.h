@@ -0,0 +1,114 @@
+/**
+ * @file thread_pool.h
+ * @brief Minimal fork-join worker pool used to split large buffers across
+ * CPU cores
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * A pool runs a batch of independent tasks (a parallel for loop) and returns
+ * when all of them have finished. The calling thread takes part in the work,
+ * so a pool of N threads starts N - 1 workers. Without pthreads every batch
+ * runs serially in the calling thread, with the same results.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Enables POSIX threads
+ *
+ * When disabled (set to 0), pools are created with a single thread and every
+ * batch runs in the caller, which suits targets without an operating system.
+ */
+#ifndef THREAD_POOL_USE_PTHREADS
+#define THREAD_POOL_USE_PTHREADS 0
+#endif
+
+/**
+ * @brief Upper bound for the number of threads of a pool
+ */
+#define THREAD_POOL_MAX_THREADS 64
+
+/**
+ * @brief Task executed by the pool
+ * @param arg User argument shared by every task of a batch
+ * @param index Task index in [0, num_tasks)
+ */
+typedef void (*thread_pool_task_t)(void *arg, size_t index);
+
+/**
+ * @brief Opaque pool handle
+ */
+typedef struct thread_pool thread_pool_t;
+
+/**
+ * @brief Returns the number of online processors
+ * @return size_t Number of processors (1 if unknown or without pthreads)
+ */
+size_t thread_pool_get_cpu_count(void);
+
+/**
+ * @brief Creates a pool
+ * @param num_threads Total number of threads, including the caller of
+ * thread_pool_run(). 0 selects one thread per online processor.
+ * @return thread_pool_t* New pool, or NULL on allocation failure
+ */
+thread_pool_t *thread_pool_create(size_t num_threads);
+
+/**
+ * @brief Stops the workers and releases the pool
+ *
+ * Must not be called while a batch is running. The default pool must not be
+ * destroyed.
+ *
+ * @param pool Pool to destroy (NULL is ignored)
+ */
+void thread_pool_destroy(thread_pool_t *pool);
+
+/**
+ * @brief Returns the number of threads of a pool
+ * @param pool Pool (NULL counts as a single thread)
+ * @return size_t Number of threads, including the caller
+ */
+size_t thread_pool_get_num_threads(const thread_pool_t *pool);
+
+/**
+ * @brief Runs task(arg, i) for every i in [0, num_tasks) and waits for all
+ * of them
+ *
+ * Tasks are handed out dynamically, so their order of execution is not
+ * defined. Batches submitted to the same pool from several threads run one
+ * after the other. A batch submitted from inside a task of the same pool
+ * runs serially in that task. With a NULL pool the batch runs serially.
+ *
+ * @param pool Pool to run on
+ * @param task Task function
+ * @param arg Argument passed to every task
+ * @param num_tasks Number of tasks
+ */
+void thread_pool_run(thread_pool_t *pool, thread_pool_task_t task, void *arg,
+                     size_t num_tasks);
+
+/**
+ * @brief Returns the process-wide pool, created on first use with one
+ * thread per online processor
+ *
+ * @return thread_pool_t* Shared pool (NULL if it could not be created)
+ */
+thread_pool_t *thread_pool_get_default(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*THREAD_POOL_H*/
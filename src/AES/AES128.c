@@ -11,304 +11,267 @@
 
 #include "AES128.h"
 
-static void KeyExpansion_AES128(uint8_t *inputKey, uint8_t *expandedKeys);
+#include "AES_ni.h"
 
-void AES128_init_ctx(AES128_ctx_t *ctx, const uint8_t *key, const uint8_t *iv) {
+static void KeyExpansion_AES128(const uint8_t *inputKey,
+                                uint8_t *expandedKeys);
+
+void AES128_rekey(AES128_ctx_t *ctx, const uint8_t *key) {
     memcpy(ctx->key.array, key, AES128_FIXED_KEY_SIZE);
+    if (AES_get_backend() == AES_BACKEND_AESNI) {
+        AES_ni_expand_key(ctx->key.array, AES128_FIXED_KEY_SIZE,
+                          ctx->round_keys, ctx->inv_round_keys);
+    } else {
+        KeyExpansion_AES128(ctx->key.array, ctx->round_keys);
+        EquivalentInverseKeyExpansion(ctx->round_keys, AES128_NUM_ROUNDS,
+                                      ctx->inv_round_keys);
+    }
+    ctx->gcm_key_ready = false;
+}
+
+void AES128_init_ctx(AES128_ctx_t *ctx, const uint8_t *key, const uint8_t *iv) {
+    AES128_rekey(ctx, key);
     ctx->decrypted_chunks = 0;
     ctx->encrypted_chunks = 0;
-
-    if (iv == NULL) return;
-    memcpy(ctx->iv, iv, AES_BLOCK_LEN);
+    if (iv != NULL) {
+        memcpy(ctx->iv, iv, AES_BLOCK_LEN);
+    }
+    AES_ctr_init(&ctx->ctr, ctx->iv, AES_CTR_DEFAULT_COUNTER_BITS);
 }
 
-static void AES128_encrypt_chunk(AES128_ctx_t *ctx, uint8_t *in, uint8_t *out) {
-    memcpy(out, in, AES_BLOCK_LEN);
+void AES128_encrypt_init(AES128_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding) {
+    AES_stream_init(&ctx->stream, mode, true, use_padding,
+                    (mode == AES_MODE_CBC) ? ctx->iv : NULL);
+    ctx->encrypted_chunks = 0;
+}
 
-    uint8_t expandedKey[AES128_KEY_EXP_SIZE];
-    KeyExpansion_AES128(ctx->key.array, expandedKey);
-    AddRoundKey(out, ctx->key.array);
+void AES128_decrypt_init(AES128_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding) {
+    AES_stream_init(&ctx->stream, mode, false, use_padding,
+                    (mode == AES_MODE_CBC) ? ctx->iv : NULL);
+    ctx->decrypted_chunks = 0;
+}
 
-    for (size_t i = 0; i < AES128_NUM_ROUNDS - 1; i++) {
-        SubBytes(out);
-        ShiftRows(out);
-        MixColumns(out);
-        AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * (i + 1)));
+/* Keeps the chunk counters in sync with the stream */
+static void AES128_update_counters(AES128_ctx_t *ctx) {
+    if (ctx->stream.encrypt) {
+        ctx->encrypted_chunks = (uint32_t)ctx->stream.blocks;
+    } else {
+        ctx->decrypted_chunks = (uint32_t)ctx->stream.blocks;
     }
-
-    SubBytes(out);
-    ShiftRows(out);
-    AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * AES128_NUM_ROUNDS));
 }
 
-static void AES128_decrypt_chunk(AES128_ctx_t *ctx, uint8_t *in, uint8_t *out) {
-    memcpy(out, in, AES_BLOCK_LEN);
-
-    uint8_t expandedKey[AES128_KEY_EXP_SIZE];
-
-    KeyExpansion_AES128(ctx->key.array, expandedKey);
-
-    AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * AES128_NUM_ROUNDS));
-
-    ReverseShiftRows(out);
-    ReverseSubBytes(out);
+AES_errcode_t AES128_update(AES128_ctx_t *ctx, const void *in, void *out,
+                            size_t input_len, size_t *output_len) {
+    const uint8_t *keys =
+        ctx->stream.encrypt ? ctx->round_keys : ctx->inv_round_keys;
+    *output_len = AES_stream_update(&ctx->stream, keys, AES128_NUM_ROUNDS,
+                                    (const uint8_t *)in, (uint8_t *)out,
+                                    input_len);
+    AES128_update_counters(ctx);
+    return AES_CODE_OK;
+}
 
-    for (size_t i = AES128_NUM_ROUNDS - 1; i >= 1; i--) {
-        AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * i));
-        ReverseMixColumns(out);
-        ReverseShiftRows(out);
-        ReverseSubBytes(out);
-    }
-    AddRoundKey(out, expandedKey);
+AES_errcode_t AES128_final(AES128_ctx_t *ctx, void *out, size_t *output_len) {
+    const uint8_t *keys =
+        ctx->stream.encrypt ? ctx->round_keys : ctx->inv_round_keys;
+    AES_errcode_t err = AES_stream_final(&ctx->stream, keys, AES128_NUM_ROUNDS,
+                                         (uint8_t *)out, output_len);
+    AES128_update_counters(ctx);
+    return err;
 }
 
-AES_errcode_t AES128_ECB_encrypt(AES128_ctx_t *ctx, const void *in, void *out,
-                                 size_t input_len, size_t *output_len,
-                                 bool use_padding) {
+/**
+ * @brief One-shot operation built on the streaming API
+ */
+static AES_errcode_t AES128_process(AES128_ctx_t *ctx, AES_mode_t mode,
+                                    bool encrypt, const void *in, void *out,
+                                    size_t input_len, size_t *output_len,
+                                    bool use_padding) {
     // Input buffer length verification
-    if (input_len <= 0) {
+    if (input_len == 0) {
         return AES_CODE_EMPTY_INPUT_BUFFER;
     }
 
     // Normalized length calculation
-    ctx->encrypted_chunks = 0;
     ctx->input_len_normalized =
         (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
-    if (input_len == ctx->input_len_normalized && use_padding) {
-        ctx->input_len_normalized += AES_BLOCK_LEN;
-    }
-
-    if (ctx->input_len_normalized > AES128_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
-    }
-
-    // Create a temporary buffer for processing
-    uint8_t temp_buffer[AES128_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, AES128_MAX_BUFFER_SIZE);
-
-    // Prepare input data with or without padding
-    if (use_padding) {
-        PKCS7_padding_t padder;
-        PKCS7_add_padding(&padder, in, input_len, AES_BLOCK_LEN);
-        memcpy(temp_buffer, padder.data_with_padding,
-               ctx->input_len_normalized);
+    if (encrypt) {
+        // A full padding block is added when the input is block aligned
+        if (input_len == ctx->input_len_normalized && use_padding) {
+            ctx->input_len_normalized += AES_BLOCK_LEN;
+        }
+        AES128_encrypt_init(ctx, mode, use_padding);
     } else {
-        memcpy(temp_buffer, in, input_len);
-        // Zero-pad the rest if not using PKCS7
-        if (input_len < ctx->input_len_normalized) {
-            memset(temp_buffer + input_len, 0,
-                   ctx->input_len_normalized - input_len);
+        // Ciphertext must be a whole number of blocks
+        if (input_len != ctx->input_len_normalized) {
+            return AES_CODE_INCORRECT_BUFFER_SIZE;
         }
+        AES128_decrypt_init(ctx, mode, use_padding);
     }
 
-    // Initialization vector and output buffer allocation
-    uint8_t *_out = (uint8_t *)out;
-    memset(_out, 0, ctx->input_len_normalized);
-
-    // Pointer to the current position in the temp buffer
-    uint8_t *_in = temp_buffer;
-    size_t remaining = ctx->input_len_normalized;
-
-    // Chunk encryption
-    while (remaining > 0) {
-        AES128_encrypt_chunk(ctx, _in, _out);
-        _in += AES_BLOCK_LEN;
-        _out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->encrypted_chunks++;
-    }
+    size_t update_len, final_len;
+    AES128_update(ctx, in, out, input_len, &update_len);
+    AES_errcode_t err =
+        AES128_final(ctx, (uint8_t *)out + update_len, &final_len);
+    *output_len = update_len + final_len;
+    return err;
+}
 
-    *output_len = ctx->encrypted_chunks * AES_BLOCK_LEN;
-    return AES_CODE_OK;
+AES_errcode_t AES128_ECB_encrypt(AES128_ctx_t *ctx, const void *in, void *out,
+                                 size_t input_len, size_t *output_len,
+                                 bool use_padding) {
+    return AES128_process(ctx, AES_MODE_ECB, true, in, out, input_len,
+                          output_len, use_padding);
 }
 
 AES_errcode_t AES128_ECB_decrypt(AES128_ctx_t *ctx, void *in, void *out,
                                  size_t input_len, size_t *output_len,
                                  bool use_padding) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
-    }
+    return AES128_process(ctx, AES_MODE_ECB, false, in, out, input_len,
+                          output_len, use_padding);
+}
 
-    // Normalized length calculation
-    ctx->decrypted_chunks = 0;
-    size_t input_len_normalized = ctx->input_len_normalized =
-        (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
+AES_errcode_t AES128_CBC_encrypt(AES128_ctx_t *ctx, const void *in, void *out,
+                                 size_t input_len, size_t *output_len,
+                                 bool use_padding) {
+    return AES128_process(ctx, AES_MODE_CBC, true, in, out, input_len,
+                          output_len, use_padding);
+}
+
+AES_errcode_t AES128_CBC_decrypt(AES128_ctx_t *ctx, void *in, void *out,
+                                 size_t input_len, size_t *output_len,
+                                 bool use_padding) {
+    return AES128_process(ctx, AES_MODE_CBC, false, in, out, input_len,
+                          output_len, use_padding);
+}
+
+AES_errcode_t AES128_CTR_init(AES128_ctx_t *ctx, size_t counter_bits) {
+    return AES_ctr_init(&ctx->ctr, ctx->iv, counter_bits);
+}
+
+void AES128_CTR_seek(AES128_ctx_t *ctx, uint64_t block_offset) {
+    AES_ctr_seek(&ctx->ctr, ctx->iv, block_offset);
+}
 
-    if (ctx->input_len_normalized > AES128_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
+AES_errcode_t AES128_CTR_xcrypt(AES128_ctx_t *ctx, const void *in, void *out,
+                                size_t len) {
+    if (len == 0) {
+        return AES_CODE_EMPTY_INPUT_BUFFER;
     }
+    AES_ctr_xcrypt(&ctx->ctr, ctx->round_keys, AES128_NUM_ROUNDS,
+                   (const uint8_t *)in, (uint8_t *)out, len);
+    return AES_CODE_OK;
+}
 
-    // Create a temporary buffer for processing
-    uint8_t temp_buffer[AES128_MAX_BUFFER_SIZE];
-    memcpy(temp_buffer, in, input_len);
-
-    // Initialization vector and output buffer allocation
-    uint8_t *_out = (uint8_t *)out;
-    memset(_out, 0, input_len_normalized);
-
-    // Pointer to the current position in the temp buffer
-    uint8_t *_in = temp_buffer;
-    size_t remaining = input_len_normalized;
-
-    // Chunk decryption
-    while (remaining > 0) {
-        AES128_decrypt_chunk(ctx, _in, _out);
-        _in += AES_BLOCK_LEN;
-        _out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->decrypted_chunks++;
+/* GHASH key material, derived on the first GCM message after a key change
+ * so that other modes do not pay for it */
+static const AES_gcm_key_t *AES128_gcm_key(AES128_ctx_t *ctx) {
+    if (!ctx->gcm_key_ready) {
+        AES_gcm_set_key(&ctx->gcm_key, ctx->round_keys, AES128_NUM_ROUNDS);
+        ctx->gcm_key_ready = true;
     }
+    return &ctx->gcm_key;
+}
 
-    *output_len = ctx->decrypted_chunks * AES_BLOCK_LEN;
+AES_errcode_t AES128_GCM_encrypt_init(AES128_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len) {
+    return AES_gcm_init(&ctx->gcm, AES128_gcm_key(ctx), iv, iv_len, true);
+}
 
-    if (use_padding) {
-        PKCS7_unpadding_t unpadder;
-        PKCS7_remove_padding(&unpadder, out, input_len_normalized);
+AES_errcode_t AES128_GCM_decrypt_init(AES128_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len) {
+    return AES_gcm_init(&ctx->gcm, AES128_gcm_key(ctx), iv, iv_len, false);
+}
 
-        // Create a temporary buffer for the unpadded data
-        uint8_t unpadded_buffer[AES128_MAX_BUFFER_SIZE];
-        memcpy(unpadded_buffer, unpadder.data_without_padding,
-               unpadder.data_len_without_padding);
+AES_errcode_t AES128_GCM_update_aad(AES128_ctx_t *ctx, const void *aad,
+                                    size_t aad_len) {
+    return AES_gcm_update_aad(&ctx->gcm, &ctx->gcm_key, (const uint8_t *)aad,
+                              aad_len);
+}
 
-        // Copy the unpadded data back to the output buffer
-        memset(out, 0, input_len_normalized);  // Clear the output buffer first
-        memcpy(out, unpadded_buffer, unpadder.data_len_without_padding);
+AES_errcode_t AES128_GCM_update(AES128_ctx_t *ctx, const void *in, void *out,
+                                size_t len) {
+    return AES_gcm_update(&ctx->gcm, &ctx->gcm_key, ctx->round_keys,
+                          AES128_NUM_ROUNDS, (const uint8_t *)in,
+                          (uint8_t *)out, len);
+}
 
-        *output_len = unpadder.data_len_without_padding;
+AES_errcode_t AES128_GCM_encrypt_final(AES128_ctx_t *ctx, uint8_t *tag,
+                                       size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
-
+    uint8_t full_tag[AES_GCM_TAG_LEN];
+    AES_gcm_final(&ctx->gcm, &ctx->gcm_key, ctx->round_keys, AES128_NUM_ROUNDS,
+                  full_tag);
+    memcpy(tag, full_tag, tag_len);
     return AES_CODE_OK;
 }
 
-AES_errcode_t AES128_CBC_encrypt(AES128_ctx_t *ctx, const void *in, void *out,
-                                 size_t input_len, size_t *output_len,
-                                 bool use_padding) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
-    }
+AES_errcode_t AES128_GCM_decrypt_final(AES128_ctx_t *ctx, const uint8_t *tag,
+                                       size_t tag_len) {
+    return AES_gcm_verify(&ctx->gcm, &ctx->gcm_key, ctx->round_keys,
+                          AES128_NUM_ROUNDS, tag, tag_len);
+}
 
-    // Normalized length calculation
-    ctx->encrypted_chunks = 0;
-    size_t input_len_normalized =
-        (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
-    ctx->input_len_normalized = input_len_normalized;
-    if (input_len == input_len_normalized && use_padding) {
-        ctx->input_len_normalized = input_len_normalized += AES_BLOCK_LEN;
+AES_errcode_t AES128_GCM_encrypt(AES128_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 uint8_t *tag, size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
-
-    if (input_len_normalized > AES128_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
+    AES_errcode_t err = AES128_GCM_encrypt_init(ctx, iv, iv_len);
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_update_aad(ctx, aad, aad_len);
     }
-
-    // Create a temporary buffer for processing
-    uint8_t temp_buffer[AES128_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, AES128_MAX_BUFFER_SIZE);
-
-    // Prepare input data with or without padding
-    if (use_padding) {
-        PKCS7_padding_t padder;
-        PKCS7_add_padding(&padder, in, input_len, AES_BLOCK_LEN);
-        memcpy(temp_buffer, padder.data_with_padding, input_len_normalized);
-    } else {
-        memcpy(temp_buffer, in, input_len);
-        // Zero-pad the rest if not using PKCS7
-        if (input_len < input_len_normalized) {
-            memset(temp_buffer + input_len, 0,
-                   input_len_normalized - input_len);
-        }
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_update(ctx, in, out, len);
     }
-
-    // Initialization vector and output buffer allocation
-    uint8_t *_out = (uint8_t *)out;
-    memset(_out, 0, input_len_normalized);
-    uint8_t *xor_vector = ctx->iv;
-
-    // Pointer to the current position in the temp buffer
-    uint8_t *_in = temp_buffer;
-    size_t remaining = input_len_normalized;
-
-    // Chunk encryption
-    while (remaining > 0) {
-        AddRoundKey(_in, xor_vector);
-        AES128_encrypt_chunk(ctx, _in, _out);
-        xor_vector = _out;
-
-        _in += AES_BLOCK_LEN;
-        _out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->encrypted_chunks++;
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_encrypt_final(ctx, tag, tag_len);
     }
-
-    *output_len = ctx->encrypted_chunks * AES_BLOCK_LEN;
-    return AES_CODE_OK;
+    return err;
 }
 
-AES_errcode_t AES128_CBC_decrypt(AES128_ctx_t *ctx, void *in, void *out,
-                                 size_t input_len, size_t *output_len,
-                                 bool use_padding) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
+AES_errcode_t AES128_GCM_decrypt(AES128_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 const uint8_t *tag, size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
-
-    // Normalized length calculation
-    ctx->decrypted_chunks = 0;
-    size_t input_len_normalized =
-        (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
-    ctx->input_len_normalized = input_len_normalized;
-
-    if (input_len_normalized > AES128_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
+    AES_errcode_t err = AES128_GCM_decrypt_init(ctx, iv, iv_len);
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_update_aad(ctx, aad, aad_len);
     }
-
-    // Create a temporary buffer for processing
-    uint8_t temp_buffer[AES128_MAX_BUFFER_SIZE];
-    memcpy(temp_buffer, in, input_len);
-
-    // Initialization vector and output buffer allocation
-    uint8_t *_out = (uint8_t *)out;
-    memset(_out, 0, input_len_normalized);
-    uint8_t *xor_vector = ctx->iv;
-    uint8_t placeholder[AES_BLOCK_LEN];
-
-    // Pointer to the current position in the temp buffer
-    uint8_t *_in = temp_buffer;
-    size_t remaining = input_len_normalized;
-
-    // Chunk decryption
-    while (remaining > 0) {
-        memcpy(placeholder, _in, AES_BLOCK_LEN);
-        AES128_decrypt_chunk(ctx, _in, _out);
-        AddRoundKey(_out, xor_vector);
-        memcpy(xor_vector, placeholder, AES_BLOCK_LEN);
-
-        _in += AES_BLOCK_LEN;
-        _out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->decrypted_chunks++;
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_update(ctx, in, out, len);
     }
-
-    *output_len = ctx->decrypted_chunks * AES_BLOCK_LEN;
-
-    if (use_padding) {
-        PKCS7_unpadding_t unpadder;
-        PKCS7_remove_padding(&unpadder, out, input_len_normalized);
-
-        // Create a temporary buffer for the unpadded data
-        uint8_t unpadded_buffer[AES128_MAX_BUFFER_SIZE];
-        memcpy(unpadded_buffer, unpadder.data_without_padding,
-               unpadder.data_len_without_padding);
-
-        // Copy the unpadded data back to the output buffer
-        memset(out, 0, input_len_normalized);  // Clear the output buffer first
-        memcpy(out, unpadded_buffer, unpadder.data_len_without_padding);
-
-        *output_len = unpadder.data_len_without_padding;
+    if (err == AES_CODE_OK) {
+        err = AES128_GCM_decrypt_final(ctx, tag, tag_len);
     }
+    // Unauthenticated plaintext is never released
+    if (err != AES_CODE_OK && len > 0) {
+        memset(out, 0, len);
+    }
+    return err;
+}
 
-    return AES_CODE_OK;
+void AES128_CBC_mb_job(AES128_ctx_t *ctx, AES_mb_job_t *job, const void *in,
+                       void *out, size_t input_len, bool use_padding) {
+    job->round_keys = ctx->round_keys;
+    job->num_rounds = AES128_NUM_ROUNDS;
+    memcpy(job->iv, ctx->iv, AES_BLOCK_LEN);
+    job->in = (const uint8_t *)in;
+    job->out = (uint8_t *)out;
+    job->len = input_len;
+    job->use_padding = use_padding;
+    job->out_len = 0;
+    job->status = AES_CODE_OK;
+    job->user_data = NULL;
 }
 
 /**
@@ -317,7 +280,8 @@ AES_errcode_t AES128_CBC_decrypt(AES128_ctx_t *ctx, void *in, void *out,
  * @param inputKey Input key (16 bytes)
  * @param expandedKeys Output expanded key (176 bytes)
  */
-static void KeyExpansion_AES128(uint8_t *inputKey, uint8_t *expandedKeys) {
+static void KeyExpansion_AES128(const uint8_t *inputKey,
+                                uint8_t *expandedKeys) {
     size_t i;
     for (i = 0; i != AES128_FIXED_KEY_SIZE; i++) {
         expandedKeys[i] = inputKey[i];
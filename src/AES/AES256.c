@@ -11,307 +11,274 @@
 
 #include "AES256.h"
 
-static void KeyExpansion_AES256(uint8_t *inputKey, uint8_t *expandedKeys);
+#include "AES_ni.h"
 
-void AES256_init_ctx(AES256_ctx_t *ctx, const uint8_t *key, const uint8_t *iv) {
+static void KeyExpansion_AES256(const uint8_t *inputKey,
+                                uint8_t *expandedKeys);
+
+void AES256_rekey(AES256_ctx_t *ctx, const uint8_t *key) {
     memcpy(ctx->key.array, key, AES256_FIXED_KEY_SIZE);
+    if (AES_get_backend() == AES_BACKEND_AESNI) {
+        AES_ni_expand_key(ctx->key.array, AES256_FIXED_KEY_SIZE,
+                          ctx->round_keys, ctx->inv_round_keys);
+    } else {
+        KeyExpansion_AES256(ctx->key.array, ctx->round_keys);
+        EquivalentInverseKeyExpansion(ctx->round_keys, AES256_NUM_ROUNDS,
+                                      ctx->inv_round_keys);
+    }
+    ctx->gcm_key_ready = false;
+}
+
+void AES256_init_ctx(AES256_ctx_t *ctx, const uint8_t *key, const uint8_t *iv) {
+    AES256_rekey(ctx, key);
     ctx->decrypted_chunks = 0;
     ctx->encrypted_chunks = 0;
-    if (iv == NULL) return;
-    memcpy(ctx->iv, iv, AES_BLOCK_LEN);
+    if (iv != NULL) {
+        memcpy(ctx->iv, iv, AES_BLOCK_LEN);
+    }
+    AES_ctr_init(&ctx->ctr, ctx->iv, AES_CTR_DEFAULT_COUNTER_BITS);
 }
 
 void AES256_init_ctx_ecb(AES256_ctx_t *ctx, const uint8_t *key) {
     AES256_init_ctx(ctx, key, NULL);
 }
 
-static void AES256_encrypt_chunk(AES256_ctx_t *ctx, uint8_t *in, uint8_t *out) {
-    memcpy(out, in, AES_BLOCK_LEN);
+void AES256_encrypt_init(AES256_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding) {
+    AES_stream_init(&ctx->stream, mode, true, use_padding,
+                    (mode == AES_MODE_CBC) ? ctx->iv : NULL);
+    ctx->encrypted_chunks = 0;
+}
 
-    uint8_t expandedKey[AES256_KEY_EXP_SIZE];
-    KeyExpansion_AES256(ctx->key.array, expandedKey);
-    AddRoundKey(out, ctx->key.array);
+void AES256_decrypt_init(AES256_ctx_t *ctx, AES_mode_t mode,
+                         bool use_padding) {
+    AES_stream_init(&ctx->stream, mode, false, use_padding,
+                    (mode == AES_MODE_CBC) ? ctx->iv : NULL);
+    ctx->decrypted_chunks = 0;
+}
 
-    for (size_t i = 0; i < AES256_NUM_ROUNDS - 1; i++) {
-        SubBytes(out);
-        ShiftRows(out);
-        MixColumns(out);
-        AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * (i + 1)));
+/* Keeps the chunk counters in sync with the stream */
+static void AES256_update_counters(AES256_ctx_t *ctx) {
+    if (ctx->stream.encrypt) {
+        ctx->encrypted_chunks = (uint32_t)ctx->stream.blocks;
+    } else {
+        ctx->decrypted_chunks = (uint32_t)ctx->stream.blocks;
     }
-
-    SubBytes(out);
-    ShiftRows(out);
-    AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * AES256_NUM_ROUNDS));
 }
 
-static void AES256_decrypt_chunk(AES256_ctx_t *ctx, uint8_t *in, uint8_t *out) {
-    memcpy(out, in, AES_BLOCK_LEN);
-
-    uint8_t expandedKey[AES256_KEY_EXP_SIZE];
-
-    KeyExpansion_AES256(ctx->key.array, expandedKey);
-
-    AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * AES256_NUM_ROUNDS));
-
-    ReverseShiftRows(out);
-    ReverseSubBytes(out);
+AES_errcode_t AES256_update(AES256_ctx_t *ctx, const void *in, void *out,
+                            size_t input_len, size_t *output_len) {
+    const uint8_t *keys =
+        ctx->stream.encrypt ? ctx->round_keys : ctx->inv_round_keys;
+    *output_len = AES_stream_update(&ctx->stream, keys, AES256_NUM_ROUNDS,
+                                    (const uint8_t *)in, (uint8_t *)out,
+                                    input_len);
+    AES256_update_counters(ctx);
+    return AES_CODE_OK;
+}
 
-    for (size_t i = AES256_NUM_ROUNDS - 1; i >= 1; i--) {
-        AddRoundKey(out, expandedKey + (AES_BLOCK_LEN * i));
-        ReverseMixColumns(out);
-        ReverseShiftRows(out);
-        ReverseSubBytes(out);
-    }
-    AddRoundKey(out, expandedKey);
+AES_errcode_t AES256_final(AES256_ctx_t *ctx, void *out, size_t *output_len) {
+    const uint8_t *keys =
+        ctx->stream.encrypt ? ctx->round_keys : ctx->inv_round_keys;
+    AES_errcode_t err = AES_stream_final(&ctx->stream, keys, AES256_NUM_ROUNDS,
+                                         (uint8_t *)out, output_len);
+    AES256_update_counters(ctx);
+    return err;
 }
 
-AES_errcode_t AES256_ECB_encrypt(AES256_ctx_t *ctx, const void *in, void *out,
-                                 size_t input_len, size_t *output_len,
-                                 bool usePKCS7) {
+/**
+ * @brief One-shot operation built on the streaming API
+ */
+static AES_errcode_t AES256_process(AES256_ctx_t *ctx, AES_mode_t mode,
+                                    bool encrypt, const void *in, void *out,
+                                    size_t input_len, size_t *output_len,
+                                    bool use_padding) {
     // Input buffer length verification
-    if (input_len <= 0) {
+    if (input_len == 0) {
         return AES_CODE_EMPTY_INPUT_BUFFER;
     }
 
     // Normalized length calculation
-    ctx->encrypted_chunks = 0;
     ctx->input_len_normalized =
         (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
-
-    // If input is already a multiple of block size and padding is required, add
-    // another block
-    if (input_len == ctx->input_len_normalized && usePKCS7) {
-        ctx->input_len_normalized += AES_BLOCK_LEN;
-    }
-
-    if (ctx->input_len_normalized > AES256_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
-    }
-
-    // Create a temporary buffer for the padded input
-    uint8_t temp_buffer[AES256_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, ctx->input_len_normalized);
-
-    // Apply padding based on the usePKCS7 flag
-    if (usePKCS7) {
-        PKCS7_padding_t padder;
-        PKCS7_add_padding(&padder, in, input_len, AES_BLOCK_LEN);
-        memcpy(temp_buffer, padder.data_with_padding,
-               ctx->input_len_normalized);
+    if (encrypt) {
+        // A full padding block is added when the input is block aligned
+        if (input_len == ctx->input_len_normalized && use_padding) {
+            ctx->input_len_normalized += AES_BLOCK_LEN;
+        }
+        AES256_encrypt_init(ctx, mode, use_padding);
     } else {
-        // Zero padding - just copy the input and leave the rest as zeros
-        memcpy(temp_buffer, in, input_len);
+        // Ciphertext must be a whole number of blocks
+        if (input_len != ctx->input_len_normalized) {
+            return AES_CODE_INCORRECT_BUFFER_SIZE;
+        }
+        AES256_decrypt_init(ctx, mode, use_padding);
     }
 
-    // Encrypt each block
-    uint8_t *temp_in = temp_buffer;
-    uint8_t *temp_out = out;
-    size_t remaining = ctx->input_len_normalized;
-
-    while (remaining > 0) {
-        AES256_encrypt_chunk(ctx, temp_in, temp_out);
-
-        temp_in += AES_BLOCK_LEN;
-        temp_out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->encrypted_chunks++;
-    }
+    size_t update_len, final_len;
+    AES256_update(ctx, in, out, input_len, &update_len);
+    AES_errcode_t err =
+        AES256_final(ctx, (uint8_t *)out + update_len, &final_len);
+    *output_len = update_len + final_len;
+    return err;
+}
 
-    *output_len = ctx->encrypted_chunks * AES_BLOCK_LEN;
-    return AES_CODE_OK;
+AES_errcode_t AES256_ECB_encrypt(AES256_ctx_t *ctx, const void *in, void *out,
+                                 size_t input_len, size_t *output_len,
+                                 bool usePKCS7) {
+    return AES256_process(ctx, AES_MODE_ECB, true, in, out, input_len,
+                          output_len, usePKCS7);
 }
 
 AES_errcode_t AES256_ECB_decrypt(AES256_ctx_t *ctx, const void *in, void *out,
                                  size_t input_len, size_t *output_len,
                                  bool usePKCS7) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
-    }
-
-    // Normalized length calculation - input must be a multiple of block size
-    if (input_len % AES_BLOCK_LEN != 0) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
-    }
-
-    ctx->decrypted_chunks = 0;
-    ctx->input_len_normalized = input_len;
-
-    if (ctx->input_len_normalized > AES256_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
-    }
+    return AES256_process(ctx, AES_MODE_ECB, false, in, out, input_len,
+                          output_len, usePKCS7);
+}
 
-    // Create a temporary buffer for the decrypted output
-    uint8_t temp_buffer[AES256_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, ctx->input_len_normalized);
+AES_errcode_t AES256_CBC_encrypt(AES256_ctx_t *ctx, const uint8_t *in,
+                                 uint8_t *out, size_t input_len,
+                                 size_t *output_len, bool usePKCS7) {
+    return AES256_process(ctx, AES_MODE_CBC, true, in, out, input_len,
+                          output_len, usePKCS7);
+}
 
-    // Decrypt each block
-    const uint8_t *temp_in = in;
-    uint8_t *temp_out = temp_buffer;
-    size_t remaining = ctx->input_len_normalized;
+AES_errcode_t AES256_CBC_decrypt(AES256_ctx_t *ctx, const uint8_t *in,
+                                 uint8_t *out, size_t input_len,
+                                 size_t *output_len, bool usePKCS7) {
+    return AES256_process(ctx, AES_MODE_CBC, false, in, out, input_len,
+                          output_len, usePKCS7);
+}
 
-    while (remaining > 0) {
-        AES256_decrypt_chunk(ctx, (uint8_t *)temp_in, temp_out);
+AES_errcode_t AES256_CTR_init(AES256_ctx_t *ctx, size_t counter_bits) {
+    return AES_ctr_init(&ctx->ctr, ctx->iv, counter_bits);
+}
 
-        temp_in += AES_BLOCK_LEN;
-        temp_out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->decrypted_chunks++;
-    }
+void AES256_CTR_seek(AES256_ctx_t *ctx, uint64_t block_offset) {
+    AES_ctr_seek(&ctx->ctr, ctx->iv, block_offset);
+}
 
-    // Handle padding based on the usePKCS7 flag
-    if (usePKCS7) {
-        PKCS7_unpadding_t unpadder;
-        PKCS7_remove_padding(&unpadder, temp_buffer, ctx->input_len_normalized);
-        memcpy(out, unpadder.data_without_padding,
-               unpadder.data_len_without_padding);
-        *output_len = unpadder.data_len_without_padding;
-    } else {
-        // For zero padding, just copy all the data (including trailing zeros)
-        memcpy(out, temp_buffer, ctx->input_len_normalized);
-        *output_len = ctx->input_len_normalized;
+AES_errcode_t AES256_CTR_xcrypt(AES256_ctx_t *ctx, const void *in, void *out,
+                                size_t len) {
+    if (len == 0) {
+        return AES_CODE_EMPTY_INPUT_BUFFER;
     }
-
+    AES_ctr_xcrypt(&ctx->ctr, ctx->round_keys, AES256_NUM_ROUNDS,
+                   (const uint8_t *)in, (uint8_t *)out, len);
     return AES_CODE_OK;
 }
 
-AES_errcode_t AES256_CBC_encrypt(AES256_ctx_t *ctx, const uint8_t *in,
-                                 uint8_t *out, size_t input_len,
-                                 size_t *output_len, bool usePKCS7) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
+/* GHASH key material, derived on first GCM use after each rekey */
+static const AES_gcm_key_t *AES256_gcm_key(AES256_ctx_t *ctx) {
+    if (!ctx->gcm_key_ready) {
+        AES_gcm_set_key(&ctx->gcm_key, ctx->round_keys, AES256_NUM_ROUNDS);
+        ctx->gcm_key_ready = true;
     }
+    return &ctx->gcm_key;
+}
 
-    // Normalized length calculation
-    ctx->encrypted_chunks = 0;
-    ctx->input_len_normalized =
-        (size_t)(AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(input_len));
+AES_errcode_t AES256_GCM_encrypt_init(AES256_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len) {
+    return AES_gcm_init(&ctx->gcm, AES256_gcm_key(ctx), iv, iv_len, true);
+}
 
-    // If input is already a multiple of block size and padding is required, add
-    // another block
-    if (input_len == ctx->input_len_normalized && usePKCS7) {
-        ctx->input_len_normalized += AES_BLOCK_LEN;
-    }
+AES_errcode_t AES256_GCM_decrypt_init(AES256_ctx_t *ctx, const uint8_t *iv,
+                                      size_t iv_len) {
+    return AES_gcm_init(&ctx->gcm, AES256_gcm_key(ctx), iv, iv_len, false);
+}
 
-    if (ctx->input_len_normalized > AES256_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
-    }
+AES_errcode_t AES256_GCM_update_aad(AES256_ctx_t *ctx, const void *aad,
+                                    size_t aad_len) {
+    return AES_gcm_update_aad(&ctx->gcm, &ctx->gcm_key, (const uint8_t *)aad,
+                              aad_len);
+}
 
-    // Create a temporary buffer for the padded input
-    uint8_t temp_buffer[AES256_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, ctx->input_len_normalized);
+AES_errcode_t AES256_GCM_update(AES256_ctx_t *ctx, const void *in, void *out,
+                                size_t len) {
+    return AES_gcm_update(&ctx->gcm, &ctx->gcm_key, ctx->round_keys,
+                          AES256_NUM_ROUNDS, (const uint8_t *)in,
+                          (uint8_t *)out, len);
+}
 
-    // Apply padding based on the usePKCS7 flag
-    if (usePKCS7) {
-        PKCS7_padding_t padder;
-        PKCS7_add_padding(&padder, in, input_len, AES_BLOCK_LEN);
-        memcpy(temp_buffer, padder.data_with_padding,
-               ctx->input_len_normalized);
-    } else {
-        // Zero padding - just copy the input and leave the rest as zeros
-        memcpy(temp_buffer, in, input_len);
+AES_errcode_t AES256_GCM_encrypt_final(AES256_ctx_t *ctx, uint8_t *tag,
+                                       size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
+    uint8_t full_tag[AES_GCM_TAG_LEN];
+    AES_gcm_final(&ctx->gcm, &ctx->gcm_key, ctx->round_keys, AES256_NUM_ROUNDS,
+                  full_tag);
+    memcpy(tag, full_tag, tag_len);
+    return AES_CODE_OK;
+}
 
-    // Encrypt each block
-    uint8_t *temp_in = temp_buffer;
-    uint8_t *temp_out = out;
-    size_t remaining = ctx->input_len_normalized;
-    uint8_t *xor_vector = ctx->iv;
-    uint8_t block_buffer[AES_BLOCK_LEN];
-
-    while (remaining > 0) {
-        // XOR with previous ciphertext or IV
-        for (int i = 0; i < AES_BLOCK_LEN; i++) {
-            block_buffer[i] = temp_in[i] ^ xor_vector[i];
-        }
-
-        // Encrypt the XORed block
-        AES256_encrypt_chunk(ctx, block_buffer, temp_out);
-
-        // Update XOR vector for next block
-        xor_vector = temp_out;
+AES_errcode_t AES256_GCM_decrypt_final(AES256_ctx_t *ctx, const uint8_t *tag,
+                                       size_t tag_len) {
+    return AES_gcm_verify(&ctx->gcm, &ctx->gcm_key, ctx->round_keys,
+                          AES256_NUM_ROUNDS, tag, tag_len);
+}
 
-        temp_in += AES_BLOCK_LEN;
-        temp_out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->encrypted_chunks++;
+AES_errcode_t AES256_GCM_encrypt(AES256_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 uint8_t *tag, size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
-
-    *output_len = ctx->encrypted_chunks * AES_BLOCK_LEN;
-    return AES_CODE_OK;
+    AES_errcode_t err = AES256_GCM_encrypt_init(ctx, iv, iv_len);
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_update_aad(ctx, aad, aad_len);
+    }
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_update(ctx, in, out, len);
+    }
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_encrypt_final(ctx, tag, tag_len);
+    }
+    return err;
 }
 
-AES_errcode_t AES256_CBC_decrypt(AES256_ctx_t *ctx, const uint8_t *in,
-                                 uint8_t *out, size_t input_len,
-                                 size_t *output_len, bool usePKCS7) {
-    // Input buffer length verification
-    if (input_len <= 0) {
-        return AES_CODE_EMPTY_INPUT_BUFFER;
+AES_errcode_t AES256_GCM_decrypt(AES256_ctx_t *ctx, const uint8_t *iv,
+                                 size_t iv_len, const void *aad, size_t aad_len,
+                                 const void *in, void *out, size_t len,
+                                 const uint8_t *tag, size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
     }
-
-    // Normalized length calculation - input must be a multiple of block size
-    if (input_len % AES_BLOCK_LEN != 0) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
+    AES_errcode_t err = AES256_GCM_decrypt_init(ctx, iv, iv_len);
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_update_aad(ctx, aad, aad_len);
     }
-
-    ctx->decrypted_chunks = 0;
-    ctx->input_len_normalized = input_len;
-
-    if (ctx->input_len_normalized > AES256_MAX_BUFFER_SIZE) {
-        return AES_CODE_INCORRECT_BUFFER_SIZE;
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_update(ctx, in, out, len);
     }
-
-    // Create a temporary buffer for the decrypted output
-    uint8_t temp_buffer[AES256_MAX_BUFFER_SIZE];
-    memset(temp_buffer, 0, ctx->input_len_normalized);
-
-    // Decrypt each block
-    const uint8_t *temp_in = in;
-    uint8_t *temp_out = temp_buffer;
-    size_t remaining = ctx->input_len_normalized;
-    uint8_t *xor_vector = ctx->iv;
-    uint8_t current_block[AES_BLOCK_LEN];
-    uint8_t next_xor_vector[AES_BLOCK_LEN];
-
-    while (remaining > 0) {
-        // Save current ciphertext block for next iteration's XOR
-        memcpy(next_xor_vector, temp_in, AES_BLOCK_LEN);
-
-        // Decrypt the current block
-        AES256_decrypt_chunk(ctx, (uint8_t *)temp_in, current_block);
-
-        // XOR with previous ciphertext or IV
-        for (int i = 0; i < AES_BLOCK_LEN; i++) {
-            temp_out[i] = current_block[i] ^ xor_vector[i];
-        }
-
-        // Update XOR vector for next block
-        memcpy(xor_vector, next_xor_vector, AES_BLOCK_LEN);
-
-        temp_in += AES_BLOCK_LEN;
-        temp_out += AES_BLOCK_LEN;
-        remaining -= AES_BLOCK_LEN;
-        ctx->decrypted_chunks++;
+    if (err == AES_CODE_OK) {
+        err = AES256_GCM_decrypt_final(ctx, tag, tag_len);
     }
-
-    // Handle padding based on the usePKCS7 flag
-    if (usePKCS7) {
-        PKCS7_unpadding_t unpadder;
-        PKCS7_remove_padding(&unpadder, temp_buffer, ctx->input_len_normalized);
-        memcpy(out, unpadder.data_without_padding,
-               unpadder.data_len_without_padding);
-        *output_len = unpadder.data_len_without_padding;
-    } else {
-        // For zero padding, just copy all the data (including trailing zeros)
-        memcpy(out, temp_buffer, ctx->input_len_normalized);
-        *output_len = ctx->input_len_normalized;
+    // Unauthenticated plaintext is never released
+    if (err != AES_CODE_OK && len > 0) {
+        memset(out, 0, len);
     }
+    return err;
+}
 
-    return AES_CODE_OK;
+void AES256_CBC_mb_job(AES256_ctx_t *ctx, AES_mb_job_t *job, const void *in,
+                       void *out, size_t input_len, bool use_padding) {
+    job->round_keys = ctx->round_keys;
+    job->num_rounds = AES256_NUM_ROUNDS;
+    memcpy(job->iv, ctx->iv, AES_BLOCK_LEN);
+    job->in = (const uint8_t *)in;
+    job->out = (uint8_t *)out;
+    job->len = input_len;
+    job->use_padding = use_padding;
+    job->out_len = 0;
+    job->status = AES_CODE_OK;
+    job->user_data = NULL;
 }
 
-static void KeyExpansion_AES256(uint8_t *inputKey, uint8_t *expandedKeys) {
+static void KeyExpansion_AES256(const uint8_t *inputKey,
+                                uint8_t *expandedKeys) {
     size_t i;
     for (i = 0; i != AES256_FIXED_KEY_SIZE; i++) {
         expandedKeys[i] = inputKey[i];
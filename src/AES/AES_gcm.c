@@ -0,0 +1,339 @@
+/**
+ * @file AES_gcm.c
+ * @brief Galois/Counter Mode (NIST SP 800-38D) shared by every key size
+ * @version 0.1
+ * @date 2025-03-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "AES_gcm.h"
+
+#include <string.h>
+
+#include "AES_ni.h"
+
+/* Reduction terms for the 4 bits shifted out of the low end of the
+ * accumulator, modulo x^128 + x^7 + x^2 + x + 1 */
+static const uint64_t ghash_last4[16] = {
+    0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+    0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0};
+
+static uint64_t load_be64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void store_be64(uint8_t *p, uint64_t v) {
+    for (size_t i = 8; i-- > 0;) {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+/* x = x * H, one nibble of x at a time (Shoup's 4-bit table method) */
+static void ghash_mult(const AES_gcm_key_t *key, uint8_t *x) {
+    uint8_t lo = x[15] & 0x0F;
+    uint64_t zh = key->htable_hi[lo];
+    uint64_t zl = key->htable_lo[lo];
+    uint8_t rem;
+
+    for (size_t i = 16; i-- > 0;) {
+        lo = x[i] & 0x0F;
+        uint8_t hi = (uint8_t)(x[i] >> 4);
+
+        if (i != 15) {
+            rem = (uint8_t)(zl & 0x0F);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (ghash_last4[rem] << 48);
+            zh ^= key->htable_hi[lo];
+            zl ^= key->htable_lo[lo];
+        }
+
+        rem = (uint8_t)(zl & 0x0F);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (ghash_last4[rem] << 48);
+        zh ^= key->htable_hi[hi];
+        zl ^= key->htable_lo[hi];
+    }
+
+    store_be64(x, zh);
+    store_be64(x + 8, zl);
+}
+
+static void ghash_portable(const AES_gcm_key_t *key, uint8_t *x,
+                           const uint8_t *data, size_t num_blocks) {
+    for (size_t i = 0; i < num_blocks; i++) {
+        AddRoundKey(x, data + (AES_BLOCK_LEN * i));
+        ghash_mult(key, x);
+    }
+}
+
+void AES_gcm_set_key(AES_gcm_key_t *key, const uint8_t *round_keys,
+                     size_t num_rounds) {
+    uint8_t h[AES_BLOCK_LEN] = {0};
+    AES_ECB_encrypt_blocks(round_keys, num_rounds, h, h, 1);
+
+    // Entry 8 (nibble 1000b) is H itself, as GCM bit order is reflected
+    uint64_t vh = load_be64(h);
+    uint64_t vl = load_be64(h + 8);
+    key->htable_hi[0] = 0;
+    key->htable_lo[0] = 0;
+    key->htable_hi[8] = vh;
+    key->htable_lo[8] = vl;
+
+    // Entries 4, 2 and 1 are H * x, H * x^2 and H * x^3
+    for (size_t i = 4; i > 0; i >>= 1) {
+        uint64_t carry = (vl & 1) * 0xE1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (carry << 32);
+        key->htable_hi[i] = vh;
+        key->htable_lo[i] = vl;
+    }
+
+    // Every other entry is the XOR of the single-bit entries it contains
+    for (size_t i = 2; i <= 8; i <<= 1) {
+        for (size_t j = 1; j < i; j++) {
+            key->htable_hi[i + j] = key->htable_hi[i] ^ key->htable_hi[j];
+            key->htable_lo[i + j] = key->htable_lo[i] ^ key->htable_lo[j];
+        }
+    }
+
+    // Powers of H let the carry-less backend hash 8 blocks per reduction
+    memcpy(key->hash_powers[0], h, AES_BLOCK_LEN);
+    for (size_t i = 1; i < AES_GCM_HASH_POWERS; i++) {
+        memcpy(key->hash_powers[i], key->hash_powers[i - 1], AES_BLOCK_LEN);
+        ghash_mult(key, key->hash_powers[i]);
+    }
+}
+
+void AES_ghash_blocks(const AES_gcm_key_t *key, uint8_t *x,
+                      const uint8_t *data, size_t num_blocks) {
+#if AES_NI_SUPPORTED
+    if (AES_get_backend() == AES_BACKEND_AESNI) {
+        AES_ni_GHASH(key->hash_powers[0], x, data, num_blocks);
+        return;
+    }
+#endif
+    ghash_portable(key, x, data, num_blocks);
+}
+
+/* Hashes a zero padded partial block */
+static void ghash_padded(const AES_gcm_key_t *key, uint8_t *x,
+                         const uint8_t *data, size_t len) {
+    uint8_t block[AES_BLOCK_LEN] = {0};
+    memcpy(block, data, len);
+    AES_ghash_blocks(key, x, block, 1);
+}
+
+AES_errcode_t AES_gcm_init(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                           const uint8_t *iv, size_t iv_len, bool encrypt) {
+    if (iv_len == 0) {
+        return AES_CODE_INVALID_ARGUMENT;
+    }
+
+    memset(gcm->j0, 0, AES_BLOCK_LEN);
+    if (iv_len == AES_GCM_IV_LEN) {
+        // J0 = IV || 0^31 || 1
+        memcpy(gcm->j0, iv, AES_GCM_IV_LEN);
+        gcm->j0[AES_BLOCK_LEN - 1] = 1;
+    } else {
+        // J0 = GHASH(IV || zero padding || 0^64 || [bit length of IV]_64)
+        size_t full_blocks = iv_len / AES_BLOCK_LEN;
+        size_t tail = iv_len % AES_BLOCK_LEN;
+        uint8_t lengths[AES_BLOCK_LEN] = {0};
+        AES_ghash_blocks(key, gcm->j0, iv, full_blocks);
+        if (tail > 0) {
+            ghash_padded(key, gcm->j0, iv + (AES_BLOCK_LEN * full_blocks),
+                         tail);
+        }
+        store_be64(lengths + 8, (uint64_t)iv_len * 8);
+        AES_ghash_blocks(key, gcm->j0, lengths, 1);
+    }
+
+    // Data starts at inc32(J0); J0 itself is kept to mask the tag
+    AES_ctr_init(&gcm->ctr, gcm->j0, 32);
+    AES_ctr_seek(&gcm->ctr, gcm->j0, 1);
+
+    memset(gcm->ghash, 0, AES_BLOCK_LEN);
+    gcm->partial_len = 0;
+    gcm->aad_len = 0;
+    gcm->data_len = 0;
+    gcm->encrypt = encrypt;
+    gcm->aad_done = false;
+    return AES_CODE_OK;
+}
+
+AES_errcode_t AES_gcm_update_aad(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                                 const uint8_t *aad, size_t aad_len) {
+    if (gcm->aad_done) {
+        return AES_CODE_INVALID_ARGUMENT;
+    }
+    gcm->aad_len += aad_len;
+
+    // Complete the block left by the previous call
+    if (gcm->partial_len > 0) {
+        size_t take = AES_BLOCK_LEN - gcm->partial_len;
+        if (take > aad_len) {
+            take = aad_len;
+        }
+        memcpy(gcm->partial + gcm->partial_len, aad, take);
+        gcm->partial_len += take;
+        aad += take;
+        aad_len -= take;
+        if (gcm->partial_len < AES_BLOCK_LEN) {
+            return AES_CODE_OK;
+        }
+        AES_ghash_blocks(key, gcm->ghash, gcm->partial, 1);
+        gcm->partial_len = 0;
+    }
+
+    size_t full_blocks = aad_len / AES_BLOCK_LEN;
+    AES_ghash_blocks(key, gcm->ghash, aad, full_blocks);
+    gcm->partial_len = aad_len % AES_BLOCK_LEN;
+    memcpy(gcm->partial, aad + (AES_BLOCK_LEN * full_blocks),
+           gcm->partial_len);
+    return AES_CODE_OK;
+}
+
+/* Whole blocks: CTR encryption and GHASH of the ciphertext in one pass */
+static void gcm_blocks(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                       const uint8_t *round_keys, size_t num_rounds,
+                       const uint8_t *in, uint8_t *out, size_t num_blocks) {
+#if AES_NI_SUPPORTED
+    if (AES_get_backend() == AES_BACKEND_AESNI) {
+        if (gcm->encrypt) {
+            AES_ni_GCM_encrypt(round_keys, num_rounds, key->hash_powers[0],
+                               gcm->ctr.counter, gcm->ghash, in, out,
+                               num_blocks);
+        } else {
+            AES_ni_GCM_decrypt(round_keys, num_rounds, key->hash_powers[0],
+                               gcm->ctr.counter, gcm->ghash, in, out,
+                               num_blocks);
+        }
+        return;
+    }
+#endif
+    // Each batch is hashed while it is still in cache. Ciphertext is hashed
+    // before decryption, as out may overwrite it
+    while (num_blocks > 0) {
+        size_t batch = (num_blocks < AES_CTR_BATCH_BLOCKS)
+                           ? num_blocks
+                           : AES_CTR_BATCH_BLOCKS;
+        if (!gcm->encrypt) {
+            ghash_portable(key, gcm->ghash, in, batch);
+        }
+        AES_CTR_xcrypt_blocks(round_keys, num_rounds, gcm->ctr.counter,
+                              gcm->ctr.counter_bits, in, out, batch);
+        if (gcm->encrypt) {
+            ghash_portable(key, gcm->ghash, out, batch);
+        }
+        in += batch * AES_BLOCK_LEN;
+        out += batch * AES_BLOCK_LEN;
+        num_blocks -= batch;
+    }
+}
+
+/* Up to the end of the current block: CTR from the keystream left over,
+ * ciphertext collected for GHASH */
+static void gcm_bytes(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                      const uint8_t *round_keys, size_t num_rounds,
+                      const uint8_t *in, uint8_t *out, size_t len) {
+    uint8_t *cipher = gcm->partial + gcm->partial_len;
+    if (!gcm->encrypt) {
+        memcpy(cipher, in, len);
+    }
+    AES_ctr_xcrypt(&gcm->ctr, round_keys, num_rounds, in, out, len);
+    if (gcm->encrypt) {
+        memcpy(cipher, out, len);
+    }
+
+    gcm->partial_len += len;
+    if (gcm->partial_len == AES_BLOCK_LEN) {
+        AES_ghash_blocks(key, gcm->ghash, gcm->partial, 1);
+        gcm->partial_len = 0;
+    }
+}
+
+AES_errcode_t AES_gcm_update(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                             const uint8_t *round_keys, size_t num_rounds,
+                             const uint8_t *in, uint8_t *out, size_t len) {
+    if ((uint64_t)len > AES_GCM_MAX_DATA_LEN - gcm->data_len) {
+        return AES_CODE_INCORRECT_BUFFER_SIZE;
+    }
+
+    // The AAD ends here, padded to a whole block
+    if (!gcm->aad_done) {
+        if (gcm->partial_len > 0) {
+            ghash_padded(key, gcm->ghash, gcm->partial, gcm->partial_len);
+            gcm->partial_len = 0;
+        }
+        gcm->aad_done = true;
+    }
+    gcm->data_len += len;
+
+    // Keystream and GHASH block boundaries always coincide
+    if (gcm->partial_len > 0) {
+        size_t take = AES_BLOCK_LEN - gcm->partial_len;
+        if (take > len) {
+            take = len;
+        }
+        gcm_bytes(gcm, key, round_keys, num_rounds, in, out, take);
+        in += take;
+        out += take;
+        len -= take;
+    }
+
+    size_t num_blocks = len / AES_BLOCK_LEN;
+    if (num_blocks > 0) {
+        gcm_blocks(gcm, key, round_keys, num_rounds, in, out, num_blocks);
+        in += num_blocks * AES_BLOCK_LEN;
+        out += num_blocks * AES_BLOCK_LEN;
+        len -= num_blocks * AES_BLOCK_LEN;
+    }
+
+    if (len > 0) {
+        gcm_bytes(gcm, key, round_keys, num_rounds, in, out, len);
+    }
+    return AES_CODE_OK;
+}
+
+void AES_gcm_final(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                   const uint8_t *round_keys, size_t num_rounds,
+                   uint8_t *tag) {
+    // Last AAD or ciphertext block, zero padded
+    if (gcm->partial_len > 0) {
+        ghash_padded(key, gcm->ghash, gcm->partial, gcm->partial_len);
+        gcm->partial_len = 0;
+    }
+
+    uint8_t lengths[AES_BLOCK_LEN];
+    store_be64(lengths, gcm->aad_len * 8);
+    store_be64(lengths + 8, gcm->data_len * 8);
+    AES_ghash_blocks(key, gcm->ghash, lengths, 1);
+
+    // T = E(K, J0) ^ GHASH
+    AES_ECB_encrypt_blocks(round_keys, num_rounds, gcm->j0, tag, 1);
+    AddRoundKey(tag, gcm->ghash);
+}
+
+AES_errcode_t AES_gcm_verify(AES_gcm_t *gcm, const AES_gcm_key_t *key,
+                             const uint8_t *round_keys, size_t num_rounds,
+                             const uint8_t *tag, size_t tag_len) {
+    if (tag_len < AES_GCM_MIN_TAG_LEN || tag_len > AES_GCM_TAG_LEN) {
+        return AES_CODE_INVALID_ARGUMENT;
+    }
+
+    uint8_t computed[AES_GCM_TAG_LEN];
+    AES_gcm_final(gcm, key, round_keys, num_rounds, computed);
+
+    // Constant time comparison, no early exit on the first difference
+    uint8_t diff = 0;
+    for (size_t i = 0; i < tag_len; i++) {
+        diff |= (uint8_t)(computed[i] ^ tag[i]);
+    }
+    return (diff == 0) ? AES_CODE_OK : AES_CODE_AUTHENTICATION_FAILED;
+}
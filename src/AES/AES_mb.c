@@ -0,0 +1,227 @@
+/**
+ * @file AES_mb.c
+ * @brief Multi-buffer CBC encryption of many independent messages
+ * @version 0.1
+ * @date 2025-03-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "AES_mb.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "AES_ni.h"
+
+#define AES_MB_DONE_CAPACITY (AES_MB_LANE_SETS * AES_MB_LANES + 1)
+
+void AES_mb_CBC_encrypt_lanes(const uint8_t *const *round_keys,
+                              size_t num_rounds, uint8_t *const *iv,
+                              const uint8_t *const *in, uint8_t *const *out,
+                              size_t num_lanes, size_t num_blocks) {
+#if AES_NI_SUPPORTED
+    if (AES_get_backend() == AES_BACKEND_AESNI) {
+        AES_ni_CBC_encrypt_lanes(round_keys, num_rounds, iv, in, out,
+                                 num_lanes, num_blocks);
+        return;
+    }
+#endif
+    // No gain in interleaving the portable rounds, see AES_mb.h
+    for (size_t j = 0; j < num_lanes; j++) {
+        AES_CBC_encrypt_blocks(round_keys[j], num_rounds, iv[j], in[j], out[j],
+                               num_blocks);
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) == 0) {
+        return 0.0;
+    }
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+void AES_mb_mgr_init(AES_mb_mgr_t *mgr) { memset(mgr, 0, sizeof(*mgr)); }
+
+static void push_done(AES_mb_mgr_t *mgr, AES_mb_job_t *job) {
+    size_t tail = (mgr->done_head + mgr->done_count) % AES_MB_DONE_CAPACITY;
+    mgr->done[tail] = job;
+    mgr->done_count++;
+    mgr->stats.jobs++;
+    if (job->status == AES_CODE_OK) {
+        mgr->stats.bytes += job->len;
+    }
+}
+
+static AES_mb_job_t *pop_done(AES_mb_mgr_t *mgr) {
+    if (mgr->done_count == 0) {
+        return NULL;
+    }
+    AES_mb_job_t *job = mgr->done[mgr->done_head];
+    mgr->done_head = (mgr->done_head + 1) % AES_MB_DONE_CAPACITY;
+    mgr->done_count--;
+    return job;
+}
+
+/* Encrypts the busy lanes of a set until at least one message is complete */
+static void run_lane_set(AES_mb_mgr_t *mgr, size_t set) {
+    AES_mb_lane_t *lanes = mgr->lanes[set];
+    const uint8_t *round_keys[AES_MB_LANES];
+    uint8_t *iv[AES_MB_LANES];
+    const uint8_t *in[AES_MB_LANES];
+    uint8_t *out[AES_MB_LANES];
+    AES_mb_lane_t *busy[AES_MB_LANES];
+    size_t num_rounds = 0;
+    bool completed = false;
+
+    while (!completed) {
+        // Every lane moves by the same number of blocks: the whole blocks
+        // left in the shortest message, or one padded tail block
+        size_t num_lanes = 0;
+        size_t num_blocks = SIZE_MAX;
+        for (size_t j = 0; j < AES_MB_LANES; j++) {
+            AES_mb_lane_t *lane = &lanes[j];
+            if (lane->job == NULL) {
+                continue;
+            }
+            size_t blocks = (lane->blocks > 0) ? lane->blocks : 1;
+            if (blocks < num_blocks) {
+                num_blocks = blocks;
+            }
+            busy[num_lanes] = lane;
+            round_keys[num_lanes] = lane->job->round_keys;
+            iv[num_lanes] = lane->job->iv;
+            in[num_lanes] = (lane->blocks > 0) ? lane->in : lane->tail;
+            out[num_lanes] = lane->out;
+            num_rounds = lane->job->num_rounds;
+            num_lanes++;
+        }
+        if (num_lanes == 0) {
+            return;
+        }
+
+        AES_mb_CBC_encrypt_lanes(round_keys, num_rounds, iv, in, out,
+                                 num_lanes, num_blocks);
+        mgr->stats.blocks += num_blocks * num_lanes;
+        mgr->stats.steps += num_blocks;
+
+        for (size_t j = 0; j < num_lanes; j++) {
+            AES_mb_lane_t *lane = busy[j];
+            if (lane->blocks > 0) {
+                lane->blocks -= num_blocks;
+                lane->in += num_blocks * AES_BLOCK_LEN;
+                lane->out += num_blocks * AES_BLOCK_LEN;
+            } else {
+                lane->tail_pending = false;
+            }
+            if (lane->blocks == 0 && !lane->tail_pending) {
+                lane->job->status = AES_CODE_OK;
+                push_done(mgr, lane->job);
+                lane->job = NULL;
+                mgr->lanes_used[set]--;
+                completed = true;
+            }
+        }
+    }
+}
+
+/* Queues a valid job in a free lane of its set */
+static void start_job(AES_mb_mgr_t *mgr, size_t set, AES_mb_job_t *job) {
+    AES_mb_lane_t *lane = mgr->lanes[set];
+    while (lane->job != NULL) {
+        lane++;
+    }
+
+    lane->job = job;
+    lane->in = job->in;
+    lane->out = job->out;
+    lane->blocks = job->len / AES_BLOCK_LEN;
+
+    // Same tail as the one-shot functions: PKCS7, or zeros up to a block
+    size_t rem = job->len % AES_BLOCK_LEN;
+    lane->tail_pending = job->use_padding || (rem > 0);
+    if (lane->tail_pending) {
+        uint8_t pad = job->use_padding ? (uint8_t)(AES_BLOCK_LEN - rem) : 0;
+        memcpy(lane->tail, job->in + (AES_BLOCK_LEN * lane->blocks), rem);
+        memset(lane->tail + rem, pad, AES_BLOCK_LEN - rem);
+    }
+    job->out_len = (lane->blocks + (lane->tail_pending ? 1 : 0)) *
+                   AES_BLOCK_LEN;
+    mgr->lanes_used[set]++;
+}
+
+AES_mb_job_t *AES_mb_submit(AES_mb_mgr_t *mgr, AES_mb_job_t *job) {
+    double start = now_seconds();
+
+    job->out_len = 0;
+    if (job->len == 0) {
+        job->status = AES_CODE_EMPTY_INPUT_BUFFER;
+        push_done(mgr, job);
+    } else if (job->num_rounds != 10 && job->num_rounds != 12 &&
+               job->num_rounds != 14) {
+        job->status = AES_CODE_INVALID_ARGUMENT;
+        push_done(mgr, job);
+    } else {
+        size_t set = (job->num_rounds - 10) / 2;
+        // Lanes are only run once they are all busy, so each step is full
+        if (mgr->lanes_used[set] == AES_MB_LANES) {
+            run_lane_set(mgr, set);
+        }
+        start_job(mgr, set, job);
+    }
+
+    mgr->stats.seconds += now_seconds() - start;
+    return pop_done(mgr);
+}
+
+AES_mb_job_t *AES_mb_flush(AES_mb_mgr_t *mgr) {
+    if (mgr->done_count == 0) {
+        // The fullest set first, its steps encrypt the most blocks
+        size_t best = 0;
+        for (size_t set = 1; set < AES_MB_LANE_SETS; set++) {
+            if (mgr->lanes_used[set] > mgr->lanes_used[best]) {
+                best = set;
+            }
+        }
+        if (mgr->lanes_used[best] > 0) {
+            double start = now_seconds();
+            run_lane_set(mgr, best);
+            mgr->stats.seconds += now_seconds() - start;
+        }
+    }
+    return pop_done(mgr);
+}
+
+void AES_mb_mgr_get_stats(const AES_mb_mgr_t *mgr, AES_mb_stats_t *stats) {
+    *stats = mgr->stats;
+    stats->bytes_per_second =
+        (stats->seconds > 0.0) ? (double)stats->bytes / stats->seconds : 0.0;
+    stats->lane_occupancy =
+        (stats->steps > 0)
+            ? (double)stats->blocks / (double)(stats->steps * AES_MB_LANES)
+            : 0.0;
+}
+
+AES_errcode_t AES_mb_process(AES_mb_job_t *jobs, size_t num_jobs,
+                             AES_mb_stats_t *stats) {
+    AES_mb_mgr_t mgr;
+    AES_mb_mgr_init(&mgr);
+
+    for (size_t i = 0; i < num_jobs; i++) {
+        AES_mb_submit(&mgr, &jobs[i]);
+    }
+    while (AES_mb_flush(&mgr) != NULL) {
+    }
+
+    if (stats != NULL) {
+        AES_mb_mgr_get_stats(&mgr, stats);
+    }
+
+    for (size_t i = 0; i < num_jobs; i++) {
+        if (jobs[i].status != AES_CODE_OK) {
+            return jobs[i].status;
+        }
+    }
+    return AES_CODE_OK;
+}
@@ -0,0 +1,837 @@
+/**
+ * @file AES_ni.c
+ * @brief AES-NI hardware backend for x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "AES_ni.h"
+
+#if AES_NI_SUPPORTED
+
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <string.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+#define AES_NI_TARGET __attribute__((target("aes,pclmul,sse2,ssse3")))
+
+bool AES_ni_available(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ecx & bit_AES) != 0 && (ecx & bit_PCLMUL) != 0 &&
+           (ecx & bit_SSSE3) != 0 && (edx & bit_SSE2) != 0;
+}
+
+/* Completes one AES-128 key schedule step (also the even AES-256 steps) */
+AES_NI_TARGET static inline __m128i expand_assist_128(__m128i key,
+                                                      __m128i keygened) {
+    keygened = _mm_shuffle_epi32(keygened, 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 8));
+    return _mm_xor_si128(key, keygened);
+}
+
+/* Completes one AES-192 key schedule step on the 6-word window (lo, hi) */
+AES_NI_TARGET static inline void expand_assist_192(__m128i *lo, __m128i *hi,
+                                                   __m128i keygened) {
+    keygened = _mm_shuffle_epi32(keygened, 0x55);
+    *lo = _mm_xor_si128(*lo, _mm_slli_si128(*lo, 4));
+    *lo = _mm_xor_si128(*lo, _mm_slli_si128(*lo, 8));
+    *lo = _mm_xor_si128(*lo, keygened);
+    keygened = _mm_shuffle_epi32(*lo, 0xFF);
+    *hi = _mm_xor_si128(*hi, _mm_slli_si128(*hi, 4));
+    *hi = _mm_xor_si128(*hi, keygened);
+}
+
+/* Odd AES-256 key schedule step: SubWord without RotWord or rcon */
+AES_NI_TARGET static inline __m128i expand_assist_256(__m128i key,
+                                                      __m128i prev) {
+    __m128i keygened = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(prev, 0),
+                                         0xAA);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 8));
+    return _mm_xor_si128(key, keygened);
+}
+
+/* Merges the low half of a with the low half of b */
+AES_NI_TARGET static inline __m128i merge_lo(__m128i a, __m128i b) {
+    return _mm_castpd_si128(
+        _mm_shuffle_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b), 0));
+}
+
+/* Merges the high half of a with the low half of b */
+AES_NI_TARGET static inline __m128i merge_hi_lo(__m128i a, __m128i b) {
+    return _mm_castpd_si128(
+        _mm_shuffle_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b), 1));
+}
+
+AES_NI_TARGET static size_t expand_key_128(const uint8_t *key, __m128i *rk) {
+    rk[0] = _mm_loadu_si128((const __m128i *)key);
+    // The rcon operand of AESKEYGENASSIST must be an immediate
+#define AES_NI_EXPAND_128(i, rcon) \
+    rk[i] = expand_assist_128(rk[i - 1], \
+                              _mm_aeskeygenassist_si128(rk[i - 1], rcon))
+    AES_NI_EXPAND_128(1, 0x01);
+    AES_NI_EXPAND_128(2, 0x02);
+    AES_NI_EXPAND_128(3, 0x04);
+    AES_NI_EXPAND_128(4, 0x08);
+    AES_NI_EXPAND_128(5, 0x10);
+    AES_NI_EXPAND_128(6, 0x20);
+    AES_NI_EXPAND_128(7, 0x40);
+    AES_NI_EXPAND_128(8, 0x80);
+    AES_NI_EXPAND_128(9, 0x1B);
+    AES_NI_EXPAND_128(10, 0x36);
+#undef AES_NI_EXPAND_128
+    return 10;
+}
+
+AES_NI_TARGET static size_t expand_key_192(const uint8_t *key, __m128i *rk) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)key);
+    __m128i hi = _mm_loadl_epi64((const __m128i *)(key + 16));
+
+    // Every two steps produce three round keys (6 words each step)
+    rk[0] = lo;
+    rk[1] = hi;
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x01));
+    rk[1] = merge_lo(rk[1], lo);
+    rk[2] = merge_hi_lo(lo, hi);
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x02));
+    rk[3] = lo;
+    rk[4] = hi;
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x04));
+    rk[4] = merge_lo(rk[4], lo);
+    rk[5] = merge_hi_lo(lo, hi);
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x08));
+    rk[6] = lo;
+    rk[7] = hi;
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x10));
+    rk[7] = merge_lo(rk[7], lo);
+    rk[8] = merge_hi_lo(lo, hi);
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x20));
+    rk[9] = lo;
+    rk[10] = hi;
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x40));
+    rk[10] = merge_lo(rk[10], lo);
+    rk[11] = merge_hi_lo(lo, hi);
+    expand_assist_192(&lo, &hi, _mm_aeskeygenassist_si128(hi, 0x80));
+    rk[12] = lo;
+    return 12;
+}
+
+AES_NI_TARGET static size_t expand_key_256(const uint8_t *key, __m128i *rk) {
+    rk[0] = _mm_loadu_si128((const __m128i *)key);
+    rk[1] = _mm_loadu_si128((const __m128i *)(key + 16));
+#define AES_NI_EXPAND_256(i, rcon)                                       \
+    do {                                                                 \
+        rk[i] = expand_assist_128(                                       \
+            rk[i - 2], _mm_aeskeygenassist_si128(rk[i - 1], rcon));      \
+        if ((i) < 14) rk[(i) + 1] = expand_assist_256(rk[i - 1], rk[i]); \
+    } while (0)
+    AES_NI_EXPAND_256(2, 0x01);
+    AES_NI_EXPAND_256(4, 0x02);
+    AES_NI_EXPAND_256(6, 0x04);
+    AES_NI_EXPAND_256(8, 0x08);
+    AES_NI_EXPAND_256(10, 0x10);
+    AES_NI_EXPAND_256(12, 0x20);
+    AES_NI_EXPAND_256(14, 0x40);
+#undef AES_NI_EXPAND_256
+    return 14;
+}
+
+AES_NI_TARGET void AES_ni_expand_key(const uint8_t *key, size_t key_size,
+                                     uint8_t *round_keys,
+                                     uint8_t *inv_round_keys) {
+    __m128i rk[15];
+    size_t num_rounds;
+
+    switch (key_size) {
+        case 16:
+            num_rounds = expand_key_128(key, rk);
+            break;
+        case 24:
+            num_rounds = expand_key_192(key, rk);
+            break;
+        default:
+            num_rounds = expand_key_256(key, rk);
+            break;
+    }
+
+    for (size_t i = 0; i <= num_rounds; i++) {
+        _mm_storeu_si128((__m128i *)(round_keys + (AES_BLOCK_LEN * i)), rk[i]);
+    }
+
+    // Equivalent inverse cipher: reversed order, InvMixColumns on inner keys
+    _mm_storeu_si128((__m128i *)inv_round_keys, rk[num_rounds]);
+    for (size_t i = 1; i < num_rounds; i++) {
+        _mm_storeu_si128((__m128i *)(inv_round_keys + (AES_BLOCK_LEN * i)),
+                         _mm_aesimc_si128(rk[num_rounds - i]));
+    }
+    _mm_storeu_si128(
+        (__m128i *)(inv_round_keys + (AES_BLOCK_LEN * num_rounds)), rk[0]);
+}
+
+/* Loads a key schedule into registers */
+AES_NI_TARGET static inline void load_round_keys(const uint8_t *round_keys,
+                                                 size_t num_rounds,
+                                                 __m128i *rk) {
+    for (size_t i = 0; i <= num_rounds; i++) {
+        rk[i] = _mm_loadu_si128(
+            (const __m128i *)(round_keys + (AES_BLOCK_LEN * i)));
+    }
+}
+
+AES_NI_TARGET static inline __m128i encrypt1(const __m128i *rk,
+                                             size_t num_rounds, __m128i b) {
+    b = _mm_xor_si128(b, rk[0]);
+    for (size_t r = 1; r < num_rounds; r++) {
+        b = _mm_aesenc_si128(b, rk[r]);
+    }
+    return _mm_aesenclast_si128(b, rk[num_rounds]);
+}
+
+AES_NI_TARGET static inline __m128i decrypt1(const __m128i *rk,
+                                             size_t num_rounds, __m128i b) {
+    b = _mm_xor_si128(b, rk[0]);
+    for (size_t r = 1; r < num_rounds; r++) {
+        b = _mm_aesdec_si128(b, rk[r]);
+    }
+    return _mm_aesdeclast_si128(b, rk[num_rounds]);
+}
+
+/* Applies one round instruction to 8 independent blocks. Written out so the
+ * blocks stay in registers even when the compiler does not unroll loops */
+#define AES_NI_ROUND8(op, b, k)  \
+    do {                         \
+        (b)[0] = op((b)[0], k);  \
+        (b)[1] = op((b)[1], k);  \
+        (b)[2] = op((b)[2], k);  \
+        (b)[3] = op((b)[3], k);  \
+        (b)[4] = op((b)[4], k);  \
+        (b)[5] = op((b)[5], k);  \
+        (b)[6] = op((b)[6], k);  \
+        (b)[7] = op((b)[7], k);  \
+    } while (0)
+
+/* Runs the full cipher on 8 independent blocks so the AES unit stays busy */
+AES_NI_TARGET static inline void encrypt8(const __m128i *rk, size_t num_rounds,
+                                          __m128i *b) {
+    AES_NI_ROUND8(_mm_xor_si128, b, rk[0]);
+    for (size_t r = 1; r < num_rounds; r++) {
+        AES_NI_ROUND8(_mm_aesenc_si128, b, rk[r]);
+    }
+    AES_NI_ROUND8(_mm_aesenclast_si128, b, rk[num_rounds]);
+}
+
+AES_NI_TARGET static inline void decrypt8(const __m128i *rk, size_t num_rounds,
+                                          __m128i *b) {
+    AES_NI_ROUND8(_mm_xor_si128, b, rk[0]);
+    for (size_t r = 1; r < num_rounds; r++) {
+        AES_NI_ROUND8(_mm_aesdec_si128, b, rk[r]);
+    }
+    AES_NI_ROUND8(_mm_aesdeclast_si128, b, rk[num_rounds]);
+}
+
+AES_NI_TARGET void AES_ni_ECB_encrypt(const uint8_t *round_keys,
+                                      size_t num_rounds, const uint8_t *in,
+                                      uint8_t *out, size_t num_blocks) {
+    __m128i rk[15];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    load_round_keys(round_keys, num_rounds, rk);
+
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            b[j] = _mm_loadu_si128((const __m128i *)in + j);
+        }
+        encrypt8(rk, num_rounds, b);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)out + j, b[j]);
+        }
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i block = _mm_loadu_si128((const __m128i *)in);
+        _mm_storeu_si128((__m128i *)out, encrypt1(rk, num_rounds, block));
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+}
+
+AES_NI_TARGET void AES_ni_ECB_decrypt(const uint8_t *inv_round_keys,
+                                      size_t num_rounds, const uint8_t *in,
+                                      uint8_t *out, size_t num_blocks) {
+    __m128i rk[15];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    load_round_keys(inv_round_keys, num_rounds, rk);
+
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            b[j] = _mm_loadu_si128((const __m128i *)in + j);
+        }
+        decrypt8(rk, num_rounds, b);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)out + j, b[j]);
+        }
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i block = _mm_loadu_si128((const __m128i *)in);
+        _mm_storeu_si128((__m128i *)out, decrypt1(rk, num_rounds, block));
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+}
+
+AES_NI_TARGET void AES_ni_CBC_encrypt(const uint8_t *round_keys,
+                                      size_t num_rounds, uint8_t *iv,
+                                      const uint8_t *in, uint8_t *out,
+                                      size_t num_blocks) {
+    __m128i rk[15];
+    load_round_keys(round_keys, num_rounds, rk);
+    __m128i chain = _mm_loadu_si128((const __m128i *)iv);
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i block = _mm_loadu_si128((const __m128i *)in);
+        chain = encrypt1(rk, num_rounds, _mm_xor_si128(block, chain));
+        _mm_storeu_si128((__m128i *)out, chain);
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+
+    _mm_storeu_si128((__m128i *)iv, chain);
+}
+
+AES_NI_TARGET void AES_ni_CBC_decrypt(const uint8_t *inv_round_keys,
+                                      size_t num_rounds, uint8_t *iv,
+                                      const uint8_t *in, uint8_t *out,
+                                      size_t num_blocks) {
+    __m128i rk[15];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    load_round_keys(inv_round_keys, num_rounds, rk);
+    __m128i chain = _mm_loadu_si128((const __m128i *)iv);
+
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        const __m128i *cin = (const __m128i *)in;
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            b[j] = _mm_loadu_si128(cin + j);
+        }
+        decrypt8(rk, num_rounds, b);
+
+        // Stored back to front so that the previous ciphertext block is
+        // still intact when out == in
+        __m128i next_chain = _mm_loadu_si128(cin + AES_NI_PIPELINE_BLOCKS - 1);
+        for (size_t j = AES_NI_PIPELINE_BLOCKS - 1; j > 0; j--) {
+            _mm_storeu_si128((__m128i *)out + j,
+                             _mm_xor_si128(b[j], _mm_loadu_si128(cin + j - 1)));
+        }
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(b[0], chain));
+        chain = next_chain;
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i cipher = _mm_loadu_si128((const __m128i *)in);
+        __m128i plain = decrypt1(rk, num_rounds, cipher);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(plain, chain));
+        chain = cipher;
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+
+    _mm_storeu_si128((__m128i *)iv, chain);
+}
+
+/* Counter block held as two native 64-bit halves; only the bits selected by
+ * the masks are incremented */
+typedef struct {
+    uint64_t hi;
+    uint64_t lo;
+    uint64_t mask_hi;
+    uint64_t mask_lo;
+} ctr_block_t;
+
+static inline void ctr_load(ctr_block_t *c, const uint8_t *counter,
+                            size_t counter_bits) {
+    memcpy(&c->hi, counter, 8);
+    memcpy(&c->lo, counter + 8, 8);
+    c->hi = __builtin_bswap64(c->hi);
+    c->lo = __builtin_bswap64(c->lo);
+    if (counter_bits < 64) {
+        c->mask_lo = ((uint64_t)1 << counter_bits) - 1;
+        c->mask_hi = 0;
+    } else {
+        c->mask_lo = UINT64_MAX;
+        c->mask_hi = (counter_bits >= 128)
+                         ? UINT64_MAX
+                         : ((uint64_t)1 << (counter_bits - 64)) - 1;
+    }
+}
+
+static inline void ctr_store(const ctr_block_t *c, uint8_t *counter) {
+    uint64_t hi = __builtin_bswap64(c->hi);
+    uint64_t lo = __builtin_bswap64(c->lo);
+    memcpy(counter, &hi, 8);
+    memcpy(counter + 8, &lo, 8);
+}
+
+static inline void ctr_add(ctr_block_t *c, uint64_t n) {
+    uint64_t lo = (c->lo & ~c->mask_lo) | ((c->lo + n) & c->mask_lo);
+    if ((lo & c->mask_lo) < (c->lo & c->mask_lo)) {
+        c->hi = (c->hi & ~c->mask_hi) | ((c->hi + 1) & c->mask_hi);
+    }
+    c->lo = lo;
+}
+
+/* Returns the current counter block and advances the counter by one */
+AES_NI_TARGET static inline __m128i ctr_next(ctr_block_t *c) {
+    __m128i block = _mm_set_epi64x((long long)__builtin_bswap64(c->lo),
+                                   (long long)__builtin_bswap64(c->hi));
+    ctr_add(c, 1);
+    return block;
+}
+
+/* Reverses the byte order of a block. Turns the big-endian counter into two
+ * native 64-bit lanes that SSE can add to, and GCM's reflected bit order into
+ * the one expected by the carry-less multiplication below */
+AES_NI_TARGET static inline __m128i bswap128(__m128i b) {
+    return _mm_shuffle_epi8(
+        b, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/* Fills a pipeline batch with consecutive counter blocks */
+AES_NI_TARGET static inline void ctr_next8(ctr_block_t *c, __m128i *b) {
+    if (c->mask_lo >= AES_NI_PIPELINE_BLOCKS &&
+        (c->lo & c->mask_lo) <= c->mask_lo - AES_NI_PIPELINE_BLOCKS) {
+        // No wrap-around within the batch: plain 64-bit lane additions
+        __m128i base = _mm_set_epi64x((long long)c->hi, (long long)c->lo);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            b[j] = bswap128(
+                _mm_add_epi64(base, _mm_set_epi64x(0, (long long)j)));
+        }
+        c->lo += AES_NI_PIPELINE_BLOCKS;
+    } else {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            b[j] = ctr_next(c);
+        }
+    }
+}
+
+AES_NI_TARGET void AES_ni_CTR_xcrypt(const uint8_t *round_keys,
+                                     size_t num_rounds, uint8_t *counter,
+                                     size_t counter_bits, const uint8_t *in,
+                                     uint8_t *out, size_t num_blocks) {
+    __m128i rk[15];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    ctr_block_t c;
+    load_round_keys(round_keys, num_rounds, rk);
+    ctr_load(&c, counter, counter_bits);
+
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        ctr_next8(&c, b);
+        encrypt8(rk, num_rounds, b);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            __m128i data = _mm_loadu_si128((const __m128i *)in + j);
+            _mm_storeu_si128((__m128i *)out + j, _mm_xor_si128(data, b[j]));
+        }
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i keystream = encrypt1(rk, num_rounds, ctr_next(&c));
+        __m128i data = _mm_loadu_si128((const __m128i *)in);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(data, keystream));
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+
+    ctr_store(&c, counter);
+}
+
+/* Unreduced 256-bit carry-less product of a and b, accumulated into lo/hi */
+AES_NI_TARGET static inline void clmul_acc(__m128i a, __m128i b, __m128i *lo,
+                                           __m128i *hi) {
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                                _mm_clmulepi64_si128(a, b, 0x01));
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+    *lo = _mm_xor_si128(*lo, _mm_slli_si128(mid, 8));
+    *hi = _mm_xor_si128(*hi, _mm_srli_si128(mid, 8));
+}
+
+/* Reduces a 256-bit product of byte-reversed operands modulo the GCM
+ * polynomial. The product of two bit-reflected values is one bit short, hence
+ * the shift left before the reduction */
+AES_NI_TARGET static inline __m128i ghash_reduce(__m128i lo, __m128i hi) {
+    __m128i carry_lo = _mm_srli_epi32(lo, 31);
+    __m128i carry_hi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    __m128i cross = _mm_srli_si128(carry_lo, 12);
+    carry_hi = _mm_slli_si128(carry_hi, 4);
+    carry_lo = _mm_slli_si128(carry_lo, 4);
+    lo = _mm_or_si128(lo, carry_lo);
+    hi = _mm_or_si128(_mm_or_si128(hi, carry_hi), cross);
+
+    __m128i t = _mm_xor_si128(
+        _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+        _mm_slli_epi32(lo, 25));
+    __m128i t_hi = _mm_srli_si128(t, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+
+    __m128i r = _mm_xor_si128(
+        _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+        _mm_srli_epi32(lo, 7));
+    r = _mm_xor_si128(_mm_xor_si128(r, t_hi), lo);
+    return _mm_xor_si128(hi, r);
+}
+
+/* x = x * h, one block at a time */
+AES_NI_TARGET static inline __m128i ghash_mult1(__m128i x, __m128i h) {
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    clmul_acc(x, h, &lo, &hi);
+    return ghash_reduce(lo, hi);
+}
+
+/* Hashes 8 byte-reversed blocks with a single reduction:
+ * x = (x ^ c0) * H^8 ^ c1 * H^7 ^ ... ^ c7 * H */
+AES_NI_TARGET static inline __m128i ghash8(const __m128i *hpow, __m128i x,
+                                           const __m128i *c) {
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    clmul_acc(_mm_xor_si128(x, c[0]), hpow[7], &lo, &hi);
+    for (size_t j = 1; j < AES_NI_PIPELINE_BLOCKS; j++) {
+        clmul_acc(c[j], hpow[7 - j], &lo, &hi);
+    }
+    return ghash_reduce(lo, hi);
+}
+
+/* Loads H^1 .. H^8 byte-reversed */
+AES_NI_TARGET static inline void load_hash_powers(const uint8_t *hash_powers,
+                                                  __m128i *hpow) {
+    for (size_t i = 0; i < AES_NI_PIPELINE_BLOCKS; i++) {
+        hpow[i] = bswap128(_mm_loadu_si128(
+            (const __m128i *)(hash_powers + (AES_BLOCK_LEN * i))));
+    }
+}
+
+AES_NI_TARGET void AES_ni_GHASH(const uint8_t *hash_powers, uint8_t *x,
+                                const uint8_t *data, size_t num_blocks) {
+    __m128i hpow[AES_NI_PIPELINE_BLOCKS];
+    __m128i c[AES_NI_PIPELINE_BLOCKS];
+    load_hash_powers(hash_powers, hpow);
+    __m128i acc = bswap128(_mm_loadu_si128((const __m128i *)x));
+
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            c[j] = bswap128(_mm_loadu_si128((const __m128i *)data + j));
+        }
+        acc = ghash8(hpow, acc, c);
+        data += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i block = bswap128(_mm_loadu_si128((const __m128i *)data));
+        acc = ghash_mult1(_mm_xor_si128(acc, block), hpow[0]);
+        data += AES_BLOCK_LEN;
+    }
+
+    _mm_storeu_si128((__m128i *)x, bswap128(acc));
+}
+
+AES_NI_TARGET void AES_ni_GCM_encrypt(const uint8_t *round_keys,
+                                      size_t num_rounds,
+                                      const uint8_t *hash_powers,
+                                      uint8_t *counter, uint8_t *x,
+                                      const uint8_t *in, uint8_t *out,
+                                      size_t num_blocks) {
+    __m128i rk[15];
+    __m128i hpow[AES_NI_PIPELINE_BLOCKS];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    ctr_block_t c;
+    load_round_keys(round_keys, num_rounds, rk);
+    load_hash_powers(hash_powers, hpow);
+    ctr_load(&c, counter, 32);
+    __m128i acc = bswap128(_mm_loadu_si128((const __m128i *)x));
+
+    // The GHASH of one batch and the AES rounds of the next one have no
+    // dependency, so the out-of-order core overlaps them
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        ctr_next8(&c, b);
+        encrypt8(rk, num_rounds, b);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            __m128i data = _mm_loadu_si128((const __m128i *)in + j);
+            b[j] = _mm_xor_si128(data, b[j]);
+            _mm_storeu_si128((__m128i *)out + j, b[j]);
+            b[j] = bswap128(b[j]);
+        }
+        acc = ghash8(hpow, acc, b);
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i keystream = encrypt1(rk, num_rounds, ctr_next(&c));
+        __m128i data = _mm_loadu_si128((const __m128i *)in);
+        __m128i cipher = _mm_xor_si128(data, keystream);
+        _mm_storeu_si128((__m128i *)out, cipher);
+        acc = ghash_mult1(_mm_xor_si128(acc, bswap128(cipher)), hpow[0]);
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+
+    ctr_store(&c, counter);
+    _mm_storeu_si128((__m128i *)x, bswap128(acc));
+}
+
+AES_NI_TARGET void AES_ni_GCM_decrypt(const uint8_t *round_keys,
+                                      size_t num_rounds,
+                                      const uint8_t *hash_powers,
+                                      uint8_t *counter, uint8_t *x,
+                                      const uint8_t *in, uint8_t *out,
+                                      size_t num_blocks) {
+    __m128i rk[15];
+    __m128i hpow[AES_NI_PIPELINE_BLOCKS];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+    __m128i cipher[AES_NI_PIPELINE_BLOCKS];
+    ctr_block_t c;
+    load_round_keys(round_keys, num_rounds, rk);
+    load_hash_powers(hash_powers, hpow);
+    ctr_load(&c, counter, 32);
+    __m128i acc = bswap128(_mm_loadu_si128((const __m128i *)x));
+
+    // The ciphertext is known up front: its GHASH and the keystream of the
+    // same batch are independent and run side by side
+    for (; num_blocks >= AES_NI_PIPELINE_BLOCKS;
+         num_blocks -= AES_NI_PIPELINE_BLOCKS) {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            cipher[j] = _mm_loadu_si128((const __m128i *)in + j);
+        }
+        ctr_next8(&c, b);
+        encrypt8(rk, num_rounds, b);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)out + j,
+                             _mm_xor_si128(cipher[j], b[j]));
+            cipher[j] = bswap128(cipher[j]);
+        }
+        acc = ghash8(hpow, acc, cipher);
+        in += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+        out += AES_BLOCK_LEN * AES_NI_PIPELINE_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        __m128i keystream = encrypt1(rk, num_rounds, ctr_next(&c));
+        __m128i data = _mm_loadu_si128((const __m128i *)in);
+        acc = ghash_mult1(_mm_xor_si128(acc, bswap128(data)), hpow[0]);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(data, keystream));
+        in += AES_BLOCK_LEN;
+        out += AES_BLOCK_LEN;
+    }
+
+    ctr_store(&c, counter);
+    _mm_storeu_si128((__m128i *)x, bswap128(acc));
+}
+
+/* Applies one round to the 8 lanes of a multi-buffer step, each lane with
+ * the round key of its own message */
+#define AES_NI_LANE_KEY(k, j, r) \
+    _mm_loadu_si128((const __m128i *)((k)[j] + (AES_BLOCK_LEN * (r))))
+#define AES_NI_LANES_ROUND8(op, b, k, r)               \
+    do {                                               \
+        (b)[0] = op((b)[0], AES_NI_LANE_KEY(k, 0, r)); \
+        (b)[1] = op((b)[1], AES_NI_LANE_KEY(k, 1, r)); \
+        (b)[2] = op((b)[2], AES_NI_LANE_KEY(k, 2, r)); \
+        (b)[3] = op((b)[3], AES_NI_LANE_KEY(k, 3, r)); \
+        (b)[4] = op((b)[4], AES_NI_LANE_KEY(k, 4, r)); \
+        (b)[5] = op((b)[5], AES_NI_LANE_KEY(k, 5, r)); \
+        (b)[6] = op((b)[6], AES_NI_LANE_KEY(k, 6, r)); \
+        (b)[7] = op((b)[7], AES_NI_LANE_KEY(k, 7, r)); \
+    } while (0)
+
+AES_NI_TARGET void AES_ni_CBC_encrypt_lanes(const uint8_t *const *round_keys,
+                                            size_t num_rounds,
+                                            uint8_t *const *iv,
+                                            const uint8_t *const *in,
+                                            uint8_t *const *out,
+                                            size_t num_lanes,
+                                            size_t num_blocks) {
+    // Lanes without a message encrypt a scratch block, so every step keeps
+    // 8 independent blocks in the pipeline
+    uint8_t scratch[AES_BLOCK_LEN] = {0};
+    const uint8_t *lane_keys[AES_NI_PIPELINE_BLOCKS];
+    const uint8_t *lane_in[AES_NI_PIPELINE_BLOCKS];
+    uint8_t *lane_out[AES_NI_PIPELINE_BLOCKS];
+    size_t stride[AES_NI_PIPELINE_BLOCKS];
+    __m128i b[AES_NI_PIPELINE_BLOCKS];
+
+    for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+        if (j < num_lanes) {
+            lane_keys[j] = round_keys[j];
+            lane_in[j] = in[j];
+            lane_out[j] = out[j];
+            stride[j] = AES_BLOCK_LEN;
+            b[j] = _mm_loadu_si128((const __m128i *)iv[j]);
+        } else {
+            lane_keys[j] = round_keys[0];
+            lane_in[j] = scratch;
+            lane_out[j] = scratch;
+            stride[j] = 0;
+            b[j] = _mm_setzero_si128();
+        }
+    }
+
+    for (; num_blocks > 0; num_blocks--) {
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            __m128i data = _mm_loadu_si128((const __m128i *)lane_in[j]);
+            b[j] = _mm_xor_si128(b[j], data);
+        }
+        AES_NI_LANES_ROUND8(_mm_xor_si128, b, lane_keys, 0);
+        for (size_t r = 1; r < num_rounds; r++) {
+            AES_NI_LANES_ROUND8(_mm_aesenc_si128, b, lane_keys, r);
+        }
+        AES_NI_LANES_ROUND8(_mm_aesenclast_si128, b, lane_keys, num_rounds);
+        for (size_t j = 0; j < AES_NI_PIPELINE_BLOCKS; j++) {
+            _mm_storeu_si128((__m128i *)lane_out[j], b[j]);
+            lane_in[j] += stride[j];
+            lane_out[j] += stride[j];
+        }
+    }
+
+    for (size_t j = 0; j < num_lanes; j++) {
+        _mm_storeu_si128((__m128i *)iv[j], b[j]);
+    }
+}
+
+#else /* !AES_NI_SUPPORTED */
+
+/* Stubs so the dispatcher links on every target; they are never selected */
+
+bool AES_ni_available(void) { return false; }
+
+void AES_ni_expand_key(const uint8_t *key, size_t key_size,
+                       uint8_t *round_keys, uint8_t *inv_round_keys) {
+    (void)key;
+    (void)key_size;
+    (void)round_keys;
+    (void)inv_round_keys;
+}
+
+void AES_ni_ECB_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *in, uint8_t *out, size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_ECB_decrypt(const uint8_t *inv_round_keys, size_t num_rounds,
+                        const uint8_t *in, uint8_t *out, size_t num_blocks) {
+    (void)inv_round_keys;
+    (void)num_rounds;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_CBC_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        uint8_t *iv, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)iv;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_CBC_decrypt(const uint8_t *inv_round_keys, size_t num_rounds,
+                        uint8_t *iv, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks) {
+    (void)inv_round_keys;
+    (void)num_rounds;
+    (void)iv;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_CTR_xcrypt(const uint8_t *round_keys, size_t num_rounds,
+                       uint8_t *counter, size_t counter_bits,
+                       const uint8_t *in, uint8_t *out, size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)counter;
+    (void)counter_bits;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_GHASH(const uint8_t *hash_powers, uint8_t *x, const uint8_t *data,
+                  size_t num_blocks) {
+    (void)hash_powers;
+    (void)x;
+    (void)data;
+    (void)num_blocks;
+}
+
+void AES_ni_GCM_encrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *hash_powers, uint8_t *counter,
+                        uint8_t *x, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)hash_powers;
+    (void)counter;
+    (void)x;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_GCM_decrypt(const uint8_t *round_keys, size_t num_rounds,
+                        const uint8_t *hash_powers, uint8_t *counter,
+                        uint8_t *x, const uint8_t *in, uint8_t *out,
+                        size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)hash_powers;
+    (void)counter;
+    (void)x;
+    (void)in;
+    (void)out;
+    (void)num_blocks;
+}
+
+void AES_ni_CBC_encrypt_lanes(const uint8_t *const *round_keys,
+                              size_t num_rounds, uint8_t *const *iv,
+                              const uint8_t *const *in, uint8_t *const *out,
+                              size_t num_lanes, size_t num_blocks) {
+    (void)round_keys;
+    (void)num_rounds;
+    (void)iv;
+    (void)in;
+    (void)out;
+    (void)num_lanes;
+    (void)num_blocks;
+}
+
+#endif /* AES_NI_SUPPORTED */
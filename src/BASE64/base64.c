@@ -6,6 +6,11 @@
 
 #include "base64.h"
 
+#include <stdatomic.h>
+#include <string.h>
+
+#include "base64_simd.h"
+
 /**
  * @brief Lookup table for converting Base64 characters to 6-bit binary values
  *
@@ -68,118 +73,712 @@ static const uint8_t digit_to_bin[256] = {
     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF  /* 0xF8-0xFF */
 };
 
-// Base64 encoding table
-static const uint8_t bin_to_digit[64] = {
-    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
-    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
-    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
-    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'};
+// Base64 encoding tables, indexed by base64_alphabet_t
+static const uint8_t bin_to_digit[2][64] = {
+    {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+     'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+     'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+     'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'},
+    {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+     'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+     'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+     'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_'}};
+
+const base64_options_t base64_options_standard = {
+    BASE64_ALPHABET_STANDARD, true, 0, false};
+const base64_options_t base64_options_url = {
+    BASE64_ALPHABET_URL, false, 0, false};
+const base64_options_t base64_options_mime = {
+    BASE64_ALPHABET_STANDARD, true, BASE64_MIME_LINE_LENGTH, true};
+const base64_options_t base64_options_pem = {
+    BASE64_ALPHABET_STANDARD, true, BASE64_PEM_LINE_LENGTH, true};
+
+static atomic_int base64_backend = -1;  // -1 until the CPU is checked
+
+base64_backend_t base64_get_backend(void) {
+    int backend = atomic_load_explicit(&base64_backend, memory_order_relaxed);
+    if (backend < 0) {
+        backend = base64_avx2_available()    ? BASE64_BACKEND_AVX2
+                  : base64_ssse3_available() ? BASE64_BACKEND_SSSE3
+                                             : BASE64_BACKEND_SCALAR;
+        atomic_store_explicit(&base64_backend, backend, memory_order_relaxed);
+    }
+    return (base64_backend_t)backend;
+}
+
+bool base64_set_backend(base64_backend_t backend) {
+    switch (backend) {
+        case BASE64_BACKEND_SCALAR:
+            break;
+        case BASE64_BACKEND_SSSE3:
+            if (!base64_ssse3_available()) {
+                return false;
+            }
+            break;
+        case BASE64_BACKEND_AVX2:
+            if (!base64_avx2_available()) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    atomic_store_explicit(&base64_backend, (int)backend, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Checks the alphabet and that lines hold whole groups
+ */
+static bool base64_options_valid(const base64_options_t *options) {
+    return (options->alphabet == BASE64_ALPHABET_STANDARD ||
+            options->alphabet == BASE64_ALPHABET_URL) &&
+           options->line_length % 4 == 0;
+}
+
+/**
+ * @brief Alphabet and layout of a set of options, as the kernels take them
+ */
+static base64_simd_format_t base64_format(const base64_options_t *options) {
+    base64_simd_format_t format = {bin_to_digit[options->alphabet][62],
+                                   bin_to_digit[options->alphabet][63],
+                                   options->line_length,
+                                   options->skip_whitespace};
+    return format;
+}
+
+/**
+ * @brief 6-bit value of a character: BASE64_TERMINATOR for '=', and
+ * BASE64_NOT_DIGIT outside the alphabet
+ */
+static inline uint8_t base64_digit_value(uint8_t c,
+                                         base64_alphabet_t alphabet) {
+    if (alphabet == BASE64_ALPHABET_URL) {
+        if (c == '-') return 62;
+        if (c == '_') return 63;
+        if (c == '+' || c == '/') return BASE64_NOT_DIGIT;
+    }
+    return digit_to_bin[c];
+}
+
+/**
+ * @brief Encodes the leading whole blocks (or lines) with the active vector
+ * kernel
+ * @param[out] written Characters written, line breaks included
+ * @return Input bytes consumed (a multiple of 3), 0 for the scalar backend
+ */
+static size_t base64_encode_blocks(const uint8_t *src, size_t len,
+                                   uint8_t *dest,
+                                   const base64_simd_format_t *format,
+                                   size_t *written) {
+    switch (base64_get_backend()) {
+        case BASE64_BACKEND_AVX2:
+            return base64_avx2_encode(src, len, dest, format, written);
+        case BASE64_BACKEND_SSSE3:
+            return base64_ssse3_encode(src, len, dest, format, written);
+        default:
+            *written = 0;
+            return 0;
+    }
+}
+
+/**
+ * @brief Decodes the leading whole groups with the active vector kernel
+ * @param[out] written Bytes decoded
+ * @return Input characters consumed (a multiple of 4 unless whitespace was
+ * skipped), 0 for the scalar backend
+ */
+static size_t base64_decode_blocks(const uint8_t *src, size_t len,
+                                   uint8_t *dest,
+                                   const base64_simd_format_t *format,
+                                   size_t *written) {
+    switch (base64_get_backend()) {
+        case BASE64_BACKEND_AVX2:
+            return base64_avx2_decode(src, len, dest, format, written);
+        case BASE64_BACKEND_SSSE3:
+            return base64_ssse3_decode(src, len, dest, format, written);
+        default:
+            *written = 0;
+            return 0;
+    }
+}
+
 base64_status_t base64_init(base64_converter_t *converter, uint8_t *buffer,
                             size_t buffer_size) {
-    if (!converter || !buffer || buffer_size < BASE64_MAX_ENCODED_BUFFER) {
+    if (!converter || (!buffer && buffer_size != 0) ||
+        (buffer && buffer_size == 0)) {
         return BASE64_INVALID_INPUT;
     }
 
     converter->buffer = buffer;
     converter->buffer_size = buffer_size;
     converter->bytes_processed = 0;
+    converter->carry_len = 0;
+    converter->padded = false;
 
     return BASE64_SUCCESS;
 }
 
-/**
- * @brief Calculate required buffer size for Base64 encoded output
- *
- * Internal helper function to determine the buffer size needed for encoding.
- *
- * @param input_size Size of the input data in bytes
- * @return Size needed for encoded output including null terminator, or 0 if
- * invalid
- */
-static size_t base64_get_encoded_size(size_t input_size) {
-    if (input_size > BASE64_MAX_INPUT_SIZE) {
-        return 0;  // Invalid size
+size_t base64_encoded_size(size_t input_size) {
+    size_t groups = input_size / 3 + (input_size % 3 != 0);
+    if (groups > SIZE_MAX / 4) {
+        return 0;  // Does not fit in size_t
     }
-    // Formula: Ceiling(input_size / 3) * 4 + 1 for null terminator
-    return ((input_size + 2) / 3) * 4 + 1;
+    return groups * 4;
 }
 
-/**
- * @brief Calculate maximum buffer size needed for Base64 decoded output
- *
- * Internal helper function to determine the buffer size needed for decoding.
- *
- * @param input_size Size of the Base64 encoded input
- * @return Maximum possible decoded size including null terminator, or 0 if
- * invalid
- */
-static size_t base64_get_decoded_size(size_t input_size) {
-    if (input_size > BASE64_MAX_ENCODED_BUFFER || (input_size % 4) != 0) {
-        return 0;  // Invalid size
+size_t base64_encoded_size_ex(size_t input_size,
+                              const base64_options_t *options) {
+    if (!options) {
+        options = &base64_options_standard;
     }
-    // Formula: (input_size / 4) * 3 + 1 for null terminator
-    // Note: This is the maximum possible size, actual size might be less due to
-    // padding
-    return (input_size / 4) * 3 + 1;
+    size_t size = base64_encoded_size(input_size);
+    if (size == 0 || !base64_options_valid(options)) {
+        return 0;
+    }
+    if (!options->padding) {
+        size -= (3 - input_size % 3) % 3;
+    }
+    if (options->line_length != 0) {
+        size_t breaks = (size - 1) / options->line_length;
+        if (breaks > (SIZE_MAX - size) / 2) {
+            return 0;  // Does not fit in size_t
+        }
+        size += breaks * 2;
+    }
+    return size;
 }
 
-base64_status_t base64_encode(base64_converter_t *converter, const void *input,
-                              size_t input_size, const uint8_t **output,
-                              size_t *output_size) {
-    // Input validation
-    if (!converter || !input || !output_size || !output ||
-        input_size > BASE64_MAX_INPUT_SIZE || !converter->buffer) {
-        return BASE64_INVALID_INPUT;
-    }
+size_t base64_decoded_max_size(size_t input_size) {
+    return (input_size / 4) * 3 + (input_size % 4) * 3 / 4;
+}
 
-    size_t required_size = base64_get_encoded_size(input_size);
-    if (converter->buffer_size < required_size) {
-        return BASE64_BUFFER_TOO_SMALL;
+size_t base64_decoded_size(const uint8_t *input, size_t input_size) {
+    if (input_size % 4 != 0 || (input == NULL && input_size != 0)) {
+        return 0;
+    }
+    size_t size = (input_size / 4) * 3;
+    if (input_size != 0) {
+        size -= (input[input_size - 1] == '=') + (input[input_size - 2] == '=');
     }
+    return size;
+}
 
-    const uint8_t *src = (const uint8_t *)input;
-    uint8_t *dest = converter->buffer;
-    size_t i;
+/**
+ * @brief Encodes any input, vector kernel first then one group at a time
+ *
+ * Lines are separated by CRLF, with no line break after the last one.
+ *
+ * @return Number of characters written (no terminator)
+ */
+static size_t base64_encode_raw(const uint8_t *src, size_t input_size,
+                                uint8_t *dest,
+                                const base64_options_t *options) {
+    const uint8_t *digits = bin_to_digit[options->alphabet];
+    const base64_simd_format_t format = base64_format(options);
+    size_t line_length = options->line_length;
+    size_t column = 0;  // The kernels stop at the start of a line
+    uint8_t *start = dest;
+    size_t written;
+    size_t i = base64_encode_blocks(src, input_size, dest, &format, &written);
+    dest += written;
 
     // Process complete 3-byte blocks
-    for (i = 0; i + 2 < input_size; i += 3) {
+    for (; i + 2 < input_size; i += 3) {
+        if (line_length != 0 && column == line_length) {
+            *dest++ = '\r';
+            *dest++ = '\n';
+            column = 0;
+        }
+
         // First character: bits 7-2 from byte 1
-        dest[0] = bin_to_digit[src[i] >> 2];
+        dest[0] = digits[src[i] >> 2];
 
         // Second character: bits 1-0 from byte 1 and bits 7-4 from byte 2
-        dest[1] = bin_to_digit[((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
+        dest[1] = digits[((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
 
         // Third character: bits 3-0 from byte 2 and bits 7-6 from byte 3
-        dest[2] = bin_to_digit[((src[i + 1] & 0x0F) << 2) | (src[i + 2] >> 6)];
+        dest[2] = digits[((src[i + 1] & 0x0F) << 2) | (src[i + 2] >> 6)];
 
         // Fourth character: bits 5-0 from byte 3
-        dest[3] = bin_to_digit[src[i + 2] & 0x3F];
+        dest[3] = digits[src[i + 2] & 0x3F];
 
         dest += 4;
+        column += 4;
     }
 
     // Handle remaining bytes
     if (i < input_size) {
+        if (line_length != 0 && column == line_length) {
+            *dest++ = '\r';
+            *dest++ = '\n';
+        }
+
         // First character: bits 7-2 from remaining byte
-        dest[0] = bin_to_digit[src[i] >> 2];
+        *dest++ = digits[src[i] >> 2];
 
         if (i + 1 < input_size) {
-            // One byte remaining
-            dest[1] = bin_to_digit[((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
-            dest[2] = bin_to_digit[(src[i + 1] & 0x0F) << 2];
-            dest[3] = '=';
-        } else {
             // Two bytes remaining
-            dest[1] = bin_to_digit[(src[i] & 0x03) << 4];
-            dest[2] = '=';
-            dest[3] = '=';
+            *dest++ = digits[((src[i] & 0x03) << 4) | (src[i + 1] >> 4)];
+            *dest++ = digits[(src[i + 1] & 0x0F) << 2];
+            if (options->padding) {
+                *dest++ = '=';
+            }
+        } else {
+            // One byte remaining
+            *dest++ = digits[(src[i] & 0x03) << 4];
+            if (options->padding) {
+                *dest++ = '=';
+                *dest++ = '=';
+            }
         }
-        dest += 4;
+    }
+    return (size_t)(dest - start);
+}
+
+/**
+ * @brief Decodes whole groups, vector kernel first then one group at a time
+ *
+ * Padding is only accepted in the last group. Each group is read before its
+ * bytes are written, and the output never gets ahead of the input, so dest
+ * may be src.
+ *
+ * @param[out] written Number of bytes written
+ */
+static base64_status_t base64_decode_raw(const uint8_t *src, size_t input_size,
+                                         uint8_t *dest, size_t *written) {
+    const base64_simd_format_t format = base64_format(&base64_options_standard);
+    uint8_t *start = dest;
+    size_t unused;
+    size_t i =
+        base64_decode_blocks(src, input_size, dest, &format, &unused) / 4;
+    size_t chunks = input_size / 4;
+
+    src += i * 4;
+    dest += i * 3;
+    for (; i < chunks; i++) {
+        uint8_t b1, b2, b3, b4;
+        bool pad3 = src[2] == '=';
+        bool pad4 = src[3] == '=';
+
+        // Convert each character to its 6-bit value
+        b1 = digit_to_bin[src[0]];
+        b2 = digit_to_bin[src[1]];
+        b3 = digit_to_bin[src[2]];
+        b4 = digit_to_bin[src[3]];
+
+        // Check for invalid characters; padding only ends a group, and
+        // that group the input
+        if (b1 > 0x3F || b2 > 0x3F || (b3 > 0x3F && !pad3) ||
+            (b4 > 0x3F && !pad4) || (pad3 && !pad4) ||
+            (pad4 && i + 1 < chunks)) {
+            return BASE64_INVALID_CHARACTER;
+        }
+
+        // Handle padding
+        if (pad3) b3 = 0;
+        if (pad4) b4 = 0;
+
+        // Combine 6-bit values into bytes
+        *dest++ = (b1 << 2) | (b2 >> 4);
+        if (!pad3) {
+            *dest++ = (b2 << 4) | (b3 >> 2);
+            if (!pad4) {
+                *dest++ = (b3 << 6) | b4;
+            }
+        }
+
+        src += 4;
+    }
+
+    *written = (size_t)(dest - start);
+    return BASE64_SUCCESS;
+}
+
+/**
+ * @brief Decodes with the given options, vector kernel first (whenever a
+ * group starts) then one character at a time
+ *
+ * Whitespace, when skipped, may appear anywhere; padding may only complete
+ * the last group. As in base64_decode_raw(), dest may be src.
+ *
+ * @param[out] written Number of bytes written
+ */
+static base64_status_t base64_decode_format(const uint8_t *src,
+                                            size_t input_size, uint8_t *dest,
+                                            const base64_options_t *options,
+                                            size_t *written) {
+    const base64_simd_format_t format = base64_format(options);
+    uint8_t *start = dest;
+    uint8_t group[4];  // Values of the group being read
+    size_t count = 0;  // Values in group
+    size_t pads = 0;   // '=' characters seen
+    size_t i = 0;
+
+    while (i < input_size) {
+        if (count == 0 && pads == 0) {
+            size_t size;
+            i += base64_decode_blocks(src + i, input_size - i, dest, &format,
+                                      &size);
+            dest += size;
+
+            // Then whole groups of the alphabet, one at a time
+            for (; input_size - i >= 4; i += 4, dest += 3) {
+                uint8_t b1 = base64_digit_value(src[i], options->alphabet);
+                uint8_t b2 = base64_digit_value(src[i + 1], options->alphabet);
+                uint8_t b3 = base64_digit_value(src[i + 2], options->alphabet);
+                uint8_t b4 = base64_digit_value(src[i + 3], options->alphabet);
+                if ((b1 | b2 | b3 | b4) > 0x3F) {
+                    break;
+                }
+                dest[0] = (uint8_t)((b1 << 2) | (b2 >> 4));
+                dest[1] = (uint8_t)((b2 << 4) | (b3 >> 2));
+                dest[2] = (uint8_t)((b3 << 6) | b4);
+            }
+            if (i == input_size) {
+                break;
+            }
+        }
+
+        uint8_t c = src[i++];
+        uint8_t value = base64_digit_value(c, options->alphabet);
+        if (value <= 0x3F) {
+            if (pads != 0) {
+                return BASE64_INVALID_CHARACTER;  // Data after padding
+            }
+            group[count++] = value;
+            if (count == 4) {
+                dest[0] = (uint8_t)((group[0] << 2) | (group[1] >> 4));
+                dest[1] = (uint8_t)((group[1] << 4) | (group[2] >> 2));
+                dest[2] = (uint8_t)((group[2] << 6) | group[3]);
+                dest += 3;
+                count = 0;
+            }
+        } else if (value == BASE64_TERMINATOR) {
+            // Padding completes a group of 2 or 3 characters
+            pads++;
+            if (count < 2 || count + pads > 4) {
+                return BASE64_INVALID_CHARACTER;
+            }
+        } else if (!options->skip_whitespace ||
+                   (c != ' ' && c != '\t' && c != '\r' && c != '\n')) {
+            return BASE64_INVALID_CHARACTER;
+        }
+    }
+
+    // The last group: 2 or 3 characters, padded if required
+    if ((pads != 0 && count + pads != 4) || count == 1 ||
+        (pads == 0 && count != 0 && options->padding)) {
+        return BASE64_INVALID_LENGTH;
+    }
+    if (count >= 2) {
+        *dest++ = (uint8_t)((group[0] << 2) | (group[1] >> 4));
+    }
+    if (count == 3) {
+        *dest++ = (uint8_t)((group[1] << 4) | (group[2] >> 2));
+    }
+
+    *written = (size_t)(dest - start);
+    return BASE64_SUCCESS;
+}
+
+/**
+ * @brief Argument checks shared by base64_encode_ex() and
+ * base64_encode_parallel()
+ */
+static base64_status_t base64_encode_check(const void *input,
+                                           size_t input_size,
+                                           const uint8_t *output,
+                                           size_t output_capacity,
+                                           const size_t *output_size,
+                                           const base64_options_t *options) {
+    if ((!input && input_size != 0) || !output || !output_size ||
+        !base64_options_valid(options)) {
+        return BASE64_INVALID_INPUT;
+    }
+
+    size_t required_size = base64_encoded_size_ex(input_size, options);
+    if (required_size == 0 && input_size != 0) {
+        return BASE64_INVALID_LENGTH;
+    }
+    if (output_capacity < required_size) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
+    return BASE64_SUCCESS;
+}
+
+/**
+ * @brief Argument checks shared by base64_decode_ex() and
+ * base64_decode_parallel()
+ */
+static base64_status_t base64_decode_check(const uint8_t *input,
+                                           size_t input_size,
+                                           const uint8_t *output,
+                                           size_t output_capacity,
+                                           const size_t *output_size,
+                                           const base64_options_t *options) {
+    if ((!input && input_size != 0) || !output || !output_size ||
+        !base64_options_valid(options)) {
+        return BASE64_INVALID_INPUT;
+    }
+    if (output_capacity < base64_decoded_max_size(input_size)) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
+    return BASE64_SUCCESS;
+}
+
+base64_status_t base64_encode_ex(const void *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size,
+                                 const base64_options_t *options) {
+    if (!options) {
+        options = &base64_options_standard;
+    }
+    base64_status_t status = base64_encode_check(
+        input, input_size, output, output_capacity, output_size, options);
+    if (status != BASE64_SUCCESS) {
+        return status;
+    }
+
+    *output_size = base64_encode_raw((const uint8_t *)input, input_size,
+                                     output, options);
+    return BASE64_SUCCESS;
+}
+
+base64_status_t base64_decode_ex(const uint8_t *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size,
+                                 const base64_options_t *options) {
+    if (!options) {
+        options = &base64_options_standard;
+    }
+    base64_status_t status = base64_decode_check(
+        input, input_size, output, output_capacity, output_size, options);
+    if (status != BASE64_SUCCESS) {
+        return status;
+    }
+
+    return base64_decode_format(input, input_size, output, options,
+                                output_size);
+}
+
+/* Pool for large buffers, NULL selects the default pool */
+static thread_pool_t *base64_thread_pool = NULL;
+
+void base64_set_thread_pool(thread_pool_t *pool) { base64_thread_pool = pool; }
+
+thread_pool_t *base64_get_thread_pool(void) {
+    return (base64_thread_pool != NULL) ? base64_thread_pool
+                                        : thread_pool_get_default();
+}
+
+/**
+ * @brief Threads to split an input of the given size across, 1 below the
+ * threshold
+ */
+static size_t base64_parallel_threads(size_t input_size,
+                                      thread_pool_t **pool) {
+    *pool = NULL;
+    if (input_size < BASE64_PARALLEL_THRESHOLD) {
+        return 1;
+    }
+    *pool = base64_get_thread_pool();
+    return thread_pool_get_num_threads(*pool);
+}
+
+/* Contiguous input split into equal segments of whole groups, one per task */
+typedef struct {
+    const uint8_t *in;
+    uint8_t *out;
+    size_t input_size;
+    size_t per_task;  // Multiple of the group (of a line when wrapping)
+    const base64_options_t *options;
+    base64_status_t status[THREAD_POOL_MAX_THREADS];
+    size_t written[THREAD_POOL_MAX_THREADS];
+} base64_job_t;
+
+static void base64_encode_task(void *arg, size_t index) {
+    base64_job_t *job = (base64_job_t *)arg;
+    size_t line_length = job->options->line_length;
+    size_t first = index * job->per_task;
+    if (first >= job->input_size) {
+        return;
+    }
+    size_t count = job->input_size - first;
+    if (count > job->per_task) {
+        count = job->per_task;
+    }
+
+    // Whole lines before the segment, each followed by CRLF
+    size_t offset = (first / 3) * 4;
+    if (line_length != 0) {
+        offset += first / (line_length / 4 * 3) * 2;
+    }
+    uint8_t *dest = job->out + offset;
+    size_t size = base64_encode_raw(job->in + first, count, dest, job->options);
+    if (line_length != 0 && first + count < job->input_size) {
+        dest[size] = '\r';
+        dest[size + 1] = '\n';
+    }
+}
+
+static void base64_decode_task(void *arg, size_t index) {
+    base64_job_t *job = (base64_job_t *)arg;
+    size_t first = index * job->per_task;
+    if (first >= job->input_size) {
+        return;
+    }
+    size_t count = job->input_size - first;
+    if (count > job->per_task) {
+        count = job->per_task;
+    }
+
+    size_t size = 0;
+    base64_status_t status =
+        base64_decode_format(job->in + first, count, job->out + first / 4 * 3,
+                             job->options, &size);
+    if (status == BASE64_SUCCESS && first + count < job->input_size &&
+        size != count / 4 * 3) {
+        status = BASE64_INVALID_CHARACTER;  // Padding before the last segment
+    }
+    job->status[index] = status;
+    job->written[index] = size;
+}
+
+base64_status_t base64_encode_parallel(const void *input, size_t input_size,
+                                       uint8_t *output,
+                                       size_t output_capacity,
+                                       size_t *output_size,
+                                       const base64_options_t *options) {
+    if (!options) {
+        options = &base64_options_standard;
+    }
+    base64_status_t status = base64_encode_check(
+        input, input_size, output, output_capacity, output_size, options);
+    if (status != BASE64_SUCCESS) {
+        return status;
+    }
+
+    thread_pool_t *pool;
+    size_t num_threads = base64_parallel_threads(input_size, &pool);
+    if (num_threads <= 1) {
+        *output_size = base64_encode_raw((const uint8_t *)input, input_size,
+                                         output, options);
+        return BASE64_SUCCESS;
+    }
+
+    size_t unit = options->line_length != 0 ? options->line_length / 4 * 3
+                                            : BASE64_CHUNK_SIZE;
+    size_t per_task = (input_size + num_threads - 1) / num_threads;
+    per_task = (per_task + unit - 1) / unit * unit;
+    base64_job_t job = {
+        .in = (const uint8_t *)input,
+        .out = output,
+        .input_size = input_size,
+        .per_task = per_task,
+        .options = options,
+    };
+    thread_pool_run(pool, base64_encode_task, &job,
+                    (input_size + per_task - 1) / per_task);
+    *output_size = base64_encoded_size_ex(input_size, options);
+    return BASE64_SUCCESS;
+}
+
+base64_status_t base64_decode_parallel(const uint8_t *input, size_t input_size,
+                                       uint8_t *output,
+                                       size_t output_capacity,
+                                       size_t *output_size,
+                                       const base64_options_t *options) {
+    if (!options) {
+        options = &base64_options_standard;
+    }
+    base64_status_t status = base64_decode_check(
+        input, input_size, output, output_capacity, output_size, options);
+    if (status != BASE64_SUCCESS) {
+        return status;
+    }
+
+    thread_pool_t *pool;
+    size_t num_threads = base64_parallel_threads(input_size, &pool);
+    if (num_threads <= 1 || options->skip_whitespace) {
+        return base64_decode_format(input, input_size, output, options,
+                                    output_size);
+    }
+
+    size_t per_task = (input_size + num_threads - 1) / num_threads;
+    per_task = (per_task + 3) / 4 * 4;
+    size_t num_tasks = (input_size + per_task - 1) / per_task;
+    base64_job_t job = {
+        .in = input,
+        .out = output,
+        .input_size = input_size,
+        .per_task = per_task,
+        .options = options,
+    };
+    thread_pool_run(pool, base64_decode_task, &job, num_tasks);
+
+    // The first error in input order, as a single thread would report it
+    for (size_t i = 0; i < num_tasks; i++) {
+        if (job.status[i] != BASE64_SUCCESS) {
+            return job.status[i];
+        }
+    }
+    *output_size = (num_tasks - 1) * per_task / 4 * 3 +
+                   job.written[num_tasks - 1];
+    return BASE64_SUCCESS;
+}
+
+base64_status_t base64_encode_to(const void *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size) {
+    return base64_encode_ex(input, input_size, output, output_capacity,
+                            output_size, &base64_options_standard);
+}
+
+base64_status_t base64_decode_to(const uint8_t *input, size_t input_size,
+                                 uint8_t *output, size_t output_capacity,
+                                 size_t *output_size) {
+    if ((!input && input_size != 0) || !output || !output_size) {
+        return BASE64_INVALID_INPUT;
+    }
+    if (input_size % 4 != 0) {
+        return BASE64_INVALID_LENGTH;
     }
 
-    *dest = '\0';
-    *output_size = dest - converter->buffer;
+    size_t decoded_size = base64_decoded_size(input, input_size);
+    if (output_capacity < decoded_size) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
+
+    return base64_decode_raw(input, input_size, output, output_size);
+}
+
+base64_status_t base64_encode(base64_converter_t *converter, const void *input,
+                              size_t input_size, const uint8_t **output,
+                              size_t *output_size) {
+    // Input validation
+    if (!converter || !input || !output_size || !output ||
+        !converter->buffer) {
+        return BASE64_INVALID_INPUT;
+    }
+
+    // Room for the terminator as well
+    size_t required_size = base64_encoded_size(input_size);
+    if (required_size == 0 && input_size != 0) {
+        return BASE64_INVALID_LENGTH;
+    }
+    if (converter->buffer_size <= required_size) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
+
+    size_t size = base64_encode_raw((const uint8_t *)input, input_size,
+                                    converter->buffer,
+                                    &base64_options_standard);
+    converter->buffer[size] = '\0';
+    converter->bytes_processed = input_size;
+    *output_size = size;
     *output = converter->buffer;
 
     return BASE64_SUCCESS;
@@ -193,66 +792,163 @@ base64_status_t base64_decode(base64_converter_t *converter,
         return BASE64_INVALID_INPUT;
     }
 
-    // Get maximum decoded size and validate input
-    size_t max_decoded_size = base64_get_decoded_size(input_size);
-    if (max_decoded_size == 0) {
-        return BASE64_INVALID_LENGTH;
+    // The converter buffer size stands for the capacity of the output
+    base64_status_t status = base64_decode_to(
+        input, input_size, output, converter->buffer_size, output_size);
+    if (status == BASE64_SUCCESS) {
+        converter->bytes_processed = input_size;
+    }
+    return status;
+}
+
+base64_status_t base64_encode_update(base64_converter_t *converter,
+                                     const void *input, size_t input_size,
+                                     uint8_t *output, size_t output_capacity,
+                                     size_t *output_size) {
+    if (!converter || (!input && input_size != 0) || !output ||
+        !output_size) {
+        return BASE64_INVALID_INPUT;
     }
 
-    // Check if output buffer is large enough
-    if (converter->buffer_size < max_decoded_size) {
+    size_t total = converter->carry_len + input_size;
+    if (total < input_size || total / 3 > SIZE_MAX / 4) {
+        return BASE64_INVALID_LENGTH;
+    }
+    if (output_capacity < (total / 3) * 4) {
         return BASE64_BUFFER_TOO_SMALL;
     }
 
-    // Count padding characters
-    size_t padding = 0;
-    if (input_size > 0) {
-        if (input[input_size - 1] == '=') padding++;
-        if (input[input_size - 2] == '=') padding++;
+    const uint8_t *src = (const uint8_t *)input;
+    size_t rest = input_size;
+    size_t written = 0;
+    if (converter->carry_len > 0) {
+        // Complete the group kept from the previous call
+        size_t take = 3 - converter->carry_len;
+        take = (take < rest) ? take : rest;
+        memcpy(converter->carry + converter->carry_len, src, take);
+        converter->carry_len += take;
+        src += take;
+        rest -= take;
+        if (converter->carry_len == 3) {
+            written = base64_encode_raw(converter->carry, 3, output,
+                                        &base64_options_standard);
+            converter->carry_len = 0;
+        }
     }
 
-    // Calculate actual output size
-    *output_size = (input_size / 4) * 3 - padding;
+    if (converter->carry_len == 0 && rest > 0) {
+        size_t whole = rest - rest % 3;
+        written += base64_encode_raw(src, whole, output + written,
+                                     &base64_options_standard);
+        memcpy(converter->carry, src + whole, rest - whole);
+        converter->carry_len = rest - whole;
+    }
 
-    const uint8_t *src = input;
-    uint8_t *dest = output;
-    size_t chunks = input_size / 4;
+    converter->bytes_processed = input_size;
+    *output_size = written;
+    return BASE64_SUCCESS;
+}
 
-    for (size_t i = 0; i < chunks; i++) {
-        uint8_t b1, b2, b3, b4;
+base64_status_t base64_encode_final(base64_converter_t *converter,
+                                    uint8_t *output, size_t output_capacity,
+                                    size_t *output_size) {
+    if (!converter || !output || !output_size) {
+        return BASE64_INVALID_INPUT;
+    }
+    if (converter->carry_len > 0 && output_capacity < 4) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
 
-        // Convert each character to its 6-bit value
-        b1 = digit_to_bin[src[0]];
-        b2 = digit_to_bin[src[1]];
-        b3 = digit_to_bin[src[2]];
-        b4 = digit_to_bin[src[3]];
+    *output_size = base64_encode_raw(converter->carry, converter->carry_len,
+                                     output, &base64_options_standard);
+    converter->carry_len = 0;
+    converter->padded = false;
+    converter->bytes_processed = 0;
+    return BASE64_SUCCESS;
+}
 
-        // Check for invalid characters
-        if (b1 == BASE64_NOT_DIGIT || b2 == BASE64_NOT_DIGIT ||
-            (b3 == BASE64_NOT_DIGIT && b3 != BASE64_TERMINATOR) ||
-            (b4 == BASE64_NOT_DIGIT && b4 != BASE64_TERMINATOR)) {
-            return BASE64_INVALID_CHARACTER;
-        }
+base64_status_t base64_decode_update(base64_converter_t *converter,
+                                     const uint8_t *input, size_t input_size,
+                                     uint8_t *output, size_t output_capacity,
+                                     size_t *output_size) {
+    if (!converter || (!input && input_size != 0) || !output ||
+        !output_size) {
+        return BASE64_INVALID_INPUT;
+    }
+    if (converter->padded && input_size != 0) {
+        return BASE64_INVALID_CHARACTER;  // Data after the padded group
+    }
 
-        // Handle padding
-        if (src[2] == '=') b3 = 0;
-        if (src[3] == '=') b4 = 0;
+    size_t carry_len = converter->carry_len;
+    size_t total = carry_len + input_size;
+    if (total < input_size) {
+        return BASE64_INVALID_LENGTH;
+    }
+    if (output_capacity < (total / 4) * 3) {
+        return BASE64_BUFFER_TOO_SMALL;
+    }
 
-        // Combine 6-bit values into bytes
-        *dest++ = (b1 << 2) | (b2 >> 4);
-        if (src[2] != '=') {
-            *dest++ = (b2 << 4) | (b3 >> 2);
-            if (src[3] != '=') {
-                *dest++ = (b3 << 6) | b4;
+    // Padding may only end the group it appears in, and that group the stream
+    const uint8_t *pad = memchr(converter->carry, '=', carry_len);
+    size_t pad_pos = pad ? (size_t)(pad - converter->carry) : 0;
+    if (!pad && input_size != 0 &&
+        (pad = memchr(input, '=', input_size)) != NULL) {
+        pad_pos = carry_len + (size_t)(pad - input);
+    }
+    if (pad && total > (pad_pos / 4 + 1) * 4) {
+        return BASE64_INVALID_CHARACTER;
+    }
+
+    size_t written = 0;
+    size_t take = 0;
+    if (carry_len > 0) {
+        // Complete the group kept from the previous call
+        take = 4 - carry_len;
+        take = (take < input_size) ? take : input_size;
+        memcpy(converter->carry + carry_len, input, take);
+        converter->carry_len += take;
+        if (converter->carry_len == 4) {
+            base64_status_t status =
+                base64_decode_raw(converter->carry, 4, output, &written);
+            if (status != BASE64_SUCCESS) {
+                return status;
             }
+            converter->carry_len = 0;
         }
+    }
 
-        src += 4;
+    size_t rest = input_size - take;
+    if (converter->carry_len == 0 && rest > 0) {
+        size_t whole = rest - rest % 4;
+        size_t size = 0;
+        base64_status_t status =
+            base64_decode_raw(input + take, whole, output + written, &size);
+        if (status != BASE64_SUCCESS) {
+            return status;
+        }
+        written += size;
+        memcpy(converter->carry, input + take + whole, rest - whole);
+        converter->carry_len = rest - whole;
     }
 
+    converter->padded |= pad && converter->carry_len == 0;
+    converter->bytes_processed = input_size;
+    *output_size = written;
     return BASE64_SUCCESS;
 }
 
+base64_status_t base64_decode_final(base64_converter_t *converter) {
+    if (!converter) {
+        return BASE64_INVALID_INPUT;
+    }
+
+    bool complete = converter->carry_len == 0;
+    converter->carry_len = 0;
+    converter->padded = false;
+    converter->bytes_processed = 0;
+    return complete ? BASE64_SUCCESS : BASE64_INVALID_LENGTH;
+}
+
 const char *base64_get_error_string(base64_status_t status) {
     switch (status) {
         case BASE64_SUCCESS:
@@ -263,6 +959,8 @@ const char *base64_get_error_string(base64_status_t status) {
             return "Buffer too small";
         case BASE64_INVALID_CHARACTER:
             return "Invalid Base64 character";
+        case BASE64_INVALID_LENGTH:
+            return "Invalid input length";
         default:
             return "Unknown error";
     }
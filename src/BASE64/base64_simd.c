@@ -0,0 +1,538 @@
+/**
+ * @file base64_simd.c
+ * @brief SSSE3 and AVX2 Base64 kernels for x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-04-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "base64_simd.h"
+
+#if BASE64_SIMD_SUPPORTED
+
+#include <cpuid.h>
+#include <immintrin.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#define BASE64_SSSE3_TARGET __attribute__((target("ssse3")))
+#define BASE64_AVX2_TARGET __attribute__((target("avx2")))
+
+static atomic_int base64_ssse3_cpu = -1;  // -1 unknown, 0 no, 1 yes
+static atomic_int base64_avx2_cpu = -1;
+
+bool base64_ssse3_available(void) {
+    int cpu = atomic_load_explicit(&base64_ssse3_cpu, memory_order_relaxed);
+    if (cpu < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        cpu = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+              (ecx & bit_SSSE3) != 0;
+        atomic_store_explicit(&base64_ssse3_cpu, cpu, memory_order_relaxed);
+    }
+    return cpu == 1;
+}
+
+bool base64_avx2_available(void) {
+    int cpu = atomic_load_explicit(&base64_avx2_cpu, memory_order_relaxed);
+    if (cpu < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        cpu = 0;
+        // The OS must save the YMM registers (XCR0 bits 1 and 2)
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+            (ecx & bit_OSXSAVE) != 0 && (ecx & bit_AVX) != 0) {
+            unsigned int xcr0_lo, xcr0_hi;
+            __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+            (void)xcr0_hi;
+            cpu = (xcr0_lo & 0x6) == 0x6 && __get_cpuid_max(0, NULL) >= 7;
+        }
+        if (cpu) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            cpu = (ebx & bit_AVX2) != 0;
+        }
+        atomic_store_explicit(&base64_avx2_cpu, cpu, memory_order_relaxed);
+    }
+    return cpu == 1;
+}
+
+/*
+ * SSSE3
+ */
+
+/* 12 bytes of a lane into 16 indices of 6 bits, one per byte */
+BASE64_SSSE3_TARGET static inline __m128i enc_reshuffle(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3,
+                                           4, 1, 2, 0, 1));
+    // Bits of each 24-bit group moved into the top of their output byte
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+/* Offset from each range of indices to its characters */
+BASE64_SSSE3_TARGET static inline __m128i enc_offsets(
+    const base64_simd_format_t *format) {
+    // 0: a-z, 1-10: 0-9, 11: value 62, 12: value 63, 13: A-Z
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, (char)(format->char62 - 62),
+                         (char)(format->char63 - 63), 'A', 0, 0);
+}
+
+/* Indices to ASCII: offset of the range of each index from a shuffle */
+BASE64_SSSE3_TARGET static inline __m128i enc_translate(__m128i indices,
+                                                        __m128i offsets) {
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+/* 12 bytes (16 read) into 16 characters */
+BASE64_SSSE3_TARGET static inline void enc_block(const uint8_t *src,
+                                                 uint8_t *dst,
+                                                 __m128i offsets) {
+    __m128i in = _mm_loadu_si128((const __m128i *)src);
+    _mm_storeu_si128((__m128i *)dst,
+                     enc_translate(enc_reshuffle(in), offsets));
+}
+
+/*
+ * ASCII to 6-bit values; lanes of *valid holding a character outside the
+ * alphabet are cleared
+ */
+BASE64_SSSE3_TARGET static inline __m128i dec_translate(__m128i in,
+                                                        __m128i *valid,
+                                                        uint8_t char62,
+                                                        uint8_t char63) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), in));
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), in));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+    __m128i c62 = _mm_cmpeq_epi8(in, _mm_set1_epi8((char)char62));
+    __m128i c63 = _mm_cmpeq_epi8(in, _mm_set1_epi8((char)char63));
+
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset,
+                          _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset,
+                          _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(c62, _mm_set1_epi8((char)(62 - char62))));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(c63, _mm_set1_epi8((char)(63 - char63))));
+
+    __m128i in_alphabet = _mm_or_si128(_mm_or_si128(upper, lower),
+                                       _mm_or_si128(digit,
+                                                    _mm_or_si128(c62, c63)));
+    *valid = _mm_and_si128(*valid, in_alphabet);
+    return _mm_add_epi8(in, offset);
+}
+
+/* 16 values of 6 bits into 12 bytes at the start of the lane */
+BASE64_SSSE3_TARGET static inline __m128i dec_pack(__m128i values) {
+    __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                 14, 13, 12, -1, -1, -1, -1));
+}
+
+/* Bit mask of the lanes holding a space, tab, CR or LF */
+BASE64_SSSE3_TARGET static inline unsigned int dec_whitespace(__m128i in) {
+    __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8(' ')),
+                              _mm_cmpeq_epi8(in, _mm_set1_epi8('\t')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi8(in, _mm_set1_epi8('\r')));
+    ws = _mm_or_si128(ws, _mm_cmpeq_epi8(in, _mm_set1_epi8('\n')));
+    return (unsigned int)_mm_movemask_epi8(ws);
+}
+
+BASE64_SSSE3_TARGET size_t base64_ssse3_encode(const uint8_t *src, size_t len,
+                                               uint8_t *dst,
+                                               const base64_simd_format_t
+                                                   *format,
+                                               size_t *written) {
+    const __m128i offsets = enc_offsets(format);
+    size_t line_length = format->line_length;
+    uint8_t *start = dst;
+    size_t done = 0;
+
+    if (line_length != 0) {
+        size_t line_bytes = line_length / 4 * 3;
+        if (line_length % 4 != 0 || line_length < 16) {
+            *written = 0;
+            return 0;
+        }
+        // The last block of a line overlaps the previous one, and reads 4
+        // bytes past the line: at least one more group follows each line
+        for (; len - done >= line_bytes + 4; done += line_bytes) {
+            size_t i = 0;
+            for (; i + 12 <= line_bytes; i += 12) {
+                enc_block(src + done + i, dst + i / 3 * 4, offsets);
+            }
+            if (i < line_bytes) {
+                i = line_bytes - 12;
+                enc_block(src + done + i, dst + i / 3 * 4, offsets);
+            }
+            dst += line_length;
+            *dst++ = '\r';
+            *dst++ = '\n';
+        }
+        *written = (size_t)(dst - start);
+        return done;
+    }
+
+    for (; len - done >= 28; done += 24, dst += 32) {
+        enc_block(src + done, dst, offsets);
+        enc_block(src + done + 12, dst + 16, offsets);
+    }
+    for (; len - done >= 16; done += 12, dst += 16) {
+        enc_block(src + done, dst, offsets);
+    }
+    *written = (size_t)(dst - start);
+    return done;
+}
+
+BASE64_SSSE3_TARGET size_t base64_ssse3_decode(const uint8_t *src, size_t len,
+                                               uint8_t *dst,
+                                               const base64_simd_format_t
+                                                   *format,
+                                               size_t *written) {
+    const __m128i all = _mm_set1_epi8(-1);
+    const uint8_t char62 = format->char62;
+    const uint8_t char63 = format->char63;
+    uint8_t *start = dst;
+    size_t done = 0;
+
+    // The 4 bytes written past a block are covered by the 8 characters left
+    while (len - done >= 16 + 8) {
+        bool two = len - done >= 32 + 8;
+        __m128i valid_a = all, valid_b = all;
+        __m128i in_a = _mm_loadu_si128((const __m128i *)(src + done));
+        __m128i in_b = all;
+        __m128i a = dec_translate(in_a, &valid_a, char62, char63);
+        __m128i b = all;
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(valid_a);
+        if (two) {
+            in_b = _mm_loadu_si128((const __m128i *)(src + done + 16));
+            b = dec_translate(in_b, &valid_b, char62, char63);
+            mask |= (uint32_t)_mm_movemask_epi8(valid_b) << 16;
+        }
+        if (mask == (two ? UINT32_MAX : 0xFFFF)) {
+            _mm_storeu_si128((__m128i *)dst, dec_pack(a));
+            if (two) {
+                _mm_storeu_si128((__m128i *)(dst + 12), dec_pack(b));
+            }
+            done += two ? 32 : 16;
+            dst += two ? 24 : 12;
+            continue;
+        }
+
+        // Keep the groups before the first character outside the alphabet.
+        // Only their bytes are written: past them may lie input still to
+        // be read when decoding in place
+        unsigned int first = (unsigned int)__builtin_ctz(~mask);
+        unsigned int groups = first / 4;
+        if (groups != 0) {
+            uint8_t part[16];
+            if (first >= 16) {
+                _mm_storeu_si128((__m128i *)dst, dec_pack(a));
+                _mm_storeu_si128((__m128i *)part, dec_pack(b));
+                memcpy(dst + 12, part, (groups - 4) * 3);
+            } else {
+                _mm_storeu_si128((__m128i *)part, dec_pack(a));
+                memcpy(dst, part, groups * 3);
+            }
+            done += groups * 4;
+            dst += groups * 3;
+        }
+
+        // Step over whitespace between groups; the rest is for the caller
+        unsigned int run = 0;
+        if (format->skip_whitespace && first % 4 == 0) {
+            uint64_t ws = dec_whitespace(in_a);
+            if (two) {
+                ws |= (uint64_t)dec_whitespace(in_b) << 16;
+            }
+            run = (unsigned int)__builtin_ctzll(~(ws >> first));
+        }
+        if (groups == 0 && run == 0) {
+            break;
+        }
+        done += run;
+    }
+    *written = (size_t)(dst - start);
+    return done;
+}
+
+/*
+ * AVX2: the same steps on two lanes. Shuffles stay within a lane, so each
+ * lane is loaded with its own 12 bytes (encode) and the two 12-byte halves
+ * of a decoded block are joined with a cross-lane permute.
+ */
+
+BASE64_AVX2_TARGET static inline __m256i enc_reshuffle256(__m256i in) {
+    in = _mm256_shuffle_epi8(
+        in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0,
+                            1));
+    __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+BASE64_AVX2_TARGET static inline __m256i enc_translate256(__m256i indices,
+                                                          __m256i offsets) {
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range,
+                            _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+}
+
+/* Lane 0 from src, lane 1 from src + 12 */
+BASE64_AVX2_TARGET static inline __m256i enc_load256(const uint8_t *src) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)src);
+    __m128i hi = _mm_loadu_si128((const __m128i *)(src + 12));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+/* 24 bytes (28 read) into 32 characters */
+BASE64_AVX2_TARGET static inline void enc_block256(const uint8_t *src,
+                                                   uint8_t *dst,
+                                                   __m256i offsets) {
+    __m256i indices = enc_reshuffle256(enc_load256(src));
+    _mm256_storeu_si256((__m256i *)dst, enc_translate256(indices, offsets));
+}
+
+BASE64_AVX2_TARGET static inline __m256i dec_translate256(__m256i in,
+                                                          __m256i *valid,
+                                                          uint8_t char62,
+                                                          uint8_t char63) {
+    __m256i upper =
+        _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in));
+    __m256i lower =
+        _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in));
+    __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+    __m256i c62 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8((char)char62));
+    __m256i c63 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8((char)char63));
+
+    __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(c62, _mm256_set1_epi8((char)(62 - char62))));
+    offset = _mm256_or_si256(
+        offset, _mm256_and_si256(c63, _mm256_set1_epi8((char)(63 - char63))));
+
+    __m256i in_alphabet =
+        _mm256_or_si256(_mm256_or_si256(upper, lower),
+                        _mm256_or_si256(digit, _mm256_or_si256(c62, c63)));
+    *valid = _mm256_and_si256(*valid, in_alphabet);
+    return _mm256_add_epi8(in, offset);
+}
+
+/* 32 values of 6 bits into 24 bytes at the start of the register */
+BASE64_AVX2_TARGET static inline __m256i dec_pack256(__m256i values) {
+    __m256i pairs =
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    words = _mm256_shuffle_epi8(
+        words, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                -1, -1, -1, -1));
+    return _mm256_permutevar8x32_epi32(words,
+                                       _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3,
+                                                         7));
+}
+
+BASE64_AVX2_TARGET static inline uint32_t dec_whitespace256(__m256i in) {
+    __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8(' ')),
+                                 _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\t')));
+    ws = _mm256_or_si256(ws, _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\r')));
+    ws = _mm256_or_si256(ws, _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\n')));
+    return (uint32_t)_mm256_movemask_epi8(ws);
+}
+
+BASE64_AVX2_TARGET size_t base64_avx2_encode(const uint8_t *src, size_t len,
+                                             uint8_t *dst,
+                                             const base64_simd_format_t
+                                                 *format,
+                                             size_t *written) {
+    const __m256i offsets = _mm256_broadcastsi128_si256(enc_offsets(format));
+    size_t line_length = format->line_length;
+    uint8_t *start = dst;
+    size_t done = 0;
+
+    if (line_length != 0) {
+        size_t line_bytes = line_length / 4 * 3;
+        if (line_length < 32) {
+            return base64_ssse3_encode(src, len, dst, format, written);
+        }
+        if (line_length % 4 != 0) {
+            *written = 0;
+            return 0;
+        }
+        for (; len - done >= line_bytes + 4; done += line_bytes) {
+            size_t i = 0;
+            for (; i + 24 <= line_bytes; i += 24) {
+                enc_block256(src + done + i, dst + i / 3 * 4, offsets);
+            }
+            if (i < line_bytes) {
+                i = line_bytes - 24;
+                enc_block256(src + done + i, dst + i / 3 * 4, offsets);
+            }
+            dst += line_length;
+            *dst++ = '\r';
+            *dst++ = '\n';
+        }
+        *written = (size_t)(dst - start);
+        return done;
+    }
+
+    for (; len - done >= 52; done += 48, dst += 64) {
+        enc_block256(src + done, dst, offsets);
+        enc_block256(src + done + 24, dst + 32, offsets);
+    }
+    for (; len - done >= 28; done += 24, dst += 32) {
+        enc_block256(src + done, dst, offsets);
+    }
+    *written = (size_t)(dst - start);
+    return done;
+}
+
+BASE64_AVX2_TARGET size_t base64_avx2_decode(const uint8_t *src, size_t len,
+                                             uint8_t *dst,
+                                             const base64_simd_format_t
+                                                 *format,
+                                             size_t *written) {
+    const __m256i all = _mm256_set1_epi8(-1);
+    const uint8_t char62 = format->char62;
+    const uint8_t char63 = format->char63;
+    uint8_t *start = dst;
+    size_t done = 0;
+
+    // The 8 bytes written past a block are covered by the 16 characters left
+    while (len - done >= 32 + 16) {
+        bool two = len - done >= 64 + 16;
+        __m256i valid_a = all, valid_b = all;
+        __m256i in_a = _mm256_loadu_si256((const __m256i *)(src + done));
+        __m256i in_b = all;
+        __m256i a = dec_translate256(in_a, &valid_a, char62, char63);
+        __m256i b = all;
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(valid_a);
+        if (two) {
+            in_b = _mm256_loadu_si256((const __m256i *)(src + done + 32));
+            b = dec_translate256(in_b, &valid_b, char62, char63);
+            mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(valid_b) << 32;
+        }
+        if (mask == (two ? UINT64_MAX : UINT32_MAX)) {
+            _mm256_storeu_si256((__m256i *)dst, dec_pack256(a));
+            if (two) {
+                _mm256_storeu_si256((__m256i *)(dst + 24), dec_pack256(b));
+            }
+            done += two ? 64 : 32;
+            dst += two ? 48 : 24;
+            continue;
+        }
+
+        // Keep the groups before the first character outside the alphabet
+        // (only their bytes, see base64_ssse3_decode)
+        unsigned int first = (unsigned int)__builtin_ctzll(~mask);
+        unsigned int groups = first / 4;
+        if (groups != 0) {
+            uint8_t part[32];
+            if (first >= 32) {
+                _mm256_storeu_si256((__m256i *)dst, dec_pack256(a));
+                _mm256_storeu_si256((__m256i *)part, dec_pack256(b));
+                memcpy(dst + 24, part, (groups - 8) * 3);
+            } else {
+                _mm256_storeu_si256((__m256i *)part, dec_pack256(a));
+                memcpy(dst, part, groups * 3);
+            }
+            done += groups * 4;
+            dst += groups * 3;
+        }
+
+        // Step over whitespace between groups; the rest is for the caller
+        unsigned int run = 0;
+        if (format->skip_whitespace && first % 4 == 0) {
+            uint64_t ws = dec_whitespace256(in_a);
+            if (two) {
+                ws |= (uint64_t)dec_whitespace256(in_b) << 32;
+            }
+            ws >>= first;
+            run = (ws == UINT64_MAX) ? 64
+                                     : (unsigned int)__builtin_ctzll(~ws);
+        }
+        if (groups == 0 && run == 0) {
+            break;
+        }
+        done += run;
+    }
+    *written = (size_t)(dst - start);
+    return done;
+}
+
+#else
+
+bool base64_ssse3_available(void) { return false; }
+
+bool base64_avx2_available(void) { return false; }
+
+size_t base64_ssse3_encode(const uint8_t *src, size_t len, uint8_t *dst,
+                           const base64_simd_format_t *format,
+                           size_t *written) {
+    (void)src;
+    (void)len;
+    (void)dst;
+    (void)format;
+    *written = 0;
+    return 0;
+}
+
+size_t base64_ssse3_decode(const uint8_t *src, size_t len, uint8_t *dst,
+                           const base64_simd_format_t *format,
+                           size_t *written) {
+    (void)src;
+    (void)len;
+    (void)dst;
+    (void)format;
+    *written = 0;
+    return 0;
+}
+
+size_t base64_avx2_encode(const uint8_t *src, size_t len, uint8_t *dst,
+                          const base64_simd_format_t *format,
+                          size_t *written) {
+    (void)src;
+    (void)len;
+    (void)dst;
+    (void)format;
+    *written = 0;
+    return 0;
+}
+
+size_t base64_avx2_decode(const uint8_t *src, size_t len, uint8_t *dst,
+                          const base64_simd_format_t *format,
+                          size_t *written) {
+    (void)src;
+    (void)len;
+    (void)dst;
+    (void)format;
+    *written = 0;
+    return 0;
+}
+
+#endif
@@ -8,13 +8,20 @@
  * @copyright Copyright (c) 2024
  *
  * This library provides comprehensive CRC calculation functionality supporting
- * multiple standard CRC algorithms including CRC8, CRC16, and CRC32 variants.
+ * multiple standard CRC algorithms including CRC8, CRC16, CRC32 and CRC64
+ * variants.
  * It implements both table-driven and direct calculation methods for optimal
  * performance and memory usage trade-offs.
  */
 
  #include "crc.h"
 
+ #include <inttypes.h>
+ #include <stdatomic.h>
+
+ #include "crc_clmul.h"
+ #include "crc_sse42.h"
+
  /**
   * @brief Inverts bits in a data value of specified length
   * @param data Pointer to the data to invert
@@ -23,7 +30,6 @@
   */
  static uint32_t bit_invert(const void *data, uint8_t bit_length) {
      uint32_t input = 0;
-     uint32_t inverted = 0;
 
      // Validate input parameters
      if (data == NULL ||
@@ -44,14 +50,14 @@
              break;
      }
 
-     // Perform bit inversion
-     for (uint8_t i = 0; i < bit_length; i++) {
-         if ((input & (1UL << i)) != 0) {
-             inverted |= (1UL << (bit_length - 1 - i));
-         }
-     }
+     // Swap adjacent bits, then pairs, nibbles, bytes and half-words
+     input = ((input >> 1) & 0x55555555UL) | ((input & 0x55555555UL) << 1);
+     input = ((input >> 2) & 0x33333333UL) | ((input & 0x33333333UL) << 2);
+     input = ((input >> 4) & 0x0F0F0F0FUL) | ((input & 0x0F0F0F0FUL) << 4);
+     input = ((input >> 8) & 0x00FF00FFUL) | ((input & 0x00FF00FFUL) << 8);
+     input = (input >> 16) | (input << 16);
 
-     return inverted;
+     return input >> (32 - bit_length);
  }
 
  /**
@@ -81,6 +87,400 @@
      return bit_invert(&data, 32);
  }
 
+ /**
+  * @brief Inverts bits in a 64-bit integer
+  * @param data Integer to invert
+  * @return uint64_t Inverted integer
+  */
+ static uint64_t bit_invert_Int64(uint64_t data) {
+     return ((uint64_t)bit_invert_Int32((uint32_t)data) << 32) |
+            bit_invert_Int32((uint32_t)(data >> 32));
+ }
+
+ /**
+  * @brief Inverts the low width bits of a CRC register
+  * @param data Register value
+  * @param width CRC width in bits (8, 16, 32 or 64)
+  * @return uint64_t Inverted value
+  */
+ static uint64_t crc_reflect(uint64_t data, uint8_t width) {
+     switch (width) {
+         case 8:
+             return bit_invert_Byte((uint8_t)data);
+         case 16:
+             return bit_invert_Int16((uint16_t)data);
+         case 32:
+             return bit_invert_Int32((uint32_t)data);
+         default:
+             return bit_invert_Int64(data);
+     }
+ }
+
+ /**
+  * @brief Build states of a set of slicing tables
+  */
+ enum {
+     CRC_TABLES_EMPTY = 0,
+     CRC_TABLES_BUILDING,
+     CRC_TABLES_READY
+ };
+
+ #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
+ #if (CRC32_SLICE_BY != 1) && (CRC32_SLICE_BY != 8) && (CRC32_SLICE_BY != 16)
+ #error "CRC32_SLICE_BY must be 1, 8 or 16"
+ #endif
+
+ /**
+  * @brief Slicing tables of one CRC32 polynomial in one bit order
+  *
+  * table[k][b] is the register contribution of byte b followed by k zero
+  * bytes, so CRC32_SLICE_BY bytes are folded with one lookup each.
+  */
+ typedef struct {
+     atomic_int state;
+     uint32_t table[CRC32_SLICE_BY][256];
+ } crc32_slice_tables_t;
+
+ /**
+  * @brief Polynomials of the CRC32 variants, in cache order
+  */
+ static const uint32_t crc32_slice_polys[] = {
+     0xA833982BUL, 0x814141ABUL, 0x1EDC6F41UL, 0x04C11DB7UL, 0x000000AFUL
+ };
+
+ #define CRC32_SLICE_POLY_COUNT                                               \
+     (sizeof(crc32_slice_polys) / sizeof(crc32_slice_polys[0]))
+
+ /**
+  * @brief Slicing tables per polynomial, normal [0] and reflected [1]
+  */
+ static crc32_slice_tables_t crc32_slice_cache[CRC32_SLICE_POLY_COUNT][2];
+
+ /**
+  * @brief Fills the slicing tables of a polynomial
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @param reflected true for LSB-first tables (reflected input variants)
+  * @param table Tables to fill
+  */
+ static void crc32_slice_build(uint32_t poly, bool reflected,
+                               uint32_t table[][256]) {
+     uint32_t reflected_poly = bit_invert_Int32(poly);
+
+     for (uint32_t b = 0; b < 256; b++) {
+         uint32_t crc;
+         if (reflected) {
+             crc = b;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 1UL) ? (crc >> 1) ^ reflected_poly : (crc >> 1);
+             }
+         } else {
+             crc = b << 24;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 0x80000000UL) ? (crc << 1) ^ poly : (crc << 1);
+             }
+         }
+         table[0][b] = crc;
+     }
+
+     // One more zero byte per table
+     for (size_t k = 1; k < CRC32_SLICE_BY; k++) {
+         for (size_t b = 0; b < 256; b++) {
+             uint32_t prev = table[k - 1][b];
+             table[k][b] = reflected ? (prev >> 8) ^ table[0][prev & 0xFF]
+                                     : (prev << 8) ^ table[0][prev >> 24];
+         }
+     }
+ }
+
+ /**
+  * @brief Gets the slicing tables of a polynomial, building them on first use
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @param reflected true for LSB-first tables
+  * @return Tables, or NULL if unknown or still being built by another thread
+  */
+ static const uint32_t (*crc32_slice_tables(uint32_t poly,
+                                            bool reflected))[256] {
+     for (size_t i = 0; i < CRC32_SLICE_POLY_COUNT; i++) {
+         if (crc32_slice_polys[i] != poly) {
+             continue;
+         }
+         crc32_slice_tables_t *tables = &crc32_slice_cache[i][reflected];
+         int state =
+             atomic_load_explicit(&tables->state, memory_order_acquire);
+         if (state == CRC_TABLES_EMPTY &&
+             atomic_compare_exchange_strong_explicit(
+                 &tables->state, &state, CRC_TABLES_BUILDING,
+                 memory_order_acquire, memory_order_acquire)) {
+             crc32_slice_build(poly, reflected, tables->table);
+             state = CRC_TABLES_READY;
+             atomic_store_explicit(&tables->state, state,
+                                   memory_order_release);
+         }
+         // Callers fall back to the byte loop while another thread builds
+         return (state == CRC_TABLES_READY)
+                    ? (const uint32_t (*)[256])tables->table
+                    : NULL;
+     }
+     return NULL;
+ }
+
+ static inline uint32_t load_le32(const uint8_t *p) {
+     return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+            ((uint32_t)p[3] << 24);
+ }
+
+ static inline uint32_t load_be32(const uint8_t *p) {
+     return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+            ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+ }
+
+ /* Contribution of a 32-bit word followed by k zero bytes */
+ #define CRC32_SLICE_WORD_BE(table, w, k)                                     \
+     ((table)[(k) + 3][(w) >> 24] ^ (table)[(k) + 2][((w) >> 16) & 0xFF] ^    \
+      (table)[(k) + 1][((w) >> 8) & 0xFF] ^ (table)[(k)][(w) & 0xFF])
+ #define CRC32_SLICE_WORD_LE(table, w, k)                                     \
+     ((table)[(k) + 3][(w) & 0xFF] ^ (table)[(k) + 2][((w) >> 8) & 0xFF] ^    \
+      (table)[(k) + 1][((w) >> 16) & 0xFF] ^ (table)[(k)][(w) >> 24])
+
+ /**
+  * @brief Slicing update for variants without input reflection (MSB-first)
+  * @param table Normal slicing tables of the polynomial
+  * @param crc Current register value
+  * @param buf Input data
+  * @param len Input length in bytes
+  * @return uint32_t Updated register value
+  */
+ static uint32_t crc32_slice_normal(const uint32_t table[][256], uint32_t crc,
+                                    const uint8_t *buf, size_t len) {
+ #if CRC32_SLICE_BY > 1
+     while (len >= CRC32_SLICE_BY) {
+         uint32_t w0 = crc ^ load_be32(buf);
+         uint32_t w1 = load_be32(buf + 4);
+ #if CRC32_SLICE_BY == 16
+         uint32_t w2 = load_be32(buf + 8);
+         uint32_t w3 = load_be32(buf + 12);
+         crc = CRC32_SLICE_WORD_BE(table, w0, 12) ^
+               CRC32_SLICE_WORD_BE(table, w1, 8) ^
+               CRC32_SLICE_WORD_BE(table, w2, 4) ^
+               CRC32_SLICE_WORD_BE(table, w3, 0);
+ #else
+         crc = CRC32_SLICE_WORD_BE(table, w0, 4) ^
+               CRC32_SLICE_WORD_BE(table, w1, 0);
+ #endif
+         buf += CRC32_SLICE_BY;
+         len -= CRC32_SLICE_BY;
+     }
+ #endif
+     while (len-- != 0) {
+         crc = (crc << 8) ^ table[0][(crc >> 24) ^ *buf++];
+     }
+     return crc;
+ }
+
+ /**
+  * @brief Slicing update for reflected input variants (LSB-first)
+  * @param table Reflected slicing tables of the polynomial
+  * @param crc Current register value, bit reversed
+  * @param buf Input data
+  * @param len Input length in bytes
+  * @return uint32_t Updated register value, bit reversed
+  */
+ static uint32_t crc32_slice_reflected(const uint32_t table[][256],
+                                       uint32_t crc, const uint8_t *buf,
+                                       size_t len) {
+ #if CRC32_SLICE_BY > 1
+     while (len >= CRC32_SLICE_BY) {
+         uint32_t w0 = crc ^ load_le32(buf);
+         uint32_t w1 = load_le32(buf + 4);
+ #if CRC32_SLICE_BY == 16
+         uint32_t w2 = load_le32(buf + 8);
+         uint32_t w3 = load_le32(buf + 12);
+         crc = CRC32_SLICE_WORD_LE(table, w0, 12) ^
+               CRC32_SLICE_WORD_LE(table, w1, 8) ^
+               CRC32_SLICE_WORD_LE(table, w2, 4) ^
+               CRC32_SLICE_WORD_LE(table, w3, 0);
+ #else
+         crc = CRC32_SLICE_WORD_LE(table, w0, 4) ^
+               CRC32_SLICE_WORD_LE(table, w1, 0);
+ #endif
+         buf += CRC32_SLICE_BY;
+         len -= CRC32_SLICE_BY;
+     }
+ #endif
+     while (len-- != 0) {
+         crc = (crc >> 8) ^ table[0][(crc ^ *buf++) & 0xFF];
+     }
+     return crc;
+ }
+ #endif
+
+ #if defined(CRC64_USE_LOOKUP_TABLE) && (CRC64_USE_LOOKUP_TABLE == 1)
+ #if (CRC64_SLICE_BY != 1) && (CRC64_SLICE_BY != 8)
+ #error "CRC64_SLICE_BY must be 1 or 8"
+ #endif
+
+ /**
+  * @brief Slicing tables of one CRC64 polynomial in one bit order
+  */
+ typedef struct {
+     atomic_int state;
+     uint64_t table[CRC64_SLICE_BY][256];
+ } crc64_slice_tables_t;
+
+ /**
+  * @brief Polynomials of the CRC64 variants, in cache order
+  */
+ static const uint64_t crc64_slice_polys[] = {
+     0x42F0E1EBA9EA3693ULL, 0x000000000000001BULL, 0xAD93D23594C93659ULL
+ };
+
+ #define CRC64_SLICE_POLY_COUNT                                               \
+     (sizeof(crc64_slice_polys) / sizeof(crc64_slice_polys[0]))
+
+ /**
+  * @brief Slicing tables per polynomial, normal [0] and reflected [1]
+  */
+ static crc64_slice_tables_t crc64_slice_cache[CRC64_SLICE_POLY_COUNT][2];
+
+ /**
+  * @brief Fills the slicing tables of a CRC64 polynomial
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @param reflected true for LSB-first tables (reflected input variants)
+  * @param table Tables to fill
+  */
+ static void crc64_slice_build(uint64_t poly, bool reflected,
+                               uint64_t table[][256]) {
+     uint64_t reflected_poly = bit_invert_Int64(poly);
+
+     for (uint32_t b = 0; b < 256; b++) {
+         uint64_t crc;
+         if (reflected) {
+             crc = b;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 1) ? (crc >> 1) ^ reflected_poly : (crc >> 1);
+             }
+         } else {
+             crc = (uint64_t)b << 56;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc >> 63) ? (crc << 1) ^ poly : (crc << 1);
+             }
+         }
+         table[0][b] = crc;
+     }
+
+     // One more zero byte per table
+     for (size_t k = 1; k < CRC64_SLICE_BY; k++) {
+         for (size_t b = 0; b < 256; b++) {
+             uint64_t prev = table[k - 1][b];
+             table[k][b] = reflected ? (prev >> 8) ^ table[0][prev & 0xFF]
+                                     : (prev << 8) ^ table[0][prev >> 56];
+         }
+     }
+ }
+
+ /**
+  * @brief Gets the CRC64 slicing tables of a polynomial, building them on
+  * first use
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @param reflected true for LSB-first tables
+  * @return Tables, or NULL if unknown or still being built by another thread
+  */
+ static const uint64_t (*crc64_slice_tables(uint64_t poly,
+                                            bool reflected))[256] {
+     for (size_t i = 0; i < CRC64_SLICE_POLY_COUNT; i++) {
+         if (crc64_slice_polys[i] != poly) {
+             continue;
+         }
+         crc64_slice_tables_t *tables = &crc64_slice_cache[i][reflected];
+         int state =
+             atomic_load_explicit(&tables->state, memory_order_acquire);
+         if (state == CRC_TABLES_EMPTY &&
+             atomic_compare_exchange_strong_explicit(
+                 &tables->state, &state, CRC_TABLES_BUILDING,
+                 memory_order_acquire, memory_order_acquire)) {
+             crc64_slice_build(poly, reflected, tables->table);
+             state = CRC_TABLES_READY;
+             atomic_store_explicit(&tables->state, state,
+                                   memory_order_release);
+         }
+         // Callers fall back to the bitwise loop while another thread builds
+         return (state == CRC_TABLES_READY)
+                    ? (const uint64_t (*)[256])tables->table
+                    : NULL;
+     }
+     return NULL;
+ }
+
+ static inline uint64_t load_le64(const uint8_t *p) {
+     return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+            ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+            ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+            ((uint64_t)p[7] << 56);
+ }
+
+ static inline uint64_t load_be64(const uint8_t *p) {
+     return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+            ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+            ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+            ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+ }
+
+ /**
+  * @brief CRC64 slicing update for variants without input reflection
+  * @param table Normal slicing tables of the polynomial
+  * @param crc Current register value
+  * @param buf Input data
+  * @param len Input length in bytes
+  * @return uint64_t Updated register value
+  */
+ static uint64_t crc64_slice_normal(const uint64_t table[][256], uint64_t crc,
+                                    const uint8_t *buf, size_t len) {
+ #if CRC64_SLICE_BY == 8
+     while (len >= 8) {
+         crc ^= load_be64(buf);
+         crc = table[7][crc >> 56] ^ table[6][(crc >> 48) & 0xFF] ^
+               table[5][(crc >> 40) & 0xFF] ^ table[4][(crc >> 32) & 0xFF] ^
+               table[3][(crc >> 24) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^
+               table[1][(crc >> 8) & 0xFF] ^ table[0][crc & 0xFF];
+         buf += 8;
+         len -= 8;
+     }
+ #endif
+     while (len-- != 0) {
+         crc = (crc << 8) ^ table[0][(crc >> 56) ^ *buf++];
+     }
+     return crc;
+ }
+
+ /**
+  * @brief CRC64 slicing update for reflected input variants
+  * @param table Reflected slicing tables of the polynomial
+  * @param crc Current register value, bit reversed
+  * @param buf Input data
+  * @param len Input length in bytes
+  * @return uint64_t Updated register value, bit reversed
+  */
+ static uint64_t crc64_slice_reflected(const uint64_t table[][256],
+                                       uint64_t crc, const uint8_t *buf,
+                                       size_t len) {
+ #if CRC64_SLICE_BY == 8
+     while (len >= 8) {
+         crc ^= load_le64(buf);
+         crc = table[7][crc & 0xFF] ^ table[6][(crc >> 8) & 0xFF] ^
+               table[5][(crc >> 16) & 0xFF] ^ table[4][(crc >> 24) & 0xFF] ^
+               table[3][(crc >> 32) & 0xFF] ^ table[2][(crc >> 40) & 0xFF] ^
+               table[1][(crc >> 48) & 0xFF] ^ table[0][crc >> 56];
+         buf += 8;
+         len -= 8;
+     }
+ #endif
+     while (len-- != 0) {
+         crc = (crc >> 8) ^ table[0][(crc ^ *buf++) & 0xFF];
+     }
+     return crc;
+ }
+ #endif
+
  #if defined(CRC_USE_IMPLEMENTATION_NAMES) && (CRC_USE_IMPLEMENTATION_NAMES == 1)
  /**
   * @brief Array containing all CRC implementation names
@@ -102,7 +502,10 @@
 
      // CRC32 implementations
      "CRC32_D", "CRC32_Q", "CRC32_C", "CRC32_ISO", "CRC32_BZIP2", "CRC32_MPEG_2",
-     "CRC32_POSIX", "CRC32_JAMCRC", "CRC32_XFER"
+     "CRC32_POSIX", "CRC32_JAMCRC", "CRC32_XFER",
+
+     // CRC64 implementations
+     "CRC64_ECMA_182", "CRC64_GO_ISO", "CRC64_XZ", "CRC64_NVME"
 
      // Add more implementations here if needed
  };
@@ -245,6 +648,26 @@
      return retVal;
  }
 
+ uint64_t CRC64_getPoly(crc_t crc_type) {
+     uint64_t retVal;
+     switch (crc_type) {
+         case CRC64_ECMA_182:
+         case CRC64_XZ:
+             retVal = 0x42F0E1EBA9EA3693ULL;
+             break;
+         case CRC64_GO_ISO:
+             retVal = 0x000000000000001BULL;
+             break;
+         case CRC64_NVME:
+             retVal = 0xAD93D23594C93659ULL;
+             break;
+         default:
+             retVal = 0ULL;
+             break;  // Caso sin sentido
+     }
+     return retVal;
+ }
+
  uint8_t CRC8_getSeed(crc_t crc_type) {
      uint8_t retVal;
      switch (crc_type) {
@@ -315,6 +738,19 @@
      return retVal;
  }
 
+ uint64_t CRC64_getSeed(crc_t crc_type) {
+     uint64_t retVal;
+     switch (crc_type) {
+         case CRC64_ECMA_182:
+             retVal = 0ULL;
+             break;
+         default:
+             retVal = 0xFFFFFFFFFFFFFFFFULL;
+             break;  // Rest of cases
+     }
+     return retVal;
+ }
+
  bool CRC_getInputReflected(crc_t crc_type) {
      bool retVal;
      switch (crc_type) {
@@ -350,6 +786,8 @@
          case CRC32_XFER:
          case CRC32_BZIP2:
          case CRC32_POSIX:
+         // CRC64
+         case CRC64_ECMA_182:
              retVal = false;
              break;
          default:
@@ -395,6 +833,8 @@
          case CRC32_XFER:
          case CRC32_BZIP2:
          case CRC32_POSIX:
+         // CRC64
+         case CRC64_ECMA_182:
              retVal = false;
              break;
          default:
@@ -471,35 +911,81 @@
      return retVal;
  }
 
- crc_error_t CRC8_Calculate(const void *data, size_t data_len, crc_t crc_type, uint8_t *result){
-     // Validate input parameters
-     if (data == NULL || result == NULL) {
-         CRC_ERROR_SIMPLE("CRC8: NULL data pointer");
-         return CRC_ERROR_NULL_DATA;
-     }
-
-     // Validate CRC type
-     if (crc_type > CRC8_LTE || crc_type < CRC8_CCITT) {
-         CRC_ERROR("CRC8: Invalid CRC type: %u", crc_type);
-         return CRC_ERROR_INVALID_TYPE;
+ uint64_t CRC64_getFinalXOR(crc_t crc_type) {
+     uint64_t retVal;
+     switch (crc_type) {
+         case CRC64_GO_ISO:
+         case CRC64_XZ:
+         case CRC64_NVME:
+             retVal = 0xFFFFFFFFFFFFFFFFULL;
+             break;
+         default:
+             retVal = 0ULL;
+             break;  // Posibles casos restantes...
      }
+     return retVal;
+ }
 
-     // Get polynomial
-     uint8_t poly = CRC8_getPoly(crc_type);
-     if (poly == 0) {
-         CRC_ERROR_SIMPLE("CRC8: Invalid polynomial");
-         return CRC_ERROR_INVALID_POLYNOMIAL;
+ /**
+  * @brief Byte-wise CRC8 update
+  *
+  * Reflected input variants run LSB-first on a bit reversed register, so no
+  * input byte is ever reversed.
+  *
+  * @param crc Current register value, bit reversed for reflected input
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @param poly Generator polynomial in normal notation
+  * @param p_table Lookup table in the bit order of the input, or NULL
+  * @param input_reflected true for reflected input
+  * @return uint8_t Updated register value
+  */
+ static uint8_t crc8_update(uint8_t crc, const uint8_t *buf, size_t data_len,
+                            uint8_t poly, const uint8_t *p_table,
+                            bool input_reflected) {
+     const uint8_t *_buf = buf;
+     if (p_table != NULL) {
+         // A one byte register steps the same way in both bit orders
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC8: Processing byte: 0x%02X", b);
+             crc = p_table[b ^ crc];
+             CRC_TRACE("CRC8: Lookup result: 0x%02X", crc);
+         }
+     } else if (input_reflected) {
+         uint8_t reflected_poly = bit_invert_Byte(poly);
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC8: Processing byte: 0x%02X", b);
+             crc = crc ^ b;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 0x01) ? (uint8_t)((crc >> 1) ^ reflected_poly)
+                                    : (uint8_t)(crc >> 1);
+             }
+         }
+     } else {
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC8: Processing byte: 0x%02X", b);
+             crc = crc ^ b;
+             CRC_TRACE("CRC8: After XOR with input: 0x%02X", crc);
+             for (uint8_t i = 0; i != 8; i++){
+                 crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ poly) : (uint8_t)(crc << 1);
+                 CRC_TRACE("CRC8: Bit %d: MSB=%d, CRC=0x%02X", i, (crc & 0x80) ? 1 : 0, crc);
+             }
+         }
      }
-     CRC_INFO_SIMPLE("CRC8: Starting calculation");
-     CRC_DEBUG("CRC8: Using polynomial: 0x%02X", poly);
-
-     uint8_t crc = CRC8_getSeed(crc_type);
-     CRC_DEBUG("CRC8: Initial seed: 0x%02X", crc);
+     return crc;
+ }
 
- #if defined(CRC8_USE_LOOKUP_TABLE) && (CRC8_USE_LOOKUP_TABLE == 1)
+ /**
+  * @brief Selects the CRC8 lookup table of a polynomial
+  * @param poly Generator polynomial
+  * @return const uint8_t* Lookup table, or NULL if there is none
+  */
+ static const uint8_t *crc8_table(uint8_t poly) {
      const uint8_t *p_table = NULL;
-     CRC_DEBUG_SIMPLE("CRC8: Using lookup table method");
-     // Select lookup table based on polynomial
+ #if defined(CRC8_USE_LOOKUP_TABLE) && (CRC8_USE_LOOKUP_TABLE == 1)
      switch (poly) {
  #ifdef CRC8_0x07_LOOKUP_TABLE
          case 0x07:
@@ -547,99 +1033,79 @@
              break;
  #endif
          default:
-             return CRC_ERROR_LOOKUP_TABLE;
+             break;
      }
+ #else
+     (void)poly;
+ #endif
+     return p_table;
+ }
 
  #if defined(CRC8_USE_LOOKUP_TABLE) && (CRC8_USE_LOOKUP_TABLE == 1)
-     if (p_table == NULL) {
-         CRC_ERROR_SIMPLE("CRC8: Lookup table not found");
-         return CRC_ERROR_LOOKUP_TABLE;
-     }
- #endif
- #else
-     CRC_WARN("CRC8: Using direct calculation method, lookup table not used");
- #endif
-     if (data_len > 0) {
-         uint8_t *_buf = (uint8_t *)data;
-         bool input_reflected = CRC_getInputReflected(crc_type);
-         bool output_reflected = CRC_getOutputReflected(crc_type);
-         CRC_DEBUG("CRC8: Input reflection: %s", input_reflected ? "yes" : "no");
-         CRC_DEBUG("CRC8: Output reflection: %s", output_reflected ? "yes" : "no");
-         CRC_DEBUG("CRC8: Processing %zu bytes", data_len);
-         while (data_len-- != 0) {
-             uint8_t b = *_buf++;
-             CRC_TRACE("CRC8: Processing byte: 0x%02X", b);
-             b = input_reflected ? bit_invert_Byte(b) : b;
-             if (input_reflected) {
-                 CRC_TRACE("CRC8: After input reflection: 0x%02X", b);
-             }
-     #if !defined(CRC8_USE_LOOKUP_TABLE) || (CRC8_USE_LOOKUP_TABLE != 1)
-             crc = crc ^ b;
-             CRC_TRACE("CRC8: After XOR with input: 0x%02X", crc);
-             for (uint8_t i = 0; i != 8; i++){
-                 crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ poly) : (uint8_t)(crc << 1);
-                 CRC_TRACE("CRC8: Bit %d: MSB=%d, CRC=0x%02X", i, (crc & 0x80) ? 1 : 0, crc);
-             }
-     #else
-         uint8_t old_crc = crc;
-         crc = p_table[b ^ crc];
-         CRC_TRACE("CRC8: Lookup result: 0x%02X -> 0x%02X", old_crc, crc);
-     #endif
-         }
-         if (output_reflected) {
-             uint8_t pre_reflect = crc;
-             crc = bit_invert_Byte(crc);
-             CRC_TRACE("CRC8: After output reflection: 0x%02X -> 0x%02X", pre_reflect, crc);
-         }
-     } else{
-         CRC_WARN("Input data length is zero");
-     }
+ /**
+  * @brief LSB-first lookup table of one CRC8 polynomial
+  */
+ typedef struct {
+     atomic_int state;
+     uint8_t table[256];
+ } crc8_reflected_table_t;
 
-     uint8_t final_xor = CRC8_getFinalXOR(crc_type);
-     CRC_DEBUG("CRC8: Final XOR value: 0x%02X", final_xor);
+ /**
+  * @brief Polynomials of the CRC8 variants, in cache order
+  */
+ static const uint8_t crc8_table_polys[] = {
+     0x07, 0x1D, 0x31, 0x39, 0x9B, 0xD5, 0x2F, 0xA7, 0x49
+ };
 
-     *result = crc ^ final_xor;
-     CRC_INFO("CRC8 result: 0x%02X", *result);
+ #define CRC8_TABLE_POLY_COUNT                                                \
+     (sizeof(crc8_table_polys) / sizeof(crc8_table_polys[0]))
 
-     return CRC_SUCCESS;
- }
+ static crc8_reflected_table_t crc8_reflected_cache[CRC8_TABLE_POLY_COUNT];
 
- uint8_t CRC8(const void *data, size_t data_len, crc_t crc_type) {
-     uint8_t result = 0;
-     if (CRC8_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
-         return 0; // Return 0 on error
+ /**
+  * @brief Gets the LSB-first table of a polynomial, building it on first use
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @return const uint8_t* Lookup table, or NULL if unknown or still being
+  * built by another thread
+  */
+ static const uint8_t *crc8_reflected_table(uint8_t poly) {
+     for (size_t i = 0; i < CRC8_TABLE_POLY_COUNT; i++) {
+         if (crc8_table_polys[i] != poly) {
+             continue;
+         }
+         crc8_reflected_table_t *table = &crc8_reflected_cache[i];
+         int state = atomic_load_explicit(&table->state, memory_order_acquire);
+         if (state == CRC_TABLES_EMPTY &&
+             atomic_compare_exchange_strong_explicit(
+                 &table->state, &state, CRC_TABLES_BUILDING,
+                 memory_order_acquire, memory_order_acquire)) {
+             uint8_t reflected_poly = bit_invert_Byte(poly);
+             for (uint32_t b = 0; b < 256; b++) {
+                 uint8_t crc = (uint8_t)b;
+                 for (uint8_t k = 0; k != 8; k++) {
+                     crc = (crc & 0x01) ? (uint8_t)((crc >> 1) ^ reflected_poly)
+                                        : (uint8_t)(crc >> 1);
+                 }
+                 table->table[b] = crc;
+             }
+             state = CRC_TABLES_READY;
+             atomic_store_explicit(&table->state, state, memory_order_release);
+         }
+         // Callers run bit by bit while another thread builds
+         return (state == CRC_TABLES_READY) ? table->table : NULL;
      }
-     return result;
+     return NULL;
  }
+ #endif
 
- crc_error_t CRC16_Calculate(const void *data, size_t data_len, crc_t crc_type, uint16_t *result) {
-     // Validate input parameters
-     if (data == NULL || result == NULL) {
-         CRC_ERROR_SIMPLE("CRC16: NULL data pointer");
-         return CRC_ERROR_NULL_DATA;
-     }
-
-     // Validate CRC type
-     if (crc_type > CRC16_CDMA2000 || crc_type < CRC16_XMODEM) {
-         CRC_ERROR("CRC16: Invalid CRC type: %u", crc_type);
-         return CRC_ERROR_INVALID_TYPE;
-     }
-
-     // Get polynomial
-     uint16_t poly = CRC16_getPoly(crc_type);
-     if (poly == 0) {
-         CRC_ERROR_SIMPLE("CRC16: Invalid polynomial");
-         return CRC_ERROR_INVALID_POLYNOMIAL;
-     }
-     CRC_DEBUG("CRC16: Using polynomial: 0x%04X", poly);
-     CRC_INFO_SIMPLE("CRC16: Starting calculation");
-     uint16_t crc = CRC16_getSeed(crc_type);
-     CRC_DEBUG("CRC16: Initial seed: 0x%04X", crc);
-
- #if defined(CRC16_USE_LOOKUP_TABLE) && (CRC16_USE_LOOKUP_TABLE == 1)
+ /**
+  * @brief Selects the CRC16 lookup table of a polynomial
+  * @param poly Generator polynomial
+  * @return const uint16_t* Lookup table, or NULL if there is none
+  */
+ static const uint16_t *crc16_table(uint16_t poly) {
      const uint16_t *p_table = NULL;
-     CRC_DEBUG_SIMPLE("CRC16: Using lookup table method");
-     // Select lookup table based on polynomial
+ #if defined(CRC16_USE_LOOKUP_TABLE) && (CRC16_USE_LOOKUP_TABLE == 1)
      switch (poly) {
  #ifdef CRC16_0x1021_LOOKUP_TABLE
          case 0x1021:
@@ -677,99 +1143,79 @@
              break;
  #endif
          default:
-             return CRC_ERROR_LOOKUP_TABLE;
-     }
-
- #if defined(CRC16_USE_LOOKUP_TABLE) && (CRC16_USE_LOOKUP_TABLE == 1)
-     if (p_table == NULL) {
-         CRC_ERROR_SIMPLE("CRC16: Lookup table not found");
-         return CRC_ERROR_LOOKUP_TABLE;
+             break;
      }
-     #else
-     CRC_WARN("CRC16: Using direct calculation method, lookup table not used");
-     #endif
+ #else
+     (void)poly;
  #endif
-     if (data_len > 0) {
-         uint8_t *_buf = (uint8_t *)data;
-         bool input_reflected = CRC_getInputReflected(crc_type);
-         bool output_reflected = CRC_getOutputReflected(crc_type);
-         CRC_DEBUG("CRC16: Input reflection: %s", input_reflected ? "yes" : "no");
-         CRC_DEBUG("CRC16: Output reflection: %s", output_reflected ? "yes" : "no");
-
-         CRC_DEBUG("CRC16: Processing %zu bytes", data_len);
-         while (data_len-- != 0) {
-             uint8_t b = *_buf++;
-             CRC_TRACE("CRC16: Processing byte: 0x%02X", b);
-             b = input_reflected ? bit_invert_Byte(b) : b;
-             if (input_reflected) {
-                 CRC_TRACE("CRC16: After input reflection: 0x%02X", b);
-             }
-     #if !defined(CRC16_USE_LOOKUP_TABLE) || (CRC16_USE_LOOKUP_TABLE != 1)
-             crc = crc ^ (uint16_t)((uint16_t)b << 8);
-             CRC_TRACE("CRC16: After XOR with input: 0x%04X", crc);
-             for (uint8_t i = 0; i != 8; i++) {
-                 crc = (crc & 0x8000) ? (crc << 1) ^ poly : (crc << 1);
-                 CRC_TRACE("CRC16: Bit %d: MSB=%d, CRC=0x%04X", i, (crc & 0x8000) ? 1 : 0, crc);
-             }
-     #else
-         uint16_t old_crc = crc;
-         crc = (crc << 8) ^ p_table[(crc >> 8) ^ b];
-         CRC_TRACE("CRC16: Lookup result: 0x%04X -> 0x%04X", old_crc, crc);
-     #endif
-         }
+     return p_table;
+ }
 
-         if (output_reflected) {
-             uint16_t pre_reflect = crc;
-             crc = bit_invert_Int16(crc);
-             CRC_TRACE("CRC16: After output reflection: 0x%04X -> 0x%04X", pre_reflect, crc);
-         }
-     } else {
-         CRC_WARN("Input data length is zero");
-     }
+ #if defined(CRC16_USE_LOOKUP_TABLE) && (CRC16_USE_LOOKUP_TABLE == 1)
+ /**
+  * @brief LSB-first lookup table of one CRC16 polynomial
+  */
+ typedef struct {
+     atomic_int state;
+     uint16_t table[256];
+ } crc16_reflected_table_t;
 
-     uint16_t final_xor = CRC16_getFinalXOR(crc_type);
-     CRC_DEBUG("CRC16: Final XOR value: 0x%04X", final_xor);
+ /**
+  * @brief Polynomials of the CRC16 variants, in cache order
+  */
+ static const uint16_t crc16_table_polys[] = {
+     0x1021, 0x8005, 0x0589, 0x3D65, 0x8BB7, 0xA097, 0xC867
+ };
 
-     *result = crc ^ final_xor;
-     CRC_INFO("CRC16 result: 0x%04X", *result);
+ #define CRC16_TABLE_POLY_COUNT                                               \
+     (sizeof(crc16_table_polys) / sizeof(crc16_table_polys[0]))
 
-     return CRC_SUCCESS;
- }
+ static crc16_reflected_table_t crc16_reflected_cache[CRC16_TABLE_POLY_COUNT];
 
- uint16_t CRC16(const void *data, size_t data_len, crc_t crc_type) {
-     uint16_t result = 0;
-     if (CRC16_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
-         return 0; // Return 0 on error
+ /**
+  * @brief Gets the LSB-first table of a polynomial, building it on first use
+  * @param poly Polynomial in normal (MSB-first) notation
+  * @return const uint16_t* Lookup table, or NULL if unknown or still being
+  * built by another thread
+  */
+ static const uint16_t *crc16_reflected_table(uint16_t poly) {
+     for (size_t i = 0; i < CRC16_TABLE_POLY_COUNT; i++) {
+         if (crc16_table_polys[i] != poly) {
+             continue;
+         }
+         crc16_reflected_table_t *table = &crc16_reflected_cache[i];
+         int state = atomic_load_explicit(&table->state, memory_order_acquire);
+         if (state == CRC_TABLES_EMPTY &&
+             atomic_compare_exchange_strong_explicit(
+                 &table->state, &state, CRC_TABLES_BUILDING,
+                 memory_order_acquire, memory_order_acquire)) {
+             uint16_t reflected_poly = bit_invert_Int16(poly);
+             for (uint32_t b = 0; b < 256; b++) {
+                 uint16_t crc = (uint16_t)b;
+                 for (uint8_t k = 0; k != 8; k++) {
+                     crc = (crc & 0x0001) ? (crc >> 1) ^ reflected_poly
+                                          : (crc >> 1);
+                 }
+                 table->table[b] = crc;
+             }
+             state = CRC_TABLES_READY;
+             atomic_store_explicit(&table->state, state, memory_order_release);
+         }
+         // Callers run bit by bit while another thread builds
+         return (state == CRC_TABLES_READY) ? table->table : NULL;
      }
-     return result;
+     return NULL;
  }
+ #endif
 
- crc_error_t CRC32_Calculate(const void *data, size_t data_len, crc_t crc_type, uint32_t *result) {
-     // Validate input parameters
-     if (data == NULL || result == NULL) {
-         CRC_ERROR_SIMPLE("CRC32: NULL data pointer");
-         return CRC_ERROR_NULL_DATA;
-     }
-
-     // Validate CRC type
-     if (crc_type > CRC32_XFER || crc_type < CRC32_D) {
-         CRC_ERROR("CRC32: Invalid CRC type: %u", crc_type);
-         return CRC_ERROR_INVALID_TYPE;
-     }
-
-     // Get polynomial
-     uint32_t poly = CRC32_getPoly(crc_type);
-     if (poly == 0) {
-         CRC_ERROR_SIMPLE("CRC32: Invalid polynomial");
-         return CRC_ERROR_INVALID_POLYNOMIAL;
-     }
-     CRC_DEBUG("CRC32: Using polynomial: 0x%08lX", poly);
-     CRC_INFO_SIMPLE("CRC32: Starting calculation");
-     uint32_t crc = CRC32_getSeed(crc_type);
-
- #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
+ /**
+  * @brief Selects the CRC32 lookup table of a polynomial
+  * @param poly Generator polynomial
+  * @return const uint32_t* Lookup table, or NULL if there is none
+  */
+ static const uint32_t *crc32_table(uint32_t poly) {
      const uint32_t *p_table = NULL;
-     CRC_DEBUG("CRC32: Using lookup table method");
+ #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
      switch (poly) {
  #ifdef CRC32_0xA833982B_LOOKUP_TABLE
          case 0xA833982BUL:
@@ -797,61 +1243,571 @@
              break;
  #endif
          default:
-             return CRC_ERROR_LOOKUP_TABLE;
+             break;
+     }
+ #else
+     (void)poly;
+ #endif
+     return p_table;
+ }
+
+
+ /**
+  * @brief Byte-wise CRC16 update
+  *
+  * Reflected input variants run LSB-first on a bit reversed register, so no
+  * input byte is ever reversed.
+  *
+  * @param crc Current register value, bit reversed for reflected input
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @param poly Generator polynomial in normal notation
+  * @param p_table Lookup table in the bit order of the input, or NULL
+  * @param input_reflected true for reflected input
+  * @return uint16_t Updated register value
+  */
+ static uint16_t crc16_update(uint16_t crc, const uint8_t *buf,
+                              size_t data_len, uint16_t poly,
+                              const uint16_t *p_table, bool input_reflected) {
+     const uint8_t *_buf = buf;
+     if (p_table != NULL && input_reflected) {
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC16: Processing byte: 0x%02X", b);
+             crc = (crc >> 8) ^ p_table[(uint8_t)(crc ^ b)];
+             CRC_TRACE("CRC16: Lookup result: 0x%04X", crc);
+         }
+     } else if (p_table != NULL) {
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC16: Processing byte: 0x%02X", b);
+             crc = (crc << 8) ^ p_table[(crc >> 8) ^ b];
+             CRC_TRACE("CRC16: Lookup result: 0x%04X", crc);
+         }
+     } else if (input_reflected) {
+         uint16_t reflected_poly = bit_invert_Int16(poly);
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC16: Processing byte: 0x%02X", b);
+             crc = crc ^ b;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 0x0001) ? (crc >> 1) ^ reflected_poly : (crc >> 1);
+             }
+         }
+     } else {
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC16: Processing byte: 0x%02X", b);
+             crc = crc ^ (uint16_t)((uint16_t)b << 8);
+             CRC_TRACE("CRC16: After XOR with input: 0x%04X", crc);
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 0x8000) ? (crc << 1) ^ poly : (crc << 1);
+                 CRC_TRACE("CRC16: Bit %d: MSB=%d, CRC=0x%04X", i, (crc & 0x8000) ? 1 : 0, crc);
+             }
+         }
      }
+     return crc;
+ }
 
+ /**
+  * @brief CRC32 update with the slicing tables, or byte-wise without them
+  *
+  * Reflected input variants run LSB-first on a bit reversed register, so no
+  * input byte is ever reversed.
+  *
+  * @param crc Current register value, bit reversed for reflected input
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @param poly Generator polynomial in normal notation
+  * @param p_table MSB-first lookup table of the polynomial, or NULL
+  * @param slices Slicing tables in the bit order of the input, or NULL
+  * @param input_reflected true for reflected input
+  * @return uint32_t Updated register value
+  */
+ static uint32_t crc32_update(uint32_t crc, const uint8_t *buf,
+                              size_t data_len, uint32_t poly,
+                              const uint32_t *p_table,
+                              const uint32_t (*slices)[256],
+                              bool input_reflected) {
+     const uint8_t *_buf = buf;
  #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
-     if (p_table == NULL) {
-         CRC_ERROR_SIMPLE("CRC32: Lookup table not found");
-         return CRC_ERROR_LOOKUP_TABLE;
+     if (slices != NULL) {
+         return input_reflected
+                    ? crc32_slice_reflected(slices, crc, _buf, data_len)
+                    : crc32_slice_normal(slices, crc, _buf, data_len);
      }
- #endif
  #else
-     CRC_WARN("CRC32: Using direct calculation method, lookup table not used");
- #endif
-     if (data_len > 0) {
-         uint8_t *_buf = (uint8_t *)data;
-         bool input_reflected = CRC_getInputReflected(crc_type);
-         bool output_reflected = CRC_getOutputReflected(crc_type);
-         CRC_DEBUG("CRC32: Input reflection: %s", input_reflected ? "yes" : "no");
-         CRC_DEBUG("CRC32: Output reflection: %s", output_reflected ? "yes" : "no");
-         CRC_DEBUG("CRC32: Processing %zu bytes", data_len);
+     (void)slices;
+ #endif
+     if (input_reflected) {
+         // Without tables, or while another thread builds them
+         uint32_t reflected_poly = bit_invert_Int32(poly);
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC32: Processing byte: 0x%02X", b);
+             crc = crc ^ b;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 1UL) ? (crc >> 1) ^ reflected_poly : (crc >> 1);
+             }
+         }
+     } else if (p_table != NULL) {
+         while (data_len-- != 0) {
+             uint8_t b = *_buf++;
+             CRC_TRACE("CRC32: Processing byte: 0x%02X", b);
+             crc = (crc << 8) ^ p_table[(uint8_t)(crc >> 24) ^ b];
+             CRC_TRACE("CRC32: Lookup result: 0x%08lX", crc);
+         }
+     } else {
          while (data_len-- != 0) {
              uint8_t b = *_buf++;
              CRC_TRACE("CRC32: Processing byte: 0x%02X", b);
-             b = input_reflected ? bit_invert_Byte(b) : b;
-     #if !defined(CRC32_USE_LOOKUP_TABLE) || (CRC32_USE_LOOKUP_TABLE != 1)
              crc = crc ^ (((uint32_t)(b)) << 24);
              CRC_TRACE("CRC32: After XOR with input: 0x%08lX", crc);
              for (uint8_t i = 0; i != 8; i++) {
                  crc = (crc & 0x80000000UL) ? (crc << 1) ^ poly : (crc << 1);
                  CRC_TRACE("CRC32: Bit %d: MSB=%d, CRC=0x%08lX", i, (crc & 0x80000000UL) ? 1 : 0, crc);
              }
-     #else
-             uint32_t old_crc = crc;
-             crc = (uint32_t)((crc << 8) ^ p_table[(uint8_t)((crc ^ ((uint32_t)(b) << 24)) >> 24)]);
-             CRC_TRACE("CRC32: Lookup result: 0x%08lX -> 0x%08lX", old_crc, crc);
-     #endif
          }
+     }
+     return crc;
+ }
+
+ /**
+  * @brief CRC16 update over a chunk with the fastest available engine
+  * @param ctx Context of a CRC16 variant
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @return uint16_t Updated register value
+  */
+ static uint16_t crc16_process(const crc_ctx_t *ctx, const uint8_t *buf,
+                               size_t data_len) {
+     uint16_t crc = (uint16_t)ctx->crc;
+     uint16_t poly = (uint16_t)ctx->poly;
+     const uint16_t *p_table = ctx->p_table;
+ #if CRC_CLMUL_SUPPORTED
+     // The register is already bit reversed for reflected input
+     uint8_t remainder[CRC_CLMUL_BLOCK_LEN];
+     size_t folded =
+         CRC_clmul_fold(ctx->crc_type, crc, buf, data_len, remainder);
+     if (folded > 0) {
+         CRC_DEBUG("CRC16: Folded %zu bytes with carry-less multiplication",
+                   folded);
+         crc = crc16_update(0, remainder, sizeof(remainder), poly, p_table,
+                            ctx->input_reflected);
+         buf += folded;
+         data_len -= folded;
+     }
+ #endif
+     return crc16_update(crc, buf, data_len, poly, p_table,
+                         ctx->input_reflected);
+ }
 
-         if (output_reflected) {
-             uint32_t pre_reflect = crc;
-             crc = output_reflected ? bit_invert_Int32(crc) : crc;
-             CRC_TRACE("CRC32: After output reflection: 0x%08lX -> 0x%08lX", pre_reflect, crc);
+ /**
+  * @brief CRC32 update over a chunk with the fastest available engine
+  * @param ctx Context of a CRC32 variant
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @return uint32_t Updated register value
+  */
+ static uint32_t crc32_process(const crc_ctx_t *ctx, const uint8_t *buf,
+                               size_t data_len) {
+     uint32_t crc = ctx->crc;
+ #if CRC_SSE42_SUPPORTED
+     if (ctx->hw_crc32c) {
+         return CRC32C_sse42_update(crc, buf, data_len);
+     }
+ #endif
+ #if CRC_CLMUL_SUPPORTED
+     // The register is already bit reversed for reflected input
+     uint8_t remainder[CRC_CLMUL_BLOCK_LEN];
+     size_t folded =
+         CRC_clmul_fold(ctx->crc_type, crc, buf, data_len, remainder);
+     if (folded > 0) {
+         CRC_DEBUG("CRC32: Folded %zu bytes with carry-less multiplication",
+                   folded);
+         crc = crc32_update(0, remainder, sizeof(remainder), ctx->poly,
+                            ctx->p_table, ctx->slices, ctx->input_reflected);
+         buf += folded;
+         data_len -= folded;
+     }
+ #endif
+     return crc32_update(crc, buf, data_len, ctx->poly, ctx->p_table,
+                         ctx->slices, ctx->input_reflected);
+ }
+
+ /**
+  * @brief CRC64 update with the slicing tables, or bit by bit without them
+  *
+  * The register of reflected input variants is kept bit reversed and shifted
+  * right, so no byte or result is ever reversed.
+  *
+  * @param crc Current register value, bit reversed for reflected input
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @param poly Generator polynomial in normal notation
+  * @param slices Slicing tables in the bit order of the input, or NULL
+  * @param input_reflected true for reflected input
+  * @return uint64_t Updated register value
+  */
+ static uint64_t crc64_update(uint64_t crc, const uint8_t *buf,
+                              size_t data_len, uint64_t poly,
+                              const uint64_t (*slices)[256],
+                              bool input_reflected) {
+ #if defined(CRC64_USE_LOOKUP_TABLE) && (CRC64_USE_LOOKUP_TABLE == 1)
+     if (slices != NULL) {
+         return input_reflected
+                    ? crc64_slice_reflected(slices, crc, buf, data_len)
+                    : crc64_slice_normal(slices, crc, buf, data_len);
+     }
+ #else
+     (void)slices;
+ #endif
+     if (input_reflected) {
+         uint64_t reflected_poly = bit_invert_Int64(poly);
+         while (data_len-- != 0) {
+             crc ^= *buf++;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc & 1) ? (crc >> 1) ^ reflected_poly : (crc >> 1);
+             }
          }
      } else {
-         CRC_WARN("Input data length is zero");
+         while (data_len-- != 0) {
+             crc ^= (uint64_t)(*buf++) << 56;
+             for (uint8_t i = 0; i != 8; i++) {
+                 crc = (crc >> 63) ? (crc << 1) ^ poly : (crc << 1);
+             }
+         }
+     }
+     return crc;
+ }
+
+ /**
+  * @brief CRC64 update over a chunk with the fastest available engine
+  * @param ctx Context of a CRC64 variant
+  * @param buf Input data
+  * @param data_len Input length in bytes
+  * @return uint64_t Updated register value
+  */
+ static uint64_t crc64_process(const crc_ctx_t *ctx, const uint8_t *buf,
+                               size_t data_len) {
+     uint64_t crc = ctx->crc;
+     const uint64_t (*slices)[256] = (const uint64_t (*)[256])ctx->p_table;
+ #if CRC_CLMUL_SUPPORTED
+     // The register is already bit reversed for reflected input
+     uint8_t remainder[CRC_CLMUL_BLOCK_LEN];
+     size_t folded =
+         CRC_clmul_fold(ctx->crc_type, crc, buf, data_len, remainder);
+     if (folded > 0) {
+         CRC_DEBUG("CRC64: Folded %zu bytes with carry-less multiplication",
+                   folded);
+         crc = crc64_update(0, remainder, sizeof(remainder), ctx->poly, slices,
+                            ctx->input_reflected);
+         buf += folded;
+         data_len -= folded;
+     }
+ #endif
+     return crc64_update(crc, buf, data_len, ctx->poly, slices,
+                         ctx->input_reflected);
+ }
+
+ crc_error_t CRC_Init(crc_ctx_t *ctx, crc_t crc_type) {
+     if (ctx == NULL) {
+         CRC_ERROR_SIMPLE("CRC: NULL context pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+     if (crc_type < CRC8_CCITT || crc_type >= CRC_IMPL_COUNT) {
+         CRC_ERROR("CRC: Invalid CRC type: %u", crc_type);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+
+     ctx->crc_type = crc_type;
+     ctx->input_reflected = CRC_getInputReflected(crc_type);
+     ctx->output_reflected = CRC_getOutputReflected(crc_type);
+     ctx->register_reflected = false;
+     ctx->hw_crc32c = false;
+     ctx->slices = NULL;
+     if (crc_type < CRC16_XMODEM) {
+         ctx->width = 8;
+         ctx->poly = CRC8_getPoly(crc_type);
+         ctx->crc = CRC8_getSeed(crc_type);
+         ctx->final_xor = CRC8_getFinalXOR(crc_type);
+         ctx->p_table = crc8_table((uint8_t)ctx->poly);
+     } else if (crc_type < CRC32_D) {
+         ctx->width = 16;
+         ctx->poly = CRC16_getPoly(crc_type);
+         ctx->crc = CRC16_getSeed(crc_type);
+         ctx->final_xor = CRC16_getFinalXOR(crc_type);
+         ctx->p_table = crc16_table((uint16_t)ctx->poly);
+     } else if (crc_type < CRC64_ECMA_182) {
+         ctx->width = 32;
+         ctx->poly = CRC32_getPoly(crc_type);
+         ctx->crc = CRC32_getSeed(crc_type);
+         ctx->final_xor = CRC32_getFinalXOR(crc_type);
+         ctx->p_table = crc32_table((uint32_t)ctx->poly);
+     } else {
+         ctx->width = 64;
+         ctx->poly = CRC64_getPoly(crc_type);
+         ctx->crc = CRC64_getSeed(crc_type);
+         ctx->final_xor = CRC64_getFinalXOR(crc_type);
+         ctx->p_table = NULL;
+     }
+
+     if (ctx->poly == 0) {
+         CRC_ERROR("CRC%u: Invalid polynomial", ctx->width);
+         return CRC_ERROR_INVALID_POLYNOMIAL;
+     }
+     CRC_DEBUG("CRC%u: Using polynomial: 0x%08" PRIX64, ctx->width,
+               ctx->poly);
+     CRC_DEBUG("CRC%u: Initial seed: 0x%08" PRIX64, ctx->width, ctx->crc);
+     CRC_DEBUG("CRC%u: Input reflection: %s", ctx->width,
+               ctx->input_reflected ? "yes" : "no");
+     CRC_DEBUG("CRC%u: Output reflection: %s", ctx->width,
+               ctx->output_reflected ? "yes" : "no");
+
+     bool use_table = (ctx->width == 8 && CRC8_USE_LOOKUP_TABLE == 1) ||
+                      (ctx->width == 16 && CRC16_USE_LOOKUP_TABLE == 1) ||
+                      (ctx->width == 32 && CRC32_USE_LOOKUP_TABLE == 1);
+     if (use_table && ctx->p_table == NULL) {
+         CRC_ERROR("CRC%u: Lookup table not found", ctx->width);
+         return CRC_ERROR_LOOKUP_TABLE;
+     }
+
+     if (ctx->width == 8 && ctx->input_reflected) {
+ #if defined(CRC8_USE_LOOKUP_TABLE) && (CRC8_USE_LOOKUP_TABLE == 1)
+         ctx->p_table = crc8_reflected_table((uint8_t)ctx->poly);
+ #endif
+     } else if (ctx->width == 16 && ctx->input_reflected) {
+ #if defined(CRC16_USE_LOOKUP_TABLE) && (CRC16_USE_LOOKUP_TABLE == 1)
+         ctx->p_table = crc16_reflected_table((uint16_t)ctx->poly);
+ #endif
+     } else if (ctx->width == 32 && ctx->input_reflected) {
+ #if CRC_SSE42_SUPPORTED
+         ctx->hw_crc32c = (crc_type == CRC32_C) && CRC_sse42_available();
+         if (ctx->hw_crc32c) {
+             CRC_DEBUG_SIMPLE("CRC32: Using the SSE4.2 crc32 instruction");
+         }
+ #endif
+ #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
+         ctx->slices = crc32_slice_tables((uint32_t)ctx->poly, true);
+ #endif
+     } else if (ctx->width == 32) {
+ #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
+         ctx->slices = crc32_slice_tables((uint32_t)ctx->poly, false);
+ #endif
+     } else if (ctx->width == 64) {
+ #if defined(CRC64_USE_LOOKUP_TABLE) && (CRC64_USE_LOOKUP_TABLE == 1)
+         ctx->p_table = crc64_slice_tables(ctx->poly, ctx->input_reflected);
+         if (ctx->p_table != NULL) {
+             CRC_DEBUG("CRC64: Using slice-by-%d tables", CRC64_SLICE_BY);
+         }
+ #endif
+     }
+ #if defined(CRC32_USE_LOOKUP_TABLE) && (CRC32_USE_LOOKUP_TABLE == 1)
+     if (ctx->slices != NULL) {
+         CRC_DEBUG("CRC32: Using slice-by-%d tables", CRC32_SLICE_BY);
+     }
+ #endif
+
+     // Reflected input variants run LSB-first on a bit reversed register, so
+     // it ends up holding the reflected CRC: only a normal output needs a
+     // reversal at finalize
+     if (ctx->input_reflected) {
+         ctx->register_reflected = true;
+         ctx->crc = crc_reflect(ctx->crc, ctx->width);
+         ctx->output_reflected = !ctx->output_reflected;
+     }
+
+     return CRC_SUCCESS;
+ }
+
+ crc_error_t CRC_Update(crc_ctx_t *ctx, const void *data, size_t data_len) {
+     if (ctx == NULL || (data == NULL && data_len > 0)) {
+         CRC_ERROR_SIMPLE("CRC: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+     const uint8_t *_buf = (const uint8_t *)data;
+     CRC_DEBUG("CRC%u: Processing %zu bytes", ctx->width, data_len);
+
+     switch (ctx->width) {
+         case 8:
+             ctx->crc = crc8_update((uint8_t)ctx->crc, _buf, data_len,
+                                    (uint8_t)ctx->poly, ctx->p_table,
+                                    ctx->input_reflected);
+             break;
+         case 16:
+             ctx->crc = crc16_process(ctx, _buf, data_len);
+             break;
+         case 32:
+             ctx->crc = crc32_process(ctx, _buf, data_len);
+             break;
+         case 64:
+             ctx->crc = crc64_process(ctx, _buf, data_len);
+             break;
+         default:
+             return CRC_ERROR_INVALID_TYPE;
+     }
+     return CRC_SUCCESS;
+ }
+
+ /**
+  * @brief CRC value of the register of a context, of any width
+  * @param ctx Context initialized by CRC_Init
+  * @return uint64_t CRC value
+  */
+ static uint64_t crc_finalize(const crc_ctx_t *ctx) {
+     uint64_t crc = ctx->crc;
+     if (ctx->output_reflected) {
+         crc = crc_reflect(crc, ctx->width);
+         CRC_TRACE("CRC%u: After output reflection: 0x%016llX -> 0x%016llX",
+                   ctx->width, (unsigned long long)ctx->crc,
+                   (unsigned long long)crc);
      }
+     crc ^= ctx->final_xor;
+     CRC_INFO("CRC%u result: 0x%016llX", ctx->width, (unsigned long long)crc);
+     return crc;
+ }
 
-     uint32_t final_xor = CRC32_getFinalXOR(crc_type);
-     CRC_DEBUG("CRC32: Final XOR value: 0x%08lX", final_xor);
+ crc_error_t CRC_Finalize(const crc_ctx_t *ctx, uint32_t *result) {
+     if (ctx == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC: NULL result pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+     if (ctx->width > 32) {
+         CRC_ERROR_SIMPLE("CRC: CRC64 context, use CRC64_Finalize");
+         return CRC_ERROR_INVALID_TYPE;
+     }
+     *result = (uint32_t)crc_finalize(ctx);
+     return CRC_SUCCESS;
+ }
 
-     *result = crc ^ final_xor;
-     CRC_INFO("CRC32 result: 0x%08lX", *result);
+ crc_error_t CRC64_Finalize(const crc_ctx_t *ctx, uint64_t *result) {
+     if (ctx == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC64: NULL result pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+     if (ctx->width != 64) {
+         CRC_ERROR("CRC64: Context of a CRC%u variant", ctx->width);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+     *result = crc_finalize(ctx);
+     return CRC_SUCCESS;
+ }
 
+ /**
+  * @brief One-shot CRC of a buffer through a context
+  *
+  * Empty input returns the seed XORed with the final mask, without the output
+  * reflection, as the one-shot functions always did.
+  *
+  * @param data Pointer to input data
+  * @param data_len Length of input data
+  * @param crc_type CRC variant, already checked against the width
+  * @param[out] result Pointer to store CRC result
+  * @return crc_error_t Error code indicating success or failure
+  */
+ static crc_error_t crc_calculate(const void *data, size_t data_len,
+                                  crc_t crc_type, uint64_t *result) {
+     crc_ctx_t ctx;
+     crc_error_t err = CRC_Init(&ctx, crc_type);
+     if (err != CRC_SUCCESS) {
+         return err;
+     }
+     if (data_len == 0) {
+         CRC_WARN("Input data length is zero");
+         uint64_t seed = ctx.register_reflected
+                             ? crc_reflect(ctx.crc, ctx.width)
+                             : ctx.crc;
+         *result = seed ^ ctx.final_xor;
+         return CRC_SUCCESS;
+     }
+     CRC_INFO("CRC%u: Starting calculation", ctx.width);
+     err = CRC_Update(&ctx, data, data_len);
+     if (err != CRC_SUCCESS) {
+         return err;
+     }
+     *result = crc_finalize(&ctx);
      return CRC_SUCCESS;
  }
 
+ crc_error_t CRC8_Calculate(const void *data, size_t data_len, crc_t crc_type, uint8_t *result){
+     // Validate input parameters
+     if (data == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC8: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+
+     // Validate CRC type
+     if (crc_type > CRC8_LTE || crc_type < CRC8_CCITT) {
+         CRC_ERROR("CRC8: Invalid CRC type: %u", crc_type);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+
+     uint64_t crc = 0;
+     crc_error_t err = crc_calculate(data, data_len, crc_type, &crc);
+     if (err == CRC_SUCCESS) {
+         *result = (uint8_t)crc;
+     }
+     return err;
+ }
+
+ uint8_t CRC8(const void *data, size_t data_len, crc_t crc_type) {
+     uint8_t result = 0;
+     if (CRC8_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
+         return 0; // Return 0 on error
+     }
+     return result;
+ }
+
+ crc_error_t CRC16_Calculate(const void *data, size_t data_len, crc_t crc_type, uint16_t *result) {
+     // Validate input parameters
+     if (data == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC16: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+
+     // Validate CRC type
+     if (crc_type > CRC16_CDMA2000 || crc_type < CRC16_XMODEM) {
+         CRC_ERROR("CRC16: Invalid CRC type: %u", crc_type);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+
+     uint64_t crc = 0;
+     crc_error_t err = crc_calculate(data, data_len, crc_type, &crc);
+     if (err == CRC_SUCCESS) {
+         *result = (uint16_t)crc;
+     }
+     return err;
+ }
+
+ uint16_t CRC16(const void *data, size_t data_len, crc_t crc_type) {
+     uint16_t result = 0;
+     if (CRC16_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
+         return 0; // Return 0 on error
+     }
+     return result;
+ }
+
+ crc_error_t CRC32_Calculate(const void *data, size_t data_len, crc_t crc_type, uint32_t *result) {
+     // Validate input parameters
+     if (data == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC32: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+
+     // Validate CRC type
+     if (crc_type > CRC32_XFER || crc_type < CRC32_D) {
+         CRC_ERROR("CRC32: Invalid CRC type: %u", crc_type);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+
+     uint64_t crc = 0;
+     crc_error_t err = crc_calculate(data, data_len, crc_type, &crc);
+     if (err == CRC_SUCCESS) {
+         *result = (uint32_t)crc;
+     }
+     return err;
+ }
+
  uint32_t CRC32(const void *data, size_t data_len, crc_t crc_type) {
      uint32_t result = 0;
      if (CRC32_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
@@ -860,6 +1816,175 @@
      return result;
  }
 
+ crc_error_t CRC64_Calculate(const void *data, size_t data_len, crc_t crc_type,
+                             uint64_t *result) {
+     // Validate input parameters
+     if (data == NULL || result == NULL) {
+         CRC_ERROR_SIMPLE("CRC64: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+
+     // Validate CRC type
+     if (crc_type > CRC64_NVME || crc_type < CRC64_ECMA_182) {
+         CRC_ERROR("CRC64: Invalid CRC type: %u", crc_type);
+         return CRC_ERROR_INVALID_TYPE;
+     }
+
+     return crc_calculate(data, data_len, crc_type, result);
+ }
+
+ uint64_t CRC64(const void *data, size_t data_len, crc_t crc_type) {
+     uint64_t result = 0;
+     if (CRC64_Calculate(data, data_len, crc_type, &result) != CRC_SUCCESS) {
+         return 0; // Return 0 on error
+     }
+     return result;
+ }
+
+ /**
+  * @brief Product of two polynomials modulo the generator polynomial
+  *
+  * Registers are in normal (MSB-first) order, bit width - 1 holding the
+  * coefficient of x^(width - 1).
+  *
+  * @param a First factor
+  * @param b Second factor
+  * @param poly Generator polynomial without the x^width term
+  * @param width CRC width in bits (8, 16, 32 or 64)
+  * @return uint64_t a * b mod P
+  */
+ static uint64_t crc_mulmod(uint64_t a, uint64_t b, uint64_t poly,
+                            uint8_t width) {
+     uint64_t top = 1ULL << (width - 1);
+     uint64_t mask = top | (top - 1);
+     uint64_t product = 0;
+     for (uint64_t bit = top; bit != 0; bit >>= 1) {
+         product = (product & top) ? ((product << 1) ^ poly) & mask
+                                   : (product << 1) & mask;
+         if (b & bit) {
+             product ^= a;
+         }
+     }
+     return product;
+ }
+
+ /**
+  * @brief Computes x^(8 * len) mod P by square-and-multiply, in O(log len)
+  * @param len Number of bytes
+  * @param poly Generator polynomial without the x^width term
+  * @param width CRC width in bits (8, 16, 32 or 64)
+  * @return uint64_t x^(8 * len) mod P
+  */
+ static uint64_t crc_xpow8n(uint64_t len, uint64_t poly, uint8_t width) {
+     uint64_t result = 1;
+     uint64_t square = crc_mulmod(1ULL << 4, 1ULL << 4, poly, width);  // x^8
+     while (len != 0) {
+         if (len & 1) {
+             result = crc_mulmod(result, square, poly, width);
+         }
+         square = crc_mulmod(square, square, poly, width);
+         len >>= 1;
+     }
+     return result;
+ }
+
+ /**
+  * @brief Merges the CRCs of two consecutive segments
+  *
+  * The register after A followed by B, both started from the seed, is
+  * (reg(A) ^ seed) * x^(8 * len_b) ^ reg(B). The registers are recovered
+  * from the CRC values by undoing the final XOR and the output reflection.
+  *
+  * @param crc_a CRC of the first segment
+  * @param crc_b CRC of the second segment
+  * @param len_b Length of the second segment in bytes
+  * @param crc_type CRC variant, already checked against the width
+  * @param width CRC width in bits (8, 16, 32 or 64)
+  * @return uint64_t CRC of the concatenation
+  */
+ static uint64_t crc_combine(uint64_t crc_a, uint64_t crc_b, uint64_t len_b,
+                             crc_t crc_type, uint8_t width) {
+     if (len_b == 0) {
+         return crc_a;
+     }
+     uint64_t poly, seed, final_xor;
+     switch (width) {
+         case 8:
+             poly = CRC8_getPoly(crc_type);
+             seed = CRC8_getSeed(crc_type);
+             final_xor = CRC8_getFinalXOR(crc_type);
+             break;
+         case 16:
+             poly = CRC16_getPoly(crc_type);
+             seed = CRC16_getSeed(crc_type);
+             final_xor = CRC16_getFinalXOR(crc_type);
+             break;
+         case 32:
+             poly = CRC32_getPoly(crc_type);
+             seed = CRC32_getSeed(crc_type);
+             final_xor = CRC32_getFinalXOR(crc_type);
+             break;
+         default:
+             poly = CRC64_getPoly(crc_type);
+             seed = CRC64_getSeed(crc_type);
+             final_xor = CRC64_getFinalXOR(crc_type);
+             break;
+     }
+     bool output_reflected = CRC_getOutputReflected(crc_type);
+
+     uint64_t reg_a = crc_a ^ final_xor;
+     uint64_t reg_b = crc_b ^ final_xor;
+     if (output_reflected) {
+         reg_a = crc_reflect(reg_a, width);
+         reg_b = crc_reflect(reg_b, width);
+     }
+
+     uint64_t reg = crc_mulmod(reg_a ^ seed, crc_xpow8n(len_b, poly, width),
+                               poly, width) ^
+                    reg_b;
+
+     if (output_reflected) {
+         reg = crc_reflect(reg, width);
+     }
+     return reg ^ final_xor;
+ }
+
+ uint8_t CRC8_combine(uint8_t crc_a, uint8_t crc_b, uint64_t len_b,
+                      crc_t crc_type) {
+     if (crc_type > CRC8_LTE || crc_type < CRC8_CCITT) {
+         CRC_ERROR("CRC8: Invalid CRC type: %u", crc_type);
+         return 0;
+     }
+     return (uint8_t)crc_combine(crc_a, crc_b, len_b, crc_type, 8);
+ }
+
+ uint16_t CRC16_combine(uint16_t crc_a, uint16_t crc_b, uint64_t len_b,
+                        crc_t crc_type) {
+     if (crc_type > CRC16_CDMA2000 || crc_type < CRC16_XMODEM) {
+         CRC_ERROR("CRC16: Invalid CRC type: %u", crc_type);
+         return 0;
+     }
+     return (uint16_t)crc_combine(crc_a, crc_b, len_b, crc_type, 16);
+ }
+
+ uint32_t CRC32_combine(uint32_t crc_a, uint32_t crc_b, uint64_t len_b,
+                        crc_t crc_type) {
+     if (crc_type > CRC32_XFER || crc_type < CRC32_D) {
+         CRC_ERROR("CRC32: Invalid CRC type: %u", crc_type);
+         return 0;
+     }
+     return (uint32_t)crc_combine(crc_a, crc_b, len_b, crc_type, 32);
+ }
+
+ uint64_t CRC64_combine(uint64_t crc_a, uint64_t crc_b, uint64_t len_b,
+                        crc_t crc_type) {
+     if (crc_type > CRC64_NVME || crc_type < CRC64_ECMA_182) {
+         CRC_ERROR("CRC64: Invalid CRC type: %u", crc_type);
+         return 0;
+     }
+     return crc_combine(crc_a, crc_b, len_b, crc_type, 64);
+ }
+
  crc_error_t CRC8_ValidateAppended(const void *data, size_t data_len, crc_t crc_type) {
 
      // Calculate CRC of data excluding the appended CRC byte
@@ -909,3 +2034,33 @@
 
      return (calculated_crc == appended_crc)? CRC_SUCCESS : CRC_ERROR_CRC_MISMATCH;
  }
+
+ crc_error_t CRC64_ValidateAppended(const void *data, size_t data_len,
+                                    crc_t crc_type) {
+     if (data == NULL) {
+         CRC_ERROR_SIMPLE("CRC64: NULL data pointer");
+         return CRC_ERROR_NULL_DATA;
+     }
+     if (data_len < sizeof(uint64_t)) {
+         CRC_ERROR_SIMPLE("CRC64: Data shorter than the appended CRC");
+         return CRC_ERROR_ZERO_LENGTH;
+     }
+
+     // Calculate CRC of data excluding the appended CRC bytes
+     uint64_t calculated_crc;
+     crc_error_t retVal = CRC64_Calculate(data, data_len - sizeof(uint64_t),
+                                          crc_type, &calculated_crc);
+     if (retVal != CRC_SUCCESS) {
+         return retVal;
+     }
+
+     // Compare with appended CRC, most significant byte first
+     const uint8_t *data_bytes = (const uint8_t *)data;
+     uint64_t appended_crc = 0;
+     for (size_t i = data_len - sizeof(uint64_t); i < data_len; i++) {
+         appended_crc = (appended_crc << 8) | data_bytes[i];
+     }
+
+     return (calculated_crc == appended_crc) ? CRC_SUCCESS
+                                             : CRC_ERROR_CRC_MISMATCH;
+ }
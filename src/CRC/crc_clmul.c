@@ -0,0 +1,214 @@
+/**
+ * @file crc_clmul.c
+ * @brief Carry-less multiplication (PCLMULQDQ) folding backend for CRC16,
+ * CRC32 and CRC64 on x86/x86-64 processors
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "crc_clmul.h"
+
+#if CRC_CLMUL_SUPPORTED
+
+#include <cpuid.h>
+#include <immintrin.h>
+#include <stdatomic.h>
+
+#define CRC_CLMUL_TARGET __attribute__((target("pclmul,ssse3,sse2")))
+
+/**
+ * @brief Folding multipliers of one variant
+ *
+ * Each pair multiplies the two 64-bit halves of an accumulator: the result
+ * is congruent (mod P) to the accumulator moved forward by 512 or 128 bits.
+ */
+typedef struct {
+    uint64_t fold_512[2];  // 4 blocks ahead, main loop
+    uint64_t fold_128[2];  // 1 block ahead, merge and tail
+    uint8_t width;         // CRC width in bits (16, 32 or 64)
+    bool reflected;        // Bit reversed (LSB-first) data and register
+} crc_clmul_consts_t;
+
+static crc_clmul_consts_t crc_clmul_consts[CRC_IMPL_COUNT];
+static atomic_int crc_clmul_consts_state = 0;  // 0 empty, 1 building, 2 ready
+static atomic_int crc_clmul_cpu = -1;          // -1 unknown, 0 no, 1 yes
+
+bool CRC_clmul_available(void) {
+    int cpu = atomic_load_explicit(&crc_clmul_cpu, memory_order_relaxed);
+    if (cpu < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        cpu = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+              (ecx & bit_PCLMUL) != 0 && (ecx & bit_SSSE3) != 0 &&
+              (edx & bit_SSE2) != 0;
+        atomic_store_explicit(&crc_clmul_cpu, cpu, memory_order_relaxed);
+    }
+    return cpu == 1;
+}
+
+/* x^n mod P, bit j holding the coefficient of x^j */
+static uint64_t xpow_mod(size_t n, uint64_t poly, uint8_t width) {
+    uint64_t top = 1ULL << (width - 1);
+    uint64_t r = 1;
+    for (size_t i = 0; i < n; i++) {
+        r = (r & top) ? (r << 1) ^ poly : (r << 1);
+    }
+    return r & (top | (top - 1));
+}
+
+/* Bit reversal of a polynomial of degree < 64 stored in 64 bits */
+static uint64_t reflect64(uint64_t value) {
+    uint64_t reflected = 0;
+    for (int i = 0; i < 64; i++) {
+        reflected = (reflected << 1) | ((value >> i) & 1);
+    }
+    return reflected;
+}
+
+/*
+ * Moving a block X = H * x^64 + L forward by d bits: X * x^d is congruent to
+ * H * (x^(d+64) mod P) + L * (x^d mod P). In the reflected domain the
+ * 64x64-bit product comes out one bit short, which x^(d+63) and x^(d-1)
+ * make up for. The multiplier of H goes with qword 1 of a normal block and
+ * qword 0 of a reflected one.
+ */
+static void set_fold(uint64_t pair[2], size_t d, uint64_t poly, uint8_t width,
+                     bool reflected) {
+    if (reflected) {
+        pair[0] = reflect64(xpow_mod(d + 63, poly, width));
+        pair[1] = reflect64(xpow_mod(d - 1, poly, width));
+    } else {
+        pair[0] = xpow_mod(d, poly, width);
+        pair[1] = xpow_mod(d + 64, poly, width);
+    }
+}
+
+static void build_consts(void) {
+    for (int type = CRC16_XMODEM; type < CRC_IMPL_COUNT; type++) {
+        crc_clmul_consts_t *consts = &crc_clmul_consts[type];
+        uint64_t poly;
+        if (type >= CRC64_ECMA_182) {
+            consts->width = 64;
+            poly = CRC64_getPoly((crc_t)type);
+        } else if (type >= CRC32_D) {
+            consts->width = 32;
+            poly = CRC32_getPoly((crc_t)type);
+        } else {
+            consts->width = 16;
+            poly = CRC16_getPoly((crc_t)type);
+        }
+        consts->reflected = CRC_getInputReflected((crc_t)type);
+        set_fold(consts->fold_512, 512, poly, consts->width,
+                 consts->reflected);
+        set_fold(consts->fold_128, 128, poly, consts->width,
+                 consts->reflected);
+    }
+}
+
+/* Constants of a variant, or NULL while another thread computes them */
+static const crc_clmul_consts_t *get_consts(crc_t crc_type) {
+    int state =
+        atomic_load_explicit(&crc_clmul_consts_state, memory_order_acquire);
+    if (state == 0 && atomic_compare_exchange_strong_explicit(
+                          &crc_clmul_consts_state, &state, 1,
+                          memory_order_acquire, memory_order_acquire)) {
+        build_consts();
+        state = 2;
+        atomic_store_explicit(&crc_clmul_consts_state, state,
+                              memory_order_release);
+    }
+    return (state == 2) ? &crc_clmul_consts[crc_type] : NULL;
+}
+
+/* Block as a polynomial: byte reversed for MSB-first variants */
+CRC_CLMUL_TARGET static inline __m128i load_block(const uint8_t *p,
+                                                  bool reflected,
+                                                  __m128i swap) {
+    __m128i block = _mm_loadu_si128((const __m128i *)p);
+    return reflected ? block : _mm_shuffle_epi8(block, swap);
+}
+
+CRC_CLMUL_TARGET static inline __m128i fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                         _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+CRC_CLMUL_TARGET static size_t fold_blocks(const crc_clmul_consts_t *consts,
+                                           uint64_t crc, const uint8_t *data,
+                                           size_t data_len,
+                                           uint8_t *remainder) {
+    const bool reflected = consts->reflected;
+    const __m128i swap =
+        _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const uint8_t *p = data;
+
+    // The register enters as the first bits of the message
+    __m128i init =
+        reflected ? _mm_set_epi64x(0, (long long)crc)
+                  : _mm_set_epi64x((long long)(crc << (64 - consts->width)),
+                                   0);
+
+    __m128i x0 = _mm_xor_si128(load_block(p, reflected, swap), init);
+    __m128i x1 = load_block(p + 16, reflected, swap);
+    __m128i x2 = load_block(p + 32, reflected, swap);
+    __m128i x3 = load_block(p + 48, reflected, swap);
+    p += 64;
+    data_len -= 64;
+
+    __m128i k = _mm_loadu_si128((const __m128i *)consts->fold_512);
+    while (data_len >= 64) {
+        x0 = _mm_xor_si128(fold(x0, k), load_block(p, reflected, swap));
+        x1 = _mm_xor_si128(fold(x1, k), load_block(p + 16, reflected, swap));
+        x2 = _mm_xor_si128(fold(x2, k), load_block(p + 32, reflected, swap));
+        x3 = _mm_xor_si128(fold(x3, k), load_block(p + 48, reflected, swap));
+        p += 64;
+        data_len -= 64;
+    }
+
+    k = _mm_loadu_si128((const __m128i *)consts->fold_128);
+    __m128i x = _mm_xor_si128(fold(x0, k), x1);
+    x = _mm_xor_si128(fold(x, k), x2);
+    x = _mm_xor_si128(fold(x, k), x3);
+    while (data_len >= 16) {
+        x = _mm_xor_si128(fold(x, k), load_block(p, reflected, swap));
+        p += 16;
+        data_len -= 16;
+    }
+
+    _mm_storeu_si128((__m128i *)remainder,
+                     reflected ? x : _mm_shuffle_epi8(x, swap));
+    return (size_t)(p - data);
+}
+
+size_t CRC_clmul_fold(crc_t crc_type, uint64_t crc, const uint8_t *data,
+                      size_t data_len,
+                      uint8_t remainder[CRC_CLMUL_BLOCK_LEN]) {
+    if (data_len < CRC_CLMUL_MIN_LEN || data_len < 64 ||
+        crc_type < CRC16_XMODEM || crc_type >= CRC_IMPL_COUNT ||
+        !CRC_clmul_available()) {
+        return 0;
+    }
+    const crc_clmul_consts_t *consts = get_consts(crc_type);
+    if (consts == NULL) {
+        return 0;
+    }
+    return fold_blocks(consts, crc, data, data_len, remainder);
+}
+
+#else
+
+bool CRC_clmul_available(void) { return false; }
+
+size_t CRC_clmul_fold(crc_t crc_type, uint64_t crc, const uint8_t *data,
+                      size_t data_len,
+                      uint8_t remainder[CRC_CLMUL_BLOCK_LEN]) {
+    (void)crc_type;
+    (void)crc;
+    (void)data;
+    (void)data_len;
+    (void)remainder;
+    return 0;
+}
+
+#endif
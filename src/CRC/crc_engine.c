@@ -0,0 +1,327 @@
+/**
+ * @file crc_engine.c
+ * @brief Generic Rocksoft-model CRC engine with lazily generated tables
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "crc_engine.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define CRC_ENGINE_YIELD() sched_yield()
+#else
+#define CRC_ENGINE_YIELD() ((void)0)
+#endif
+
+#define CRC_ENGINE_SLICE_BY 8
+
+/**
+ * @brief Life cycle of a cache slot. The key is written between CLAIMED and
+ * BUILDING, and stays once published, so a key occupies at most one slot.
+ */
+typedef enum {
+    CRC_ENGINE_SLOT_EMPTY,
+    CRC_ENGINE_SLOT_CLAIMED,   // Key being written
+    CRC_ENGINE_SLOT_BUILDING,  // Key published, tables being built
+    CRC_ENGINE_SLOT_READY,
+    CRC_ENGINE_SLOT_FAILED,    // Key published, out of memory for the tables
+} crc_engine_state_t;
+
+/**
+ * @brief Cached slicing tables of one polynomial in one bit order
+ *
+ * The key is the polynomial in register alignment (left-aligned for normal
+ * registers, reflected and right-aligned otherwise), which already encodes
+ * the width. table[k][b] is the register contribution of byte b followed by
+ * k zero bytes.
+ */
+typedef struct {
+    atomic_int state;  // crc_engine_state_t
+    bool reflected;
+    uint64_t poly_aligned;
+    const uint64_t (*table)[256];
+} crc_engine_slot_t;
+
+static crc_engine_slot_t crc_engine_cache[CRC_ENGINE_CACHE_SLOTS];
+
+/* Reverses the low width bits of data */
+static uint64_t crc_engine_reflect(uint64_t data, uint8_t width) {
+    data = ((data >> 1) & 0x5555555555555555ULL) |
+           ((data & 0x5555555555555555ULL) << 1);
+    data = ((data >> 2) & 0x3333333333333333ULL) |
+           ((data & 0x3333333333333333ULL) << 2);
+    data = ((data >> 4) & 0x0F0F0F0F0F0F0F0FULL) |
+           ((data & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    data = ((data >> 8) & 0x00FF00FF00FF00FFULL) |
+           ((data & 0x00FF00FF00FF00FFULL) << 8);
+    data = ((data >> 16) & 0x0000FFFF0000FFFFULL) |
+           ((data & 0x0000FFFF0000FFFFULL) << 16);
+    data = (data >> 32) | (data << 32);
+    return data >> (64 - width);
+}
+
+static inline uint64_t crc_engine_mask(uint8_t width) {
+    return (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+}
+
+/* One byte through the register, bit by bit */
+static inline uint64_t crc_engine_byte(uint64_t reg, uint8_t byte,
+                                       uint64_t poly_aligned, bool reflected) {
+    if (reflected) {
+        reg ^= byte;
+        for (uint8_t i = 0; i != 8; i++) {
+            reg = (reg & 1) ? (reg >> 1) ^ poly_aligned : (reg >> 1);
+        }
+    } else {
+        reg ^= (uint64_t)byte << 56;
+        for (uint8_t i = 0; i != 8; i++) {
+            reg = (reg >> 63) ? (reg << 1) ^ poly_aligned : (reg << 1);
+        }
+    }
+    return reg;
+}
+
+static void crc_engine_build(uint64_t poly_aligned, bool reflected,
+                             uint64_t table[][256]) {
+    for (uint32_t b = 0; b < 256; b++) {
+        table[0][b] = crc_engine_byte(0, (uint8_t)b, poly_aligned, reflected);
+    }
+    // One more zero byte per table
+    for (size_t k = 1; k < CRC_ENGINE_SLICE_BY; k++) {
+        for (size_t b = 0; b < 256; b++) {
+            uint64_t prev = table[k - 1][b];
+            table[k][b] = reflected ? (prev >> 8) ^ table[0][prev & 0xFF]
+                                    : (prev << 8) ^ table[0][prev >> 56];
+        }
+    }
+}
+
+/* Builds the tables of a slot in the BUILDING state and publishes them */
+static const uint64_t (*crc_engine_fill(crc_engine_slot_t *slot))[256] {
+    uint64_t (*table)[256] = (uint64_t (*)[256])malloc(
+        CRC_ENGINE_SLICE_BY * sizeof(*table));
+    if (table == NULL) {
+        atomic_store_explicit(&slot->state, CRC_ENGINE_SLOT_FAILED,
+                              memory_order_release);
+        return NULL;
+    }
+    crc_engine_build(slot->poly_aligned, slot->reflected, table);
+    slot->table = (const uint64_t (*)[256])table;
+    atomic_store_explicit(&slot->state, CRC_ENGINE_SLOT_READY,
+                          memory_order_release);
+    return slot->table;
+}
+
+/**
+ * @brief Gets the tables of a polynomial, building them on first use
+ *
+ * Slots are taken in order and a caller only moves past a slot once it has
+ * seen its key, so two callers starting the same key meet on one slot.
+ *
+ * @return Tables, or NULL if the cache is full, memory ran out or another
+ * thread is building them (callers then run bit by bit)
+ */
+static const uint64_t (*crc_engine_tables(uint64_t poly_aligned,
+                                          bool reflected))[256] {
+    for (size_t i = 0; i < CRC_ENGINE_CACHE_SLOTS; i++) {
+        crc_engine_slot_t *slot = &crc_engine_cache[i];
+        int state = atomic_load_explicit(&slot->state, memory_order_acquire);
+        if (state == CRC_ENGINE_SLOT_EMPTY) {
+            if (atomic_compare_exchange_strong_explicit(
+                    &slot->state, &state, CRC_ENGINE_SLOT_CLAIMED,
+                    memory_order_acquire, memory_order_acquire)) {
+                slot->poly_aligned = poly_aligned;
+                slot->reflected = reflected;
+                atomic_store_explicit(&slot->state, CRC_ENGINE_SLOT_BUILDING,
+                                      memory_order_release);
+                return crc_engine_fill(slot);
+            }
+            // Taken by another thread, state holds its progress
+        }
+        // The key follows within a few stores, unless the writer was
+        // preempted, so give it the CPU back
+        while (state == CRC_ENGINE_SLOT_CLAIMED) {
+            CRC_ENGINE_YIELD();
+            state = atomic_load_explicit(&slot->state, memory_order_acquire);
+        }
+        if (slot->poly_aligned != poly_aligned ||
+            slot->reflected != reflected) {
+            continue;
+        }
+        if (state == CRC_ENGINE_SLOT_READY) {
+            return slot->table;
+        }
+        if (state == CRC_ENGINE_SLOT_FAILED &&
+            atomic_compare_exchange_strong_explicit(
+                &slot->state, &state, CRC_ENGINE_SLOT_BUILDING,
+                memory_order_acquire, memory_order_relaxed)) {
+            return crc_engine_fill(slot);  // Retry after running out of memory
+        }
+        return NULL;  // Being built by another thread
+    }
+    CRC_WARN_SIMPLE("CRC engine: table cache full, running bit by bit");
+    return NULL;
+}
+
+static inline uint64_t load_le64(const uint8_t *p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+           ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+           ((uint64_t)p[7] << 56);
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+crc_error_t CRC_getParams(crc_t crc_type, crc_params_t *params) {
+    if (params == NULL) {
+        CRC_ERROR_SIMPLE("CRC engine: NULL params pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    if (crc_type <= CRC8_LTE) {
+        params->width = 8;
+        params->poly = CRC8_getPoly(crc_type);
+        params->init = CRC8_getSeed(crc_type);
+        params->xorout = CRC8_getFinalXOR(crc_type);
+    } else if (crc_type <= CRC16_CDMA2000) {
+        params->width = 16;
+        params->poly = CRC16_getPoly(crc_type);
+        params->init = CRC16_getSeed(crc_type);
+        params->xorout = CRC16_getFinalXOR(crc_type);
+    } else if (crc_type <= CRC32_XFER) {
+        params->width = 32;
+        params->poly = CRC32_getPoly(crc_type);
+        params->init = CRC32_getSeed(crc_type);
+        params->xorout = CRC32_getFinalXOR(crc_type);
+    } else if (crc_type <= CRC64_NVME) {
+        params->width = 64;
+        params->poly = CRC64_getPoly(crc_type);
+        params->init = CRC64_getSeed(crc_type);
+        params->xorout = CRC64_getFinalXOR(crc_type);
+    } else {
+        CRC_ERROR("CRC engine: Invalid CRC type: %u", crc_type);
+        return CRC_ERROR_INVALID_TYPE;
+    }
+    params->refin = CRC_getInputReflected(crc_type);
+    params->refout = CRC_getOutputReflected(crc_type);
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Engine_Init(crc_engine_ctx_t *ctx, const crc_params_t *params) {
+    if (ctx == NULL || params == NULL) {
+        CRC_ERROR_SIMPLE("CRC engine: NULL context pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    uint8_t width = params->width;
+    if (width == 0 || width > 64) {
+        CRC_ERROR("CRC engine: Invalid width: %u", width);
+        return CRC_ERROR_INVALID_TYPE;
+    }
+    uint64_t mask = crc_engine_mask(width);
+    if ((params->poly & ~mask) != 0) {
+        CRC_ERROR_SIMPLE("CRC engine: Polynomial wider than the CRC");
+        return CRC_ERROR_INVALID_POLYNOMIAL;
+    }
+
+    ctx->params = *params;
+    ctx->params.init &= mask;
+    ctx->params.xorout &= mask;
+    if (params->refin) {
+        ctx->poly_aligned = crc_engine_reflect(params->poly, width);
+        ctx->reg = crc_engine_reflect(ctx->params.init, width);
+    } else {
+        ctx->poly_aligned = params->poly << (64 - width);
+        ctx->reg = ctx->params.init << (64 - width);
+    }
+    ctx->tables = crc_engine_tables(ctx->poly_aligned, params->refin);
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Engine_Update(crc_engine_ctx_t *ctx, const void *data,
+                              size_t data_len) {
+    if (ctx == NULL || (data == NULL && data_len != 0)) {
+        CRC_ERROR_SIMPLE("CRC engine: NULL data pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    const uint8_t *p = (const uint8_t *)data;
+    const uint64_t (*t)[256] = ctx->tables;
+    uint64_t reg = ctx->reg;
+    bool reflected = ctx->params.refin;
+
+    if (t == NULL) {
+        while (data_len--) {
+            reg = crc_engine_byte(reg, *p++, ctx->poly_aligned, reflected);
+        }
+    } else if (reflected) {
+        while (data_len >= CRC_ENGINE_SLICE_BY) {
+            reg ^= load_le64(p);
+            p += CRC_ENGINE_SLICE_BY;
+            data_len -= CRC_ENGINE_SLICE_BY;
+            reg = t[7][reg & 0xFF] ^ t[6][(reg >> 8) & 0xFF] ^
+                  t[5][(reg >> 16) & 0xFF] ^ t[4][(reg >> 24) & 0xFF] ^
+                  t[3][(reg >> 32) & 0xFF] ^ t[2][(reg >> 40) & 0xFF] ^
+                  t[1][(reg >> 48) & 0xFF] ^ t[0][reg >> 56];
+        }
+        while (data_len--) {
+            reg = (reg >> 8) ^ t[0][(reg ^ *p++) & 0xFF];
+        }
+    } else {
+        while (data_len >= CRC_ENGINE_SLICE_BY) {
+            reg ^= load_be64(p);
+            p += CRC_ENGINE_SLICE_BY;
+            data_len -= CRC_ENGINE_SLICE_BY;
+            reg = t[7][reg >> 56] ^ t[6][(reg >> 48) & 0xFF] ^
+                  t[5][(reg >> 40) & 0xFF] ^ t[4][(reg >> 32) & 0xFF] ^
+                  t[3][(reg >> 24) & 0xFF] ^ t[2][(reg >> 16) & 0xFF] ^
+                  t[1][(reg >> 8) & 0xFF] ^ t[0][reg & 0xFF];
+        }
+        while (data_len--) {
+            reg = (reg << 8) ^ t[0][(reg >> 56) ^ *p++];
+        }
+    }
+    ctx->reg = reg;
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Engine_Finalize(const crc_engine_ctx_t *ctx,
+                                uint64_t *result) {
+    if (ctx == NULL || result == NULL) {
+        CRC_ERROR_SIMPLE("CRC engine: NULL result pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    uint8_t width = ctx->params.width;
+    uint64_t crc;
+    if (ctx->params.refin) {
+        // The register already holds the reflected value
+        crc = ctx->params.refout ? ctx->reg
+                                 : crc_engine_reflect(ctx->reg, width);
+    } else {
+        crc = ctx->reg >> (64 - width);
+        crc = ctx->params.refout ? crc_engine_reflect(crc, width) : crc;
+    }
+    *result = crc ^ ctx->params.xorout;
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Engine_Calculate(const crc_params_t *params, const void *data,
+                                 size_t data_len, uint64_t *result) {
+    crc_engine_ctx_t ctx;
+    crc_error_t err = CRC_Engine_Init(&ctx, params);
+    if (err == CRC_SUCCESS) {
+        err = CRC_Engine_Update(&ctx, data, data_len);
+    }
+    if (err == CRC_SUCCESS) {
+        err = CRC_Engine_Finalize(&ctx, result);
+    }
+    return err;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file crc_multi.c
+ * @brief Several CRC variants over the same data in a single pass
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "crc_multi.h"
+
+#include "crc_clmul.h"
+
+static inline uint64_t load_le64(const uint8_t *p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+           ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+           ((uint64_t)p[7] << 56);
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+/*
+ * Steps every interleaved register over a block. Each 8-byte word is loaded
+ * once; the registers are independent, so the lookups of one overlap with
+ * those of the next.
+ */
+static void crc_multi_interleave(crc_multi_ctx_t *ctx, const uint8_t *p,
+                                 size_t len) {
+    const uint64_t (*refl_tables[CRC_MULTI_MAX_STREAMS])[256];
+    const uint64_t (*norm_tables[CRC_MULTI_MAX_STREAMS])[256];
+    uint64_t refl_regs[CRC_MULTI_MAX_STREAMS];
+    uint64_t norm_regs[CRC_MULTI_MAX_STREAMS];
+    size_t refl_count = 0;
+    size_t norm_count = 0;
+
+    for (size_t s = 0; s < ctx->count; s++) {
+        const crc_engine_ctx_t *engine = &ctx->streams[s].engine;
+        if (!ctx->streams[s].interleaved) {
+            continue;
+        }
+        if (engine->params.refin) {
+            refl_tables[refl_count] = engine->tables;
+            refl_regs[refl_count++] = engine->reg;
+        } else {
+            norm_tables[norm_count] = engine->tables;
+            norm_regs[norm_count++] = engine->reg;
+        }
+    }
+    if (refl_count + norm_count == 0) {
+        return;
+    }
+
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t le = load_le64(p);
+        uint64_t be = load_be64(p);
+        for (size_t i = 0; i < refl_count; i++) {
+            const uint64_t (*t)[256] = refl_tables[i];
+            uint64_t reg = refl_regs[i] ^ le;
+            refl_regs[i] = t[7][reg & 0xFF] ^ t[6][(reg >> 8) & 0xFF] ^
+                           t[5][(reg >> 16) & 0xFF] ^
+                           t[4][(reg >> 24) & 0xFF] ^
+                           t[3][(reg >> 32) & 0xFF] ^
+                           t[2][(reg >> 40) & 0xFF] ^
+                           t[1][(reg >> 48) & 0xFF] ^ t[0][reg >> 56];
+        }
+        for (size_t i = 0; i < norm_count; i++) {
+            const uint64_t (*t)[256] = norm_tables[i];
+            uint64_t reg = norm_regs[i] ^ be;
+            norm_regs[i] = t[7][reg >> 56] ^ t[6][(reg >> 48) & 0xFF] ^
+                           t[5][(reg >> 40) & 0xFF] ^
+                           t[4][(reg >> 32) & 0xFF] ^
+                           t[3][(reg >> 24) & 0xFF] ^
+                           t[2][(reg >> 16) & 0xFF] ^
+                           t[1][(reg >> 8) & 0xFF] ^ t[0][reg & 0xFF];
+        }
+    }
+    for (; len != 0; len--, p++) {
+        for (size_t i = 0; i < refl_count; i++) {
+            uint64_t reg = refl_regs[i];
+            refl_regs[i] = (reg >> 8) ^ refl_tables[i][0][(reg ^ *p) & 0xFF];
+        }
+        for (size_t i = 0; i < norm_count; i++) {
+            uint64_t reg = norm_regs[i];
+            norm_regs[i] = (reg << 8) ^ norm_tables[i][0][(reg >> 56) ^ *p];
+        }
+    }
+
+    refl_count = 0;
+    norm_count = 0;
+    for (size_t s = 0; s < ctx->count; s++) {
+        crc_engine_ctx_t *engine = &ctx->streams[s].engine;
+        if (!ctx->streams[s].interleaved) {
+            continue;
+        }
+        engine->reg = engine->params.refin ? refl_regs[refl_count++]
+                                           : norm_regs[norm_count++];
+    }
+}
+
+crc_error_t CRC_Multi_Init(crc_multi_ctx_t *ctx, const crc_t *crc_types,
+                           size_t count) {
+    if (ctx == NULL || crc_types == NULL) {
+        CRC_ERROR_SIMPLE("CRC multi: NULL pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    if (count == 0 || count > CRC_MULTI_MAX_STREAMS) {
+        CRC_ERROR("CRC multi: Invalid number of variants: %zu", count);
+        return CRC_ERROR_INVALID_TYPE;
+    }
+
+    ctx->count = count;
+    for (size_t s = 0; s < count; s++) {
+        crc_multi_stream_t *stream = &ctx->streams[s];
+        crc_error_t err = CRC_Init(&stream->ctx, crc_types[s]);
+        if (err != CRC_SUCCESS) {
+            return err;
+        }
+        // Hardware engines beat the tables, even interleaved
+        bool hardware = stream->ctx.hw_crc32c ||
+                        (stream->ctx.width >= 16 && CRC_clmul_available());
+        stream->interleaved = false;
+        if (!hardware) {
+            crc_params_t params;
+            err = CRC_getParams(crc_types[s], &params);
+            if (err == CRC_SUCCESS) {
+                err = CRC_Engine_Init(&stream->engine, &params);
+            }
+            if (err != CRC_SUCCESS) {
+                return err;
+            }
+            // Without tables (cache full) the variant runs on its own
+            stream->interleaved = stream->engine.tables != NULL;
+        }
+        CRC_DEBUG("CRC multi: Variant %u %s", crc_types[s],
+                  stream->interleaved ? "interleaved" : "on its own engine");
+    }
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Multi_Update(crc_multi_ctx_t *ctx, const void *data,
+                             size_t data_len) {
+    if (ctx == NULL || (data == NULL && data_len != 0)) {
+        CRC_ERROR_SIMPLE("CRC multi: NULL data pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    const uint8_t *p = (const uint8_t *)data;
+
+    while (data_len != 0) {
+        size_t len = (data_len < CRC_MULTI_BLOCK_LEN) ? data_len
+                                                      : CRC_MULTI_BLOCK_LEN;
+        for (size_t s = 0; s < ctx->count; s++) {
+            if (!ctx->streams[s].interleaved) {
+                CRC_Update(&ctx->streams[s].ctx, p, len);
+            }
+        }
+        crc_multi_interleave(ctx, p, len);
+        p += len;
+        data_len -= len;
+    }
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Multi_Finalize(const crc_multi_ctx_t *ctx, uint64_t *results) {
+    if (ctx == NULL || results == NULL) {
+        CRC_ERROR_SIMPLE("CRC multi: NULL result pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    for (size_t s = 0; s < ctx->count; s++) {
+        const crc_multi_stream_t *stream = &ctx->streams[s];
+        crc_error_t err;
+        if (stream->interleaved) {
+            err = CRC_Engine_Finalize(&stream->engine, &results[s]);
+        } else if (stream->ctx.width == 64) {
+            err = CRC64_Finalize(&stream->ctx, &results[s]);
+        } else {
+            uint32_t crc = 0;
+            err = CRC_Finalize(&stream->ctx, &crc);
+            results[s] = crc;
+        }
+        if (err != CRC_SUCCESS) {
+            return err;
+        }
+    }
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC_Calculate_multi(const void *data, size_t data_len,
+                                const crc_t *crc_types, size_t count,
+                                uint64_t *results) {
+    if (data == NULL || results == NULL) {
+        CRC_ERROR_SIMPLE("CRC multi: NULL data pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    crc_multi_ctx_t ctx;
+    crc_error_t err = CRC_Multi_Init(&ctx, crc_types, count);
+    if (err == CRC_SUCCESS && data_len == 0) {
+        // Same value as the one-shot functions: the seed, unreflected
+        CRC_WARN_SIMPLE("CRC multi: Input data length is zero");
+        for (size_t s = 0; s < count && err == CRC_SUCCESS; s++) {
+            crc_params_t params;
+            err = CRC_getParams(crc_types[s], &params);
+            if (err == CRC_SUCCESS) {
+                results[s] = params.init ^ params.xorout;
+            }
+        }
+        return err;
+    }
+    if (err == CRC_SUCCESS) {
+        err = CRC_Multi_Update(&ctx, data, data_len);
+    }
+    if (err == CRC_SUCCESS) {
+        err = CRC_Multi_Finalize(&ctx, results);
+    }
+    return err;
+}
+
+size_t CRC_Multi_Identify(const void *data, size_t data_len, uint64_t crc,
+                          crc_t *matches, size_t max_matches) {
+    crc_t candidates[CRC_MULTI_MAX_STREAMS];
+    uint64_t results[CRC_MULTI_MAX_STREAMS];
+    size_t found = 0;
+    int next = 0;
+
+    if (data == NULL) {
+        CRC_ERROR_SIMPLE("CRC multi: NULL data pointer");
+        return 0;
+    }
+    // Every variant that can hold crc, CRC_MULTI_MAX_STREAMS per pass
+    while (next < CRC_IMPL_COUNT) {
+        size_t count = 0;
+        for (; next < CRC_IMPL_COUNT && count < CRC_MULTI_MAX_STREAMS; next++) {
+            crc_t type = (crc_t)next;
+            uint8_t width = (type <= CRC8_LTE)         ? 8
+                            : (type <= CRC16_CDMA2000) ? 16
+                            : (type <= CRC32_XFER)     ? 32
+                                                       : 64;
+            if (width == 64 || (crc >> width) == 0) {
+                candidates[count++] = type;
+            }
+        }
+        if (count == 0 ||
+            CRC_Calculate_multi(data, data_len, candidates, count, results) !=
+                CRC_SUCCESS) {
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (results[i] == crc) {
+                if (found < max_matches && matches != NULL) {
+                    matches[found] = candidates[i];
+                }
+                found++;
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file crc_parallel.c
+ * @brief Multi-threaded CRC16 and CRC32 over large buffers
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "crc_parallel.h"
+
+#include <stdlib.h>
+
+/* Buffer cut into slices of slice_len bytes (the last one shorter), task i
+ * taking slices i, i + num_tasks, i + 2 * num_tasks... */
+typedef struct {
+    const uint8_t *data;
+    size_t data_len;
+    size_t slice_len;
+    size_t num_slices;
+    size_t num_tasks;  // At most the thread limit
+    crc_t crc_type;
+    uint32_t *crcs;  // CRC of every slice
+} crc_parallel_job_t;
+
+static inline size_t crc_parallel_slice_len(const crc_parallel_job_t *job,
+                                            size_t slice) {
+    size_t len = job->data_len - slice * job->slice_len;
+    return (len < job->slice_len) ? len : job->slice_len;
+}
+
+static void crc16_task(void *arg, size_t index) {
+    const crc_parallel_job_t *job = (const crc_parallel_job_t *)arg;
+    for (size_t i = index; i < job->num_slices; i += job->num_tasks) {
+        job->crcs[i] = CRC16(job->data + i * job->slice_len,
+                             crc_parallel_slice_len(job, i), job->crc_type);
+    }
+}
+
+static void crc32_task(void *arg, size_t index) {
+    const crc_parallel_job_t *job = (const crc_parallel_job_t *)arg;
+    for (size_t i = index; i < job->num_slices; i += job->num_tasks) {
+        job->crcs[i] = CRC32(job->data + i * job->slice_len,
+                             crc_parallel_slice_len(job, i), job->crc_type);
+    }
+}
+
+/*
+ * Computes the CRC of every slice on the pool, with no more tasks than
+ * threads allowed. Returns the number of slices, or 0 if the input is to be
+ * processed serially.
+ */
+static size_t crc_parallel_run(crc_parallel_job_t *job,
+                               const crc_parallel_config_t *config,
+                               thread_pool_task_t task) {
+    size_t threshold = CRC_PARALLEL_THRESHOLD;
+    size_t max_threads = 0;
+    size_t slice_len = 0;
+    thread_pool_t *pool = NULL;
+    if (config != NULL) {
+        threshold = (config->threshold != 0) ? config->threshold : threshold;
+        max_threads = config->num_threads;
+        slice_len = config->slice_len;
+        pool = config->pool;
+    }
+    if (job->data_len < threshold || job->data_len < 2) {
+        return 0;
+    }
+    if (pool == NULL) {
+        pool = thread_pool_get_default();
+    }
+    size_t num_threads = thread_pool_get_num_threads(pool);
+    if (max_threads != 0 && max_threads < num_threads) {
+        num_threads = max_threads;
+    }
+    if (num_threads <= 1) {
+        return 0;
+    }
+
+    if (slice_len == 0) {
+        slice_len = (job->data_len + num_threads - 1) / num_threads;
+    }
+    size_t num_slices = (job->data_len + slice_len - 1) / slice_len;
+    if (num_slices <= 1) {
+        return 0;
+    }
+    job->crcs = (uint32_t *)malloc(num_slices * sizeof(uint32_t));
+    if (job->crcs == NULL) {
+        return 0;
+    }
+    job->slice_len = slice_len;
+    job->num_slices = num_slices;
+    job->num_tasks = (num_slices < num_threads) ? num_slices : num_threads;
+    thread_pool_run(pool, task, job, job->num_tasks);
+    return num_slices;
+}
+
+crc_error_t CRC16_Calculate_parallel(const void *data, size_t data_len,
+                                     crc_t crc_type,
+                                     const crc_parallel_config_t *config,
+                                     uint16_t *result) {
+    if (data == NULL || result == NULL) {
+        CRC_ERROR_SIMPLE("CRC16: NULL data pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    if (crc_type > CRC16_CDMA2000 || crc_type < CRC16_XMODEM) {
+        CRC_ERROR("CRC16: Invalid CRC type: %u", crc_type);
+        return CRC_ERROR_INVALID_TYPE;
+    }
+
+    crc_parallel_job_t job = {
+        .data = (const uint8_t *)data,
+        .data_len = data_len,
+        .crc_type = crc_type,
+    };
+    size_t num_slices = crc_parallel_run(&job, config, crc16_task);
+    if (num_slices == 0) {
+        return CRC16_Calculate(data, data_len, crc_type, result);
+    }
+
+    uint16_t crc = (uint16_t)job.crcs[0];
+    for (size_t i = 1; i < num_slices; i++) {
+        crc = CRC16_combine(crc, (uint16_t)job.crcs[i],
+                            crc_parallel_slice_len(&job, i), crc_type);
+    }
+    free(job.crcs);
+    *result = crc;
+    return CRC_SUCCESS;
+}
+
+crc_error_t CRC32_Calculate_parallel(const void *data, size_t data_len,
+                                     crc_t crc_type,
+                                     const crc_parallel_config_t *config,
+                                     uint32_t *result) {
+    if (data == NULL || result == NULL) {
+        CRC_ERROR_SIMPLE("CRC32: NULL data pointer");
+        return CRC_ERROR_NULL_DATA;
+    }
+    if (crc_type > CRC32_XFER || crc_type < CRC32_D) {
+        CRC_ERROR("CRC32: Invalid CRC type: %u", crc_type);
+        return CRC_ERROR_INVALID_TYPE;
+    }
+
+    crc_parallel_job_t job = {
+        .data = (const uint8_t *)data,
+        .data_len = data_len,
+        .crc_type = crc_type,
+    };
+    size_t num_slices = crc_parallel_run(&job, config, crc32_task);
+    if (num_slices == 0) {
+        return CRC32_Calculate(data, data_len, crc_type, result);
+    }
+
+    uint32_t crc = job.crcs[0];
+    for (size_t i = 1; i < num_slices; i++) {
+        crc = CRC32_combine(crc, job.crcs[i], crc_parallel_slice_len(&job, i),
+                            crc_type);
+    }
+    free(job.crcs);
+    *result = crc;
+    return CRC_SUCCESS;
+}
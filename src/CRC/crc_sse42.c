@@ -0,0 +1,176 @@
+/**
+ * @file crc_sse42.c
+ * @brief CRC32C (Castagnoli) with the SSE4.2 crc32 instruction on x86-64
+ * processors
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "crc_sse42.h"
+
+#if CRC_SSE42_SUPPORTED
+
+#include <cpuid.h>
+#include <nmmintrin.h>
+#include <stdatomic.h>
+
+#define CRC_SSE42_TARGET __attribute__((target("sse4.2")))
+
+/**
+ * @brief Tables moving a register forward over the length of a block of
+ * zeros, one per register byte
+ *
+ * The CRC of A followed by B is the CRC of A shifted over the length of B,
+ * XORed with the CRC of B from a zero register.
+ */
+typedef struct {
+    uint32_t long_block[4][256];
+    uint32_t short_block[4][256];
+} crc_sse42_shifts_t;
+
+static crc_sse42_shifts_t crc_sse42_shifts;
+static atomic_int crc_sse42_shifts_state = 0;  // 0 empty, 1 building, 2 ready
+static atomic_int crc_sse42_cpu = -1;          // -1 unknown, 0 no, 1 yes
+
+bool CRC_sse42_available(void) {
+    int cpu = atomic_load_explicit(&crc_sse42_cpu, memory_order_relaxed);
+    if (cpu < 0) {
+        unsigned int eax, ebx, ecx, edx;
+        cpu = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+              (ecx & bit_SSE4_2) != 0;
+        atomic_store_explicit(&crc_sse42_cpu, cpu, memory_order_relaxed);
+    }
+    return cpu == 1;
+}
+
+/* Register after block_len zero bytes, starting from crc */
+CRC_SSE42_TARGET static uint32_t shift_zeros(uint32_t crc, size_t block_len) {
+    uint64_t reg = crc;
+    for (size_t i = 0; i < block_len; i += 8) {
+        reg = _mm_crc32_u64(reg, 0);
+    }
+    return (uint32_t)reg;
+}
+
+/*
+ * The shift is linear, so it is computed on each register bit and the
+ * entries of the tables are XORs of those.
+ */
+static void build_shift(uint32_t table[4][256], size_t block_len) {
+    uint32_t bits[32];
+    for (int bit = 0; bit < 32; bit++) {
+        bits[bit] = shift_zeros(1UL << bit, block_len);
+    }
+    for (int k = 0; k < 4; k++) {
+        for (int n = 0; n < 256; n++) {
+            uint32_t shifted = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                if (n & (1 << bit)) {
+                    shifted ^= bits[8 * k + bit];
+                }
+            }
+            table[k][n] = shifted;
+        }
+    }
+}
+
+/* Shift tables, or NULL while another thread computes them */
+static const crc_sse42_shifts_t *get_shifts(void) {
+    int state =
+        atomic_load_explicit(&crc_sse42_shifts_state, memory_order_acquire);
+    if (state == 0 && atomic_compare_exchange_strong_explicit(
+                          &crc_sse42_shifts_state, &state, 1,
+                          memory_order_acquire, memory_order_acquire)) {
+        build_shift(crc_sse42_shifts.long_block, CRC_SSE42_LONG_BLOCK);
+        build_shift(crc_sse42_shifts.short_block, CRC_SSE42_SHORT_BLOCK);
+        state = 2;
+        atomic_store_explicit(&crc_sse42_shifts_state, state,
+                              memory_order_release);
+    }
+    return (state == 2) ? &crc_sse42_shifts : NULL;
+}
+
+static inline uint32_t shift(const uint32_t table[4][256], uint32_t crc) {
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+           table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+static inline uint64_t load_le64(const uint8_t *p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+           ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+           ((uint64_t)p[7] << 56);
+}
+
+/* Three blocks of block_len bytes at p, interleaved, merged into crc */
+CRC_SSE42_TARGET static inline uint32_t crc_3way(
+    uint32_t crc, const uint8_t *p, size_t block_len,
+    const uint32_t table[4][256]) {
+    uint64_t crc0 = crc;
+    uint64_t crc1 = 0;
+    uint64_t crc2 = 0;
+    for (const uint8_t *end = p + block_len; p < end; p += 8) {
+        crc0 = _mm_crc32_u64(crc0, load_le64(p));
+        crc1 = _mm_crc32_u64(crc1, load_le64(p + block_len));
+        crc2 = _mm_crc32_u64(crc2, load_le64(p + 2 * block_len));
+    }
+    crc = shift(table, (uint32_t)crc0) ^ (uint32_t)crc1;
+    return shift(table, crc) ^ (uint32_t)crc2;
+}
+
+CRC_SSE42_TARGET uint32_t CRC32C_sse42_update(uint32_t crc,
+                                              const uint8_t *data,
+                                              size_t data_len) {
+    if (!CRC_sse42_available()) {
+        return crc;
+    }
+    const uint8_t *p = data;
+
+    // Bytes up to an 8-byte boundary
+    while (data_len > 0 && ((uintptr_t)p & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        data_len--;
+    }
+
+    const crc_sse42_shifts_t *shifts = get_shifts();
+    if (shifts != NULL) {
+        while (data_len >= 3 * CRC_SSE42_LONG_BLOCK) {
+            crc = crc_3way(crc, p, CRC_SSE42_LONG_BLOCK, shifts->long_block);
+            p += 3 * CRC_SSE42_LONG_BLOCK;
+            data_len -= 3 * CRC_SSE42_LONG_BLOCK;
+        }
+        while (data_len >= 3 * CRC_SSE42_SHORT_BLOCK) {
+            crc = crc_3way(crc, p, CRC_SSE42_SHORT_BLOCK,
+                           shifts->short_block);
+            p += 3 * CRC_SSE42_SHORT_BLOCK;
+            data_len -= 3 * CRC_SSE42_SHORT_BLOCK;
+        }
+    }
+
+    uint64_t crc64 = crc;
+    while (data_len >= 8) {
+        crc64 = _mm_crc32_u64(crc64, load_le64(p));
+        p += 8;
+        data_len -= 8;
+    }
+    crc = (uint32_t)crc64;
+    while (data_len-- != 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+
+#else
+
+bool CRC_sse42_available(void) { return false; }
+
+uint32_t CRC32C_sse42_update(uint32_t crc, const uint8_t *data,
+                             size_t data_len) {
+    (void)data;
+    (void)data_len;
+    return crc;
+}
+
+#endif
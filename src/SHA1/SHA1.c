@@ -15,7 +15,7 @@
  * 
  * @param ctx 
  */
-static void sha1_init(SHA1_ctx_t *ctx){
+void sha1_init(SHA1_ctx_t *ctx){
 	ctx->count[0] = ctx->count[1] = 0;
     ctx->hash[0] = 0x67452301;
     ctx->hash[1] = 0xEFCDAB89;
@@ -78,7 +78,7 @@ static void sha1_compile(SHA1_ctx_t *ctx){
  * @param data 
  * @param len 
  */
-static void sha1_hash(SHA1_ctx_t *ctx, const uint8_t *data, size_t len){
+void sha1_hash(SHA1_ctx_t *ctx, const uint8_t *data, size_t len){
 	uint32_t pos = (uint32_t)(ctx->count[0] & SHA1_MASK);
     uint32_t space = SHA1_BLOCK_SIZE_BYTES - pos;
     const unsigned char *sp = data;
@@ -103,7 +103,7 @@ static void sha1_hash(SHA1_ctx_t *ctx, const uint8_t *data, size_t len){
  * @param ctx 
  * @param hval 
  */
-static void sha1_end(SHA1_ctx_t *ctx, uint8_t *hval){
+void sha1_end(SHA1_ctx_t *ctx, uint8_t *hval){
     uint32_t    i = (uint32_t)(ctx->count[0] & SHA1_MASK);
     /* put bytes in the buffer in an order in which references to   */
     /* 32-bit words will put bytes with lower addresses into the    */
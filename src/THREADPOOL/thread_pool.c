@@ -0,0 +1,229 @@
+/**
+ * @file thread_pool.c
+ * @brief Minimal fork-join worker pool
+ * @version 0.1
+ * @date 2025-03-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "thread_pool.h"
+
+#include <stdlib.h>
+
+#if THREAD_POOL_USE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+struct thread_pool {
+    size_t num_threads;  // Workers plus the calling thread
+#if THREAD_POOL_USE_PTHREADS
+    pthread_t *workers;
+    size_t num_workers;        // Workers actually started
+    pthread_mutex_t run_lock;  // Serializes batches from different threads
+    pthread_mutex_t lock;      // Protects the batch state below
+    pthread_cond_t work_cond;  // Signalled when a batch starts or on shutdown
+    pthread_cond_t done_cond;  // Signalled when the last task of a batch ends
+    thread_pool_task_t task;
+    void *arg;
+    size_t num_tasks;
+    size_t next_task;     // Next task index to hand out
+    size_t pending;       // Tasks of the batch not finished yet
+    uint64_t generation;  // Incremented for every batch
+    bool shutdown;
+#endif
+};
+
+#if THREAD_POOL_USE_PTHREADS
+/* Pool whose task is running on this thread, to detect nested batches */
+static _Thread_local const thread_pool_t *current_pool = NULL;
+#endif
+
+size_t thread_pool_get_cpu_count(void) {
+#if THREAD_POOL_USE_PTHREADS && defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1) {
+        return 1;
+    }
+    if (count > THREAD_POOL_MAX_THREADS) {
+        return THREAD_POOL_MAX_THREADS;
+    }
+    return (size_t)count;
+#else
+    return 1;
+#endif
+}
+
+static void run_serial(thread_pool_task_t task, void *arg, size_t num_tasks) {
+    for (size_t i = 0; i < num_tasks; i++) {
+        task(arg, i);
+    }
+}
+
+#if THREAD_POOL_USE_PTHREADS
+
+/* Takes and runs tasks of the current batch until none is left. Called with
+ * the pool lock held, returns with it held */
+static void drain_tasks(thread_pool_t *pool) {
+    while (pool->next_task < pool->num_tasks) {
+        size_t index = pool->next_task++;
+        thread_pool_task_t task = pool->task;
+        void *arg = pool->arg;
+
+        pthread_mutex_unlock(&pool->lock);
+        task(arg, index);
+        pthread_mutex_lock(&pool->lock);
+
+        if (--pool->pending == 0) {
+            pthread_cond_broadcast(&pool->done_cond);
+        }
+    }
+}
+
+static void *worker_main(void *param) {
+    thread_pool_t *pool = (thread_pool_t *)param;
+    uint64_t seen_generation = 0;
+
+    current_pool = pool;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen_generation) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen_generation = pool->generation;
+        drain_tasks(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+#endif /* THREAD_POOL_USE_PTHREADS */
+
+thread_pool_t *thread_pool_create(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = thread_pool_get_cpu_count();
+    }
+    if (num_threads > THREAD_POOL_MAX_THREADS) {
+        num_threads = THREAD_POOL_MAX_THREADS;
+    }
+
+    thread_pool_t *pool = (thread_pool_t *)calloc(1, sizeof(thread_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+#if THREAD_POOL_USE_PTHREADS
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    pool->workers = (pthread_t *)calloc(num_threads, sizeof(pthread_t));
+    if (pool->workers == NULL) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    // A worker that fails to start only reduces the parallelism
+    for (size_t i = 0; i + 1 < num_threads; i++) {
+        if (pthread_create(&pool->workers[pool->num_workers], NULL,
+                           worker_main, pool) != 0) {
+            break;
+        }
+        pool->num_workers++;
+    }
+    pool->num_threads = pool->num_workers + 1;
+#else
+    pool->num_threads = 1;
+#endif
+
+    return pool;
+}
+
+void thread_pool_destroy(thread_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+#if THREAD_POOL_USE_PTHREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+    free(pool->workers);
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run_lock);
+#endif
+
+    free(pool);
+}
+
+size_t thread_pool_get_num_threads(const thread_pool_t *pool) {
+    return (pool == NULL) ? 1 : pool->num_threads;
+}
+
+void thread_pool_run(thread_pool_t *pool, thread_pool_task_t task, void *arg,
+                     size_t num_tasks) {
+    if (num_tasks == 0) {
+        return;
+    }
+
+#if THREAD_POOL_USE_PTHREADS
+    if (pool == NULL || pool->num_workers == 0 || num_tasks == 1 ||
+        current_pool == pool) {
+        run_serial(task, arg, num_tasks);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->num_tasks = num_tasks;
+    pool->next_task = 0;
+    pool->pending = num_tasks;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    // The caller works on the batch too, then waits for the stragglers
+    const thread_pool_t *outer_pool = current_pool;
+    current_pool = pool;
+    drain_tasks(pool);
+    current_pool = outer_pool;
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run_lock);
+#else
+    (void)pool;
+    run_serial(task, arg, num_tasks);
+#endif
+}
+
+#if THREAD_POOL_USE_PTHREADS
+static thread_pool_t *default_pool = NULL;
+static pthread_once_t default_pool_once = PTHREAD_ONCE_INIT;
+
+static void create_default_pool(void) { default_pool = thread_pool_create(0); }
+#endif
+
+thread_pool_t *thread_pool_get_default(void) {
+#if THREAD_POOL_USE_PTHREADS
+    pthread_once(&default_pool_once, create_default_pool);
+    return default_pool;
+#else
+    return NULL;
+#endif
+}
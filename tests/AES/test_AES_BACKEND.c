@@ -0,0 +1,169 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "AES_ni.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES backend cross-check tester";
+
+/* Covers partial and full 8-block pipeline groups */
+#define BACKEND_MAX_BLOCKS 37
+#define BACKEND_MAX_LEN (BACKEND_MAX_BLOCKS * AES_BLOCK_LEN)
+
+typedef struct {
+    size_t key_size;
+    size_t num_rounds;
+    size_t schedule_size;
+} BackendTestCase;
+
+static const BackendTestCase test_cases[] = {
+    {AES128_FIXED_KEY_SIZE, AES128_NUM_ROUNDS, AES128_KEY_EXP_SIZE},
+    {AES192_FIXED_KEY_SIZE, AES192_NUM_ROUNDS, AES192_KEY_EXP_SIZE},
+    {AES256_FIXED_KEY_SIZE, AES256_NUM_ROUNDS, AES256_KEY_EXP_SIZE},
+};
+
+#define BACKEND_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+/* Expands a key with the active backend through the public rekey API */
+static void expand_key(const BackendTestCase *tc, const uint8_t *key,
+                       uint8_t *round_keys, uint8_t *inv_round_keys) {
+    switch (tc->key_size) {
+        case AES128_FIXED_KEY_SIZE: {
+            AES128_ctx_t ctx;
+            AES128_rekey(&ctx, key);
+            memcpy(round_keys, ctx.round_keys, tc->schedule_size);
+            memcpy(inv_round_keys, ctx.inv_round_keys, tc->schedule_size);
+            break;
+        }
+        case AES192_FIXED_KEY_SIZE: {
+            AES192_ctx_t ctx;
+            AES192_rekey(&ctx, key);
+            memcpy(round_keys, ctx.round_keys, tc->schedule_size);
+            memcpy(inv_round_keys, ctx.inv_round_keys, tc->schedule_size);
+            break;
+        }
+        default: {
+            AES256_ctx_t ctx;
+            AES256_rekey(&ctx, key);
+            memcpy(round_keys, ctx.round_keys, tc->schedule_size);
+            memcpy(inv_round_keys, ctx.inv_round_keys, tc->schedule_size);
+            break;
+        }
+    }
+}
+
+/* Runs ECB/CBC in both directions, in place, with the active backend */
+static void run_modes(const BackendTestCase *tc, const uint8_t *rk,
+                      const uint8_t *dk, const uint8_t *iv,
+                      const uint8_t *data, size_t blocks,
+                      uint8_t out[4][BACKEND_MAX_LEN],
+                      uint8_t iv_out[2][AES_BLOCK_LEN]) {
+    size_t len = blocks * AES_BLOCK_LEN;
+
+    memcpy(out[0], data, len);
+    AES_ECB_encrypt_blocks(rk, tc->num_rounds, out[0], out[0], blocks);
+
+    memcpy(out[1], data, len);
+    AES_ECB_decrypt_blocks(dk, tc->num_rounds, out[1], out[1], blocks);
+
+    memcpy(out[2], data, len);
+    memcpy(iv_out[0], iv, AES_BLOCK_LEN);
+    AES_CBC_encrypt_blocks(rk, tc->num_rounds, iv_out[0], out[2], out[2],
+                           blocks);
+
+    memcpy(out[3], data, len);
+    memcpy(iv_out[1], iv, AES_BLOCK_LEN);
+    AES_CBC_decrypt_blocks(dk, tc->num_rounds, iv_out[1], out[3], out[3],
+                           blocks);
+}
+
+static bool run_single_test(const BackendTestCase *tc, size_t test_number) {
+    static const char *mode_names[4] = {"ECB encrypt", "ECB decrypt",
+                                        "CBC encrypt", "CBC decrypt"};
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    uint8_t data[BACKEND_MAX_LEN];
+    uint8_t rk_ref[AES256_KEY_EXP_SIZE], dk_ref[AES256_KEY_EXP_SIZE];
+    uint8_t rk_hw[AES256_KEY_EXP_SIZE], dk_hw[AES256_KEY_EXP_SIZE];
+    static uint8_t out_ref[4][BACKEND_MAX_LEN], out_hw[4][BACKEND_MAX_LEN];
+    uint8_t iv_ref[2][AES_BLOCK_LEN], iv_hw[2][AES_BLOCK_LEN];
+    bool test_passed = true;
+
+    printf("\n--- Test %zu: AES-%zu ---\n", test_number + 1,
+           tc->key_size * 8);
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+    fill_random(data, sizeof(data));
+
+    AES_set_backend(AES_BACKEND_PORTABLE);
+    expand_key(tc, key, rk_ref, dk_ref);
+    AES_set_backend(AES_BACKEND_AESNI);
+    expand_key(tc, key, rk_hw, dk_hw);
+
+    bool schedules_equal =
+        bytes_equal(rk_ref, tc->schedule_size, rk_hw, tc->schedule_size) &&
+        bytes_equal(dk_ref, tc->schedule_size, dk_hw, tc->schedule_size);
+    printf("  Key schedules: %s\n", schedules_equal ? "PASSED" : "FAILED");
+    test_passed &= schedules_equal;
+
+    for (size_t blocks = 1; blocks <= BACKEND_MAX_BLOCKS; blocks++) {
+        size_t len = blocks * AES_BLOCK_LEN;
+
+        AES_set_backend(AES_BACKEND_PORTABLE);
+        run_modes(tc, rk_ref, dk_ref, iv, data, blocks, out_ref, iv_ref);
+        AES_set_backend(AES_BACKEND_AESNI);
+        run_modes(tc, rk_ref, dk_ref, iv, data, blocks, out_hw, iv_hw);
+
+        for (size_t m = 0; m < 4; m++) {
+            if (!bytes_equal(out_ref[m], len, out_hw[m], len)) {
+                printf("  %s mismatch with %zu blocks\n", mode_names[m],
+                       blocks);
+                test_passed = false;
+            }
+        }
+        for (size_t m = 0; m < 2; m++) {
+            if (!bytes_equal(iv_ref[m], AES_BLOCK_LEN, iv_hw[m],
+                             AES_BLOCK_LEN)) {
+                printf("  %s chaining value mismatch with %zu blocks\n",
+                       mode_names[2 + m], blocks);
+                test_passed = false;
+            }
+        }
+    }
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x12345678);
+    bool all_tests_passed = true;
+
+    if (!AES_ni_available()) {
+        printf("AES-NI not available, nothing to cross-check\n");
+    } else {
+        for (size_t i = 0; i < BACKEND_TESTS_COUNT; i++) {
+            if (!run_single_test(&test_cases[i], i)) {
+                all_tests_passed = false;
+            }
+        }
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", BACKEND_TESTS_COUNT);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,176 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES256.h"
+#include "AES_ni.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES CBC parallel decryption tester";
+
+/* Large enough to be split across the thread pool, and not a multiple of
+ * the batch size */
+#define CBC_LARGE_BLOCKS \
+    ((2 * AES_CBC_PARALLEL_THRESHOLD / AES_BLOCK_LEN) + 5)
+#define CBC_LARGE_LEN (CBC_LARGE_BLOCKS * AES_BLOCK_LEN)
+
+#define CBC_SMALL_MAX_BLOCKS (2 * AES_CBC_BATCH_BLOCKS + 1)
+
+static uint8_t large_plain[CBC_LARGE_LEN];
+static uint8_t large_cipher[CBC_LARGE_LEN];
+static uint8_t large_out[CBC_LARGE_LEN];
+
+/* Every length around the batch size, against a block-by-block reference */
+static bool run_batch_test(void) {
+    uint8_t key[AES128_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    uint8_t plain[CBC_SMALL_MAX_BLOCKS * AES_BLOCK_LEN];
+    uint8_t cipher[CBC_SMALL_MAX_BLOCKS * AES_BLOCK_LEN];
+    uint8_t out[CBC_SMALL_MAX_BLOCKS * AES_BLOCK_LEN];
+    size_t out_len;
+    bool test_passed = true;
+    AES128_ctx_t ctx;
+
+    printf("\n--- Batch boundary test ---\n");
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+    fill_random(plain, sizeof(plain));
+    AES128_init_ctx(&ctx, key, iv);
+
+    for (size_t blocks = 1; blocks <= CBC_SMALL_MAX_BLOCKS; blocks++) {
+        size_t len = blocks * AES_BLOCK_LEN;
+
+        // Reference: P[i] = D(C[i]) ^ C[i-1], one block at a time
+        uint8_t chain[AES_BLOCK_LEN];
+        memcpy(chain, iv, AES_BLOCK_LEN);
+        for (size_t i = 0; i < blocks; i++) {
+            uint8_t *block = cipher + (AES_BLOCK_LEN * i);
+            memcpy(block, plain + (AES_BLOCK_LEN * i), AES_BLOCK_LEN);
+            AddRoundKey(block, chain);
+            AES_encrypt_block(ctx.round_keys, AES128_NUM_ROUNDS, block, block);
+            memcpy(chain, block, AES_BLOCK_LEN);
+        }
+
+        memcpy(out, cipher, len);
+        bool passed = (AES128_CBC_decrypt(&ctx, out, out, len, &out_len,
+                                          false) == AES_CODE_OK) &&
+                      (out_len == len) && bytes_equal(out, len, plain, len);
+        printf("  %zu blocks in place: %s\n", blocks,
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+    printf("Batch boundary test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool decrypt_large(AES256_ctx_t *ctx, const uint8_t *in, uint8_t *out) {
+    size_t out_len;
+    return (AES256_CBC_decrypt(ctx, (void *)in, out, CBC_LARGE_LEN, &out_len,
+                               false) == AES_CODE_OK) &&
+           (out_len == CBC_LARGE_LEN) &&
+           bytes_equal(out, CBC_LARGE_LEN, large_plain, CBC_LARGE_LEN);
+}
+
+/* Segments decrypted on several threads must chain exactly as one run */
+static bool run_large_buffer_test(void) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    size_t out_len;
+    bool test_passed = true;
+    bool passed;
+    AES256_ctx_t ctx;
+
+    printf("\n--- Large buffer test ---\n");
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+    fill_random(large_plain, sizeof(large_plain));
+
+    thread_pool_t *serial_pool = thread_pool_create(1);
+    thread_pool_t *parallel_pool = thread_pool_create(4);
+
+    AES_set_backend(AES_BACKEND_PORTABLE);
+    AES_set_thread_pool(serial_pool);
+    AES256_init_ctx(&ctx, key, iv);
+    AES256_CBC_encrypt(&ctx, large_plain, large_cipher, CBC_LARGE_LEN,
+                       &out_len, false);
+    passed = decrypt_large(&ctx, large_cipher, large_out);
+    printf("  Serial: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES_set_thread_pool(parallel_pool);
+    passed = decrypt_large(&ctx, large_cipher, large_out);
+    printf("  %zu threads: %s\n", thread_pool_get_num_threads(parallel_pool),
+           passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // In place, every segment's chaining value is overwritten by its
+    // neighbour
+    memcpy(large_out, large_cipher, CBC_LARGE_LEN);
+    passed = decrypt_large(&ctx, large_out, large_out);
+    printf("  %zu threads in place: %s\n",
+           thread_pool_get_num_threads(parallel_pool),
+           passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Streaming keeps chaining after a parallel update
+    size_t update_len, final_len;
+    AES256_decrypt_init(&ctx, AES_MODE_CBC, false);
+    AES256_update(&ctx, large_cipher, large_out, CBC_LARGE_LEN - 33,
+                  &update_len);
+    AES256_update(&ctx, large_cipher + CBC_LARGE_LEN - 33,
+                  large_out + update_len, 33, &final_len);
+    update_len += final_len;
+    AES256_final(&ctx, large_out + update_len, &final_len);
+    passed = (update_len + final_len == CBC_LARGE_LEN) &&
+             bytes_equal(large_out, CBC_LARGE_LEN, large_plain, CBC_LARGE_LEN);
+    printf("  Streaming: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    if (AES_set_backend(AES_BACKEND_AESNI)) {
+        AES256_init_ctx(&ctx, key, iv);
+        memcpy(large_out, large_cipher, CBC_LARGE_LEN);
+        passed = decrypt_large(&ctx, large_out, large_out);
+        printf("  AES-NI %zu threads in place: %s\n",
+               thread_pool_get_num_threads(parallel_pool),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+    AES_set_thread_pool(NULL);
+    thread_pool_destroy(parallel_pool);
+    thread_pool_destroy(serial_pool);
+
+    printf("Large buffer test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0xCBCD0001);
+    bool all_tests_passed = true;
+
+    if (!run_batch_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_large_buffer_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
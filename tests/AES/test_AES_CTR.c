@@ -0,0 +1,357 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "AES_ni.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES CTR mode tester";
+
+#define CTR_KAT_LEN 64
+
+/* Large enough to be split across the thread pool, and not block aligned */
+#define CTR_LARGE_LEN (2 * AES_CTR_PARALLEL_THRESHOLD + 13)
+
+/**
+ * @brief Known-answer vector (NIST SP 800-38A F.5.1, F.5.3 and F.5.5)
+ */
+typedef struct {
+    const char *description;
+    size_t key_size;
+    const char *key;
+    const char *cipher;
+} CTR_KAT_t;
+
+static const char *kat_counter = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+static const char *kat_plain =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+static const CTR_KAT_t kat_vectors[] = {
+    {"SP 800-38A CTR-AES128", AES128_FIXED_KEY_SIZE,
+     "2b7e151628aed2a6abf7158809cf4f3c",
+     "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+     "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"},
+    {"SP 800-38A CTR-AES192", AES192_FIXED_KEY_SIZE,
+     "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+     "1abc932417521ca24f2b0459fe7e6e0b090339ec0aa6faefd5ccc2c6f4ce8e94"
+     "1e36b26bd1ebc670d1bd1d665620abf74f78a7f6d29809585a97daec58c6b050"},
+    {"SP 800-38A CTR-AES256", AES256_FIXED_KEY_SIZE,
+     "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+     "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+     "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"},
+};
+
+#define KAT_VECTORS_COUNT (sizeof(kat_vectors) / sizeof(kat_vectors[0]))
+
+static uint8_t large_plain[CTR_LARGE_LEN];
+static uint8_t large_serial[CTR_LARGE_LEN];
+static uint8_t large_parallel[CTR_LARGE_LEN];
+
+static size_t hex_to_bytes(const char *hex, uint8_t *out) {
+    size_t len = strlen(hex) / 2;
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        sscanf(hex + (2 * i), "%2x", &byte);
+        out[i] = (uint8_t)byte;
+    }
+    return len;
+}
+
+/* Generic view of a context of any key size */
+typedef struct {
+    size_t key_size;
+    union {
+        AES128_ctx_t ctx128;
+        AES192_ctx_t ctx192;
+        AES256_ctx_t ctx256;
+    } u;
+} ctr_ctx_t;
+
+static void ctr_init(ctr_ctx_t *c, size_t key_size, const uint8_t *key,
+                     const uint8_t *iv) {
+    c->key_size = key_size;
+    switch (key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            AES128_init_ctx(&c->u.ctx128, key, iv);
+            break;
+        case AES192_FIXED_KEY_SIZE:
+            AES192_init_ctx(&c->u.ctx192, key, iv);
+            break;
+        default:
+            AES256_init_ctx(&c->u.ctx256, key, iv);
+            break;
+    }
+}
+
+static AES_errcode_t ctr_xcrypt(ctr_ctx_t *c, const uint8_t *in, uint8_t *out,
+                                size_t len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_CTR_xcrypt(&c->u.ctx128, in, out, len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_CTR_xcrypt(&c->u.ctx192, in, out, len);
+        default:
+            return AES256_CTR_xcrypt(&c->u.ctx256, in, out, len);
+    }
+}
+
+static void ctr_seek(ctr_ctx_t *c, uint64_t block_offset) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            AES128_CTR_seek(&c->u.ctx128, block_offset);
+            break;
+        case AES192_FIXED_KEY_SIZE:
+            AES192_CTR_seek(&c->u.ctx192, block_offset);
+            break;
+        default:
+            AES256_CTR_seek(&c->u.ctx256, block_offset);
+            break;
+    }
+}
+
+/* Known answer, piecewise processing and seeking for one vector */
+static bool run_kat_test(const CTR_KAT_t *kat, size_t test_number) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    uint8_t plain[CTR_KAT_LEN], cipher[CTR_KAT_LEN], out[CTR_KAT_LEN];
+    ctr_ctx_t ctx;
+    bool test_passed = true;
+    bool passed;
+
+    printf("\n--- Test %zu: %s ---\n", test_number + 1, kat->description);
+
+    hex_to_bytes(kat->key, key);
+    hex_to_bytes(kat_counter, iv);
+    hex_to_bytes(kat_plain, plain);
+    hex_to_bytes(kat->cipher, cipher);
+
+    ctr_init(&ctx, kat->key_size, key, iv);
+    passed = (ctr_xcrypt(&ctx, plain, out, CTR_KAT_LEN) == AES_CODE_OK) &&
+             bytes_equal(out, CTR_KAT_LEN, cipher, CTR_KAT_LEN);
+    printf("  Encrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Decryption is the same operation, done in place here
+    ctr_seek(&ctx, 0);
+    ctr_xcrypt(&ctx, out, out, CTR_KAT_LEN);
+    passed = bytes_equal(out, CTR_KAT_LEN, plain, CTR_KAT_LEN);
+    printf("  Decrypt in place: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Odd piece sizes carry unused keystream from one call to the next
+    static const size_t pieces[] = {1, 7, 16, 9, 31};
+    ctr_seek(&ctx, 0);
+    size_t pos = 0;
+    for (size_t i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+        ctr_xcrypt(&ctx, plain + pos, out + pos, pieces[i]);
+        pos += pieces[i];
+    }
+    passed = (pos == CTR_KAT_LEN) &&
+             bytes_equal(out, CTR_KAT_LEN, cipher, CTR_KAT_LEN);
+    printf("  Piecewise: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Random access into the middle of the message
+    ctr_seek(&ctx, 2);
+    ctr_xcrypt(&ctx, plain + 32, out, CTR_KAT_LEN - 32);
+    passed = bytes_equal(out, CTR_KAT_LEN - 32, cipher + 32, CTR_KAT_LEN - 32);
+    printf("  Seek: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Only the low counter_bits bits of the counter block may change */
+static bool run_counter_width_test(void) {
+    uint8_t key[AES128_FIXED_KEY_SIZE] = {0};
+    uint8_t iv[AES_BLOCK_LEN];
+    uint8_t zeros[3 * AES_BLOCK_LEN] = {0};
+    uint8_t keystream[3 * AES_BLOCK_LEN];
+    uint8_t expected[3 * AES_BLOCK_LEN];
+    uint8_t counter[AES_BLOCK_LEN];
+    size_t out_len;
+    bool test_passed = true;
+    bool passed;
+    AES128_ctx_t ctx;
+
+    printf("\n--- Counter width test ---\n");
+
+    // Low 32 bits about to wrap, next byte must not be touched by a carry
+    memset(iv, 0xA5, sizeof(iv));
+    memset(iv + 12, 0xFF, 4);
+    iv[15] = 0xFE;
+
+    AES128_init_ctx(&ctx, key, iv);
+    passed = (AES128_CTR_init(&ctx, 32) == AES_CODE_OK);
+    AES128_CTR_xcrypt(&ctx, zeros, keystream, sizeof(zeros));
+
+    // Expected keystream: ECB encryption of the explicit counter blocks
+    memcpy(counter, iv, AES_BLOCK_LEN);
+    memcpy(expected, counter, AES_BLOCK_LEN);
+    counter[15] = 0xFF;
+    memcpy(expected + AES_BLOCK_LEN, counter, AES_BLOCK_LEN);
+    memset(counter + 12, 0x00, 4);
+    memcpy(expected + (2 * AES_BLOCK_LEN), counter, AES_BLOCK_LEN);
+    AES128_ECB_encrypt(&ctx, expected, expected, sizeof(expected), &out_len,
+                       false);
+    passed &= bytes_equal(keystream, sizeof(keystream), expected,
+                          sizeof(expected));
+    printf("  32-bit counter wraps: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // The full 128-bit counter carries into the upper bytes instead
+    AES128_CTR_init(&ctx, 128);
+    AES128_CTR_seek(&ctx, 2);
+    memset(counter, 0xA5, 11);
+    counter[11] = 0xA6;
+    memset(counter + 12, 0x00, 4);
+    AES128_ECB_encrypt(&ctx, counter, expected, AES_BLOCK_LEN, &out_len,
+                       false);
+    AES128_CTR_xcrypt(&ctx, zeros, keystream, AES_BLOCK_LEN);
+    passed = bytes_equal(keystream, AES_BLOCK_LEN, expected, AES_BLOCK_LEN);
+    printf("  128-bit counter carries: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // A 3-bit counter wraps several times within one keystream batch
+    uint8_t small_zeros[20 * AES_BLOCK_LEN] = {0};
+    uint8_t small_keystream[20 * AES_BLOCK_LEN];
+    uint8_t small_expected[20 * AES_BLOCK_LEN];
+    memset(iv, 0xA5, sizeof(iv));
+    AES128_init_ctx(&ctx, key, iv);
+    AES128_CTR_init(&ctx, 3);
+    AES128_CTR_xcrypt(&ctx, small_zeros, small_keystream,
+                      sizeof(small_keystream));
+    for (size_t i = 0; i < 20; i++) {
+        uint8_t *block = small_expected + (AES_BLOCK_LEN * i);
+        memcpy(block, iv, AES_BLOCK_LEN);
+        block[15] = (uint8_t)((0xA5 & ~0x07) | ((0x05 + i) & 0x07));
+    }
+    AES128_ECB_encrypt(&ctx, small_expected, small_expected,
+                       sizeof(small_expected), &out_len, false);
+    passed = bytes_equal(small_keystream, sizeof(small_keystream),
+                         small_expected, sizeof(small_expected));
+    printf("  3-bit counter wraps: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    passed = (AES128_CTR_init(&ctx, 0) == AES_CODE_INVALID_ARGUMENT) &&
+             (AES128_CTR_init(&ctx, 129) == AES_CODE_INVALID_ARGUMENT) &&
+             (AES128_CTR_xcrypt(&ctx, zeros, keystream, 0) ==
+              AES_CODE_EMPTY_INPUT_BUFFER);
+    printf("  Invalid arguments rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Counter width test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Multi-threaded and hardware results must match the serial reference */
+static bool run_large_buffer_test(void) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    bool test_passed = true;
+    bool passed;
+    AES256_ctx_t ctx;
+
+    printf("\n--- Large buffer test ---\n");
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+    fill_random(large_plain, sizeof(large_plain));
+    // Counter close to wrapping in its low 64 bits
+    memset(iv + 8, 0xFF, 7);
+
+    thread_pool_t *serial_pool = thread_pool_create(1);
+    thread_pool_t *parallel_pool = thread_pool_create(4);
+
+    AES_set_backend(AES_BACKEND_PORTABLE);
+    AES_set_thread_pool(serial_pool);
+    AES256_init_ctx(&ctx, key, iv);
+    AES256_CTR_xcrypt(&ctx, large_plain, large_serial, 5);
+    AES256_CTR_xcrypt(&ctx, large_plain + 5, large_serial + 5,
+                      CTR_LARGE_LEN - 5);
+
+    AES_set_thread_pool(parallel_pool);
+    AES256_init_ctx(&ctx, key, iv);
+    AES256_CTR_xcrypt(&ctx, large_plain, large_parallel, 5);
+    AES256_CTR_xcrypt(&ctx, large_plain + 5, large_parallel + 5,
+                      CTR_LARGE_LEN - 5);
+    passed = bytes_equal(large_serial, CTR_LARGE_LEN, large_parallel,
+                         CTR_LARGE_LEN);
+    printf("  %zu threads match serial: %s\n",
+           thread_pool_get_num_threads(parallel_pool),
+           passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // The counter must continue after a parallel call
+    uint8_t tail[AES_BLOCK_LEN];
+    AES256_CTR_seek(&ctx, 1);
+    AES256_CTR_xcrypt(&ctx, large_plain + AES_BLOCK_LEN, large_parallel,
+                      CTR_LARGE_LEN - (2 * AES_BLOCK_LEN));
+    AES256_CTR_xcrypt(&ctx, large_plain + CTR_LARGE_LEN - AES_BLOCK_LEN, tail,
+                      AES_BLOCK_LEN);
+    passed = bytes_equal(large_parallel, CTR_LARGE_LEN - (2 * AES_BLOCK_LEN),
+                         large_serial + AES_BLOCK_LEN,
+                         CTR_LARGE_LEN - (2 * AES_BLOCK_LEN)) &&
+             bytes_equal(tail, AES_BLOCK_LEN,
+                         large_serial + CTR_LARGE_LEN - AES_BLOCK_LEN,
+                         AES_BLOCK_LEN);
+    printf("  Seek and continue: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    if (AES_set_backend(AES_BACKEND_AESNI)) {
+        AES256_init_ctx(&ctx, key, iv);
+        AES256_CTR_xcrypt(&ctx, large_plain, large_parallel, 5);
+        AES256_CTR_xcrypt(&ctx, large_plain + 5, large_parallel + 5,
+                          CTR_LARGE_LEN - 5);
+        passed = bytes_equal(large_serial, CTR_LARGE_LEN, large_parallel,
+                             CTR_LARGE_LEN);
+        printf("  AES-NI matches portable: %s\n", passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+    AES_set_thread_pool(NULL);
+    thread_pool_destroy(parallel_pool);
+    thread_pool_destroy(serial_pool);
+
+    printf("Large buffer test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x5EED1234);
+    bool all_tests_passed = true;
+
+    for (size_t i = 0; i < KAT_VECTORS_COUNT; i++) {
+        if (!run_kat_test(&kat_vectors[i], i)) {
+            all_tests_passed = false;
+        }
+    }
+
+    if (!run_counter_width_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_large_buffer_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", KAT_VECTORS_COUNT + 2);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,465 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "AES_ni.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES GCM mode tester";
+
+#define GCM_MAX_KAT_LEN 64
+
+/* Not block aligned, and long enough for many 8-block batches */
+#define GCM_LARGE_LEN (256 * 1024 + 7)
+
+/**
+ * @brief Known-answer vector (McGrew and Viega, "The Galois/Counter Mode of
+ * Operation", test cases 1, 2, 4, 5, 6, 10 and 16)
+ */
+typedef struct {
+    const char *description;
+    size_t key_size;
+    const char *key;
+    const char *iv;
+    const char *aad;
+    const char *plain;
+    const char *cipher;
+    const char *tag;
+} GCM_KAT_t;
+
+static const char *kat_key =
+    "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308";
+static const char *kat_aad = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+static const char *kat_plain =
+    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39";
+
+static const GCM_KAT_t kat_vectors[] = {
+    {"Test case 1: AES-128, empty", AES128_FIXED_KEY_SIZE,
+     "00000000000000000000000000000000", "000000000000000000000000", "", "",
+     "", "58e2fccefa7e3061367f1d57a4e7455a"},
+    {"Test case 2: AES-128, one block", AES128_FIXED_KEY_SIZE,
+     "00000000000000000000000000000000", "000000000000000000000000", "",
+     "00000000000000000000000000000000", "0388dace60b6a392f328c2b971b2fe78",
+     "ab6e47d42cec13bdf53a67b21257bddf"},
+    {"Test case 4: AES-128 with AAD", AES128_FIXED_KEY_SIZE, NULL,
+     "cafebabefacedbaddecaf888", NULL, NULL,
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+     "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+     "5bc94fbc3221a5db94fae95ae7121a47"},
+    {"Test case 5: AES-128, 64-bit IV", AES128_FIXED_KEY_SIZE, NULL,
+     "cafebabefacedbad", NULL, NULL,
+     "61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c7423"
+     "73806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+     "3612d2e79e3b0785561be14aaca2fccb"},
+    {"Test case 6: AES-128, 480-bit IV", AES128_FIXED_KEY_SIZE, NULL,
+     "9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728"
+     "c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+     NULL, NULL,
+     "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca7"
+     "01e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+     "619cc5aefffe0bfa462af43c1699d050"},
+    {"Test case 10: AES-192 with AAD", AES192_FIXED_KEY_SIZE, NULL,
+     "cafebabefacedbaddecaf888", NULL, NULL,
+     "3980ca0b3c00e841eb06fac4872a2757859e1ceaa6efd984628593b40ca1e19c"
+     "7d773d00c144c525ac619d18c84a3f4718e2448b2fe324d9ccda2710",
+     "2519498e80f1478f37ba55bd6d27618c"},
+    {"Test case 16: AES-256 with AAD", AES256_FIXED_KEY_SIZE, NULL,
+     "cafebabefacedbaddecaf888", NULL, NULL,
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+     "76fc6ece0f4e1768cddf8853bb2d551b"},
+};
+
+#define KAT_VECTORS_COUNT (sizeof(kat_vectors) / sizeof(kat_vectors[0]))
+
+static uint8_t large_plain[GCM_LARGE_LEN];
+static uint8_t large_portable[GCM_LARGE_LEN];
+static uint8_t large_hardware[GCM_LARGE_LEN];
+
+static size_t hex_to_bytes(const char *hex, uint8_t *out) {
+    size_t len = strlen(hex) / 2;
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        sscanf(hex + (2 * i), "%2x", &byte);
+        out[i] = (uint8_t)byte;
+    }
+    return len;
+}
+
+/* Generic view of a context of any key size */
+typedef struct {
+    size_t key_size;
+    union {
+        AES128_ctx_t ctx128;
+        AES192_ctx_t ctx192;
+        AES256_ctx_t ctx256;
+    } u;
+} gcm_ctx_t;
+
+static void gcm_ctx_init(gcm_ctx_t *c, size_t key_size, const uint8_t *key) {
+    c->key_size = key_size;
+    switch (key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            AES128_init_ctx(&c->u.ctx128, key, NULL);
+            break;
+        case AES192_FIXED_KEY_SIZE:
+            AES192_init_ctx(&c->u.ctx192, key, NULL);
+            break;
+        default:
+            AES256_init_ctx(&c->u.ctx256, key, NULL);
+            break;
+    }
+}
+
+static void gcm_rekey(gcm_ctx_t *c, const uint8_t *key) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            AES128_rekey(&c->u.ctx128, key);
+            break;
+        case AES192_FIXED_KEY_SIZE:
+            AES192_rekey(&c->u.ctx192, key);
+            break;
+        default:
+            AES256_rekey(&c->u.ctx256, key);
+            break;
+    }
+}
+
+static AES_errcode_t gcm_start(gcm_ctx_t *c, bool encrypt, const uint8_t *iv,
+                               size_t iv_len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return encrypt ? AES128_GCM_encrypt_init(&c->u.ctx128, iv, iv_len)
+                           : AES128_GCM_decrypt_init(&c->u.ctx128, iv, iv_len);
+        case AES192_FIXED_KEY_SIZE:
+            return encrypt ? AES192_GCM_encrypt_init(&c->u.ctx192, iv, iv_len)
+                           : AES192_GCM_decrypt_init(&c->u.ctx192, iv, iv_len);
+        default:
+            return encrypt ? AES256_GCM_encrypt_init(&c->u.ctx256, iv, iv_len)
+                           : AES256_GCM_decrypt_init(&c->u.ctx256, iv, iv_len);
+    }
+}
+
+static AES_errcode_t gcm_aad(gcm_ctx_t *c, const uint8_t *aad, size_t len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_GCM_update_aad(&c->u.ctx128, aad, len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_GCM_update_aad(&c->u.ctx192, aad, len);
+        default:
+            return AES256_GCM_update_aad(&c->u.ctx256, aad, len);
+    }
+}
+
+static AES_errcode_t gcm_update(gcm_ctx_t *c, const uint8_t *in, uint8_t *out,
+                                size_t len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_GCM_update(&c->u.ctx128, in, out, len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_GCM_update(&c->u.ctx192, in, out, len);
+        default:
+            return AES256_GCM_update(&c->u.ctx256, in, out, len);
+    }
+}
+
+static AES_errcode_t gcm_encrypt_final(gcm_ctx_t *c, uint8_t *tag,
+                                       size_t tag_len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_GCM_encrypt_final(&c->u.ctx128, tag, tag_len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_GCM_encrypt_final(&c->u.ctx192, tag, tag_len);
+        default:
+            return AES256_GCM_encrypt_final(&c->u.ctx256, tag, tag_len);
+    }
+}
+
+static AES_errcode_t gcm_decrypt(gcm_ctx_t *c, const uint8_t *iv,
+                                 size_t iv_len, const uint8_t *aad,
+                                 size_t aad_len, const uint8_t *in,
+                                 uint8_t *out, size_t len, const uint8_t *tag,
+                                 size_t tag_len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_GCM_decrypt(&c->u.ctx128, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_GCM_decrypt(&c->u.ctx192, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+        default:
+            return AES256_GCM_decrypt(&c->u.ctx256, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+    }
+}
+
+static AES_errcode_t gcm_encrypt(gcm_ctx_t *c, const uint8_t *iv,
+                                 size_t iv_len, const uint8_t *aad,
+                                 size_t aad_len, const uint8_t *in,
+                                 uint8_t *out, size_t len, uint8_t *tag,
+                                 size_t tag_len) {
+    switch (c->key_size) {
+        case AES128_FIXED_KEY_SIZE:
+            return AES128_GCM_encrypt(&c->u.ctx128, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+        case AES192_FIXED_KEY_SIZE:
+            return AES192_GCM_encrypt(&c->u.ctx192, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+        default:
+            return AES256_GCM_encrypt(&c->u.ctx256, iv, iv_len, aad, aad_len,
+                                      in, out, len, tag, tag_len);
+    }
+}
+
+/* One-shot, streaming, in-place and tampered messages for one vector */
+static bool run_kat_test(const GCM_KAT_t *kat, size_t test_number) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[GCM_MAX_KAT_LEN], aad[GCM_MAX_KAT_LEN];
+    uint8_t plain[GCM_MAX_KAT_LEN], cipher[GCM_MAX_KAT_LEN];
+    uint8_t out[GCM_MAX_KAT_LEN];
+    uint8_t tag[AES_GCM_TAG_LEN], out_tag[AES_GCM_TAG_LEN];
+    gcm_ctx_t ctx;
+    bool test_passed = true;
+    bool passed;
+
+    printf("\n--- Test %zu: %s ---\n", test_number + 1, kat->description);
+
+    hex_to_bytes((kat->key != NULL) ? kat->key : kat_key, key);
+    size_t iv_len = hex_to_bytes(kat->iv, iv);
+    size_t aad_len = hex_to_bytes((kat->aad != NULL) ? kat->aad : kat_aad, aad);
+    size_t len =
+        hex_to_bytes((kat->plain != NULL) ? kat->plain : kat_plain, plain);
+    hex_to_bytes(kat->cipher, cipher);
+    hex_to_bytes(kat->tag, tag);
+
+    gcm_ctx_init(&ctx, kat->key_size, key);
+    passed = (gcm_encrypt(&ctx, iv, iv_len, aad, aad_len, plain, out, len,
+                          out_tag, AES_GCM_TAG_LEN) == AES_CODE_OK) &&
+             bytes_equal(out, len, cipher, len) &&
+             bytes_equal(out_tag, AES_GCM_TAG_LEN, tag, AES_GCM_TAG_LEN);
+    printf("  Encrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    passed = (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out, len,
+                          tag, AES_GCM_TAG_LEN) == AES_CODE_OK) &&
+             bytes_equal(out, len, plain, len);
+    printf("  Decrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Odd piece sizes for both the AAD and the data, encrypted in place
+    static const size_t pieces[] = {1, 15, 3, 17, 7, 32};
+    memcpy(out, plain, len);
+    gcm_start(&ctx, true, iv, iv_len);
+    size_t pos = 0;
+    for (size_t i = 0; pos < aad_len; i++) {
+        size_t piece = pieces[i % 6];
+        if (piece > aad_len - pos) {
+            piece = aad_len - pos;
+        }
+        gcm_aad(&ctx, aad + pos, piece);
+        pos += piece;
+    }
+    pos = 0;
+    for (size_t i = 0; pos < len; i++) {
+        size_t piece = pieces[(i + 3) % 6];
+        if (piece > len - pos) {
+            piece = len - pos;
+        }
+        gcm_update(&ctx, out + pos, out + pos, piece);
+        pos += piece;
+    }
+    gcm_encrypt_final(&ctx, out_tag, AES_GCM_TAG_LEN);
+    passed = bytes_equal(out, len, cipher, len) &&
+             bytes_equal(out_tag, AES_GCM_TAG_LEN, tag, AES_GCM_TAG_LEN);
+    printf("  Streaming in place: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Truncated tags are the leading bytes of the full tag
+    passed = (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out, len,
+                          tag, 12) == AES_CODE_OK) &&
+             (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out, len,
+                          tag, 3) == AES_CODE_INVALID_ARGUMENT);
+    printf("  Truncated tag: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // GHASH key of a context used with another key first, then rekeyed
+    uint8_t other_key[AES256_FIXED_KEY_SIZE];
+    memset(other_key, 0xA5, sizeof(other_key));
+    gcm_ctx_init(&ctx, kat->key_size, other_key);
+    passed = gcm_encrypt(&ctx, iv, iv_len, aad, aad_len, plain, out, len,
+                         out_tag, AES_GCM_TAG_LEN) == AES_CODE_OK;
+    gcm_rekey(&ctx, key);
+    passed &= (gcm_encrypt(&ctx, iv, iv_len, aad, aad_len, plain, out, len,
+                           out_tag, AES_GCM_TAG_LEN) == AES_CODE_OK) &&
+              bytes_equal(out, len, cipher, len) &&
+              bytes_equal(out_tag, AES_GCM_TAG_LEN, tag, AES_GCM_TAG_LEN);
+    printf("  After rekey: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Any changed bit is detected and no plaintext is released
+    uint8_t bad_tag[AES_GCM_TAG_LEN];
+    memcpy(bad_tag, tag, AES_GCM_TAG_LEN);
+    bad_tag[AES_GCM_TAG_LEN - 1] ^= 0x01;
+    passed = (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out, len,
+                          bad_tag, AES_GCM_TAG_LEN) ==
+              AES_CODE_AUTHENTICATION_FAILED);
+    if (len > 0) {
+        static const uint8_t zeros[GCM_MAX_KAT_LEN] = {0};
+        cipher[len / 2] ^= 0x80;
+        passed &= (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out,
+                               len, tag, AES_GCM_TAG_LEN) ==
+                   AES_CODE_AUTHENTICATION_FAILED) &&
+                  bytes_equal(out, len, zeros, len);
+        cipher[len / 2] ^= 0x80;
+    }
+    if (aad_len > 0) {
+        aad[0] ^= 0x01;
+        passed &= (gcm_decrypt(&ctx, iv, iv_len, aad, aad_len, cipher, out,
+                               len, tag, AES_GCM_TAG_LEN) ==
+                   AES_CODE_AUTHENTICATION_FAILED);
+    }
+    printf("  Tampering detected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Calls out of order and malformed parameters are rejected */
+static bool run_argument_test(void) {
+    uint8_t key[AES128_FIXED_KEY_SIZE] = {0};
+    uint8_t iv[AES_GCM_IV_LEN] = {0};
+    uint8_t data[AES_BLOCK_LEN] = {0};
+    uint8_t tag[AES_GCM_TAG_LEN];
+    AES128_ctx_t ctx;
+
+    printf("\n--- Argument test ---\n");
+
+    AES128_init_ctx(&ctx, key, NULL);
+    bool passed =
+        (AES128_GCM_encrypt_init(&ctx, iv, 0) == AES_CODE_INVALID_ARGUMENT) &&
+        (AES128_GCM_encrypt_init(&ctx, iv, sizeof(iv)) == AES_CODE_OK) &&
+        (AES128_GCM_update(&ctx, data, data, sizeof(data)) == AES_CODE_OK) &&
+        (AES128_GCM_update_aad(&ctx, data, sizeof(data)) ==
+         AES_CODE_INVALID_ARGUMENT) &&
+        (AES128_GCM_encrypt_final(&ctx, tag, 17) ==
+         AES_CODE_INVALID_ARGUMENT) &&
+        (AES128_GCM_encrypt(&ctx, iv, sizeof(iv), NULL, 0, data, data,
+                            sizeof(data), tag, 2) == AES_CODE_INVALID_ARGUMENT);
+    printf("Argument test result: %s\n", passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+/* Encrypts large_plain in uneven pieces with the current backend */
+static void encrypt_large(const uint8_t *key, const uint8_t *iv,
+                          const uint8_t *aad, size_t aad_len, uint8_t *out,
+                          uint8_t *tag) {
+    static const size_t pieces[] = {5, 4096, 129, 65536, 1};
+    AES256_ctx_t ctx;
+    AES256_init_ctx(&ctx, key, NULL);
+    AES256_GCM_encrypt_init(&ctx, iv, AES_GCM_IV_LEN);
+    AES256_GCM_update_aad(&ctx, aad, aad_len);
+    size_t pos = 0;
+    for (size_t i = 0; pos < GCM_LARGE_LEN; i++) {
+        size_t piece = pieces[i % 5];
+        if (piece > GCM_LARGE_LEN - pos) {
+            piece = GCM_LARGE_LEN - pos;
+        }
+        AES256_GCM_update(&ctx, large_plain + pos, out + pos, piece);
+        pos += piece;
+    }
+    AES256_GCM_encrypt_final(&ctx, tag, AES_GCM_TAG_LEN);
+}
+
+/* The carry-less multiply backend must match the table-driven reference */
+static bool run_large_buffer_test(void) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_GCM_IV_LEN];
+    uint8_t aad[100];
+    uint8_t tag[AES_GCM_TAG_LEN], hw_tag[AES_GCM_TAG_LEN];
+    bool test_passed = true;
+    bool passed;
+    AES256_ctx_t ctx;
+
+    printf("\n--- Large buffer test ---\n");
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+    fill_random(aad, sizeof(aad));
+    fill_random(large_plain, sizeof(large_plain));
+    // 32-bit counter about to wrap: GCM must not carry into the IV bytes
+    memset(iv + 8, 0xFF, 4);
+
+    AES_set_backend(AES_BACKEND_PORTABLE);
+    encrypt_large(key, iv, aad, sizeof(aad), large_portable, tag);
+
+    AES256_init_ctx(&ctx, key, NULL);
+    passed = (AES256_GCM_decrypt(&ctx, iv, AES_GCM_IV_LEN, aad, sizeof(aad),
+                                 large_portable, large_hardware,
+                                 GCM_LARGE_LEN, tag,
+                                 AES_GCM_TAG_LEN) == AES_CODE_OK) &&
+             bytes_equal(large_hardware, GCM_LARGE_LEN, large_plain,
+                         GCM_LARGE_LEN);
+    printf("  Portable round trip: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    if (AES_set_backend(AES_BACKEND_AESNI)) {
+        encrypt_large(key, iv, aad, sizeof(aad), large_hardware, hw_tag);
+        passed = bytes_equal(large_hardware, GCM_LARGE_LEN, large_portable,
+                             GCM_LARGE_LEN) &&
+                 bytes_equal(hw_tag, AES_GCM_TAG_LEN, tag, AES_GCM_TAG_LEN);
+        printf("  AES-NI matches portable: %s\n", passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+
+        AES256_init_ctx(&ctx, key, NULL);
+        passed = (AES256_GCM_decrypt(&ctx, iv, AES_GCM_IV_LEN, aad,
+                                     sizeof(aad), large_hardware,
+                                     large_hardware, GCM_LARGE_LEN, tag,
+                                     AES_GCM_TAG_LEN) == AES_CODE_OK) &&
+                 bytes_equal(large_hardware, GCM_LARGE_LEN, large_plain,
+                             GCM_LARGE_LEN);
+        printf("  AES-NI round trip in place: %s\n",
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+    printf("Large buffer test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x5EED4321);
+    bool all_tests_passed = true;
+
+    for (size_t i = 0; i < KAT_VECTORS_COUNT; i++) {
+        if (!run_kat_test(&kat_vectors[i], i)) {
+            all_tests_passed = false;
+        }
+    }
+
+    if (!run_argument_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_large_buffer_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", KAT_VECTORS_COUNT + 2);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,277 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES known-answer tester";
+
+#define KAT_MAX_DATA_LEN 64
+
+/**
+ * @brief Known-answer vector (FIPS-197 appendix C and NIST SP 800-38A F.1/F.2)
+ */
+typedef struct {
+    const char *description;
+    size_t key_size;
+    const char *key;
+    const char *iv;
+    const char *plain;
+    const char *ecb_cipher;
+    const char *cbc_cipher;
+} AES_KAT_t;
+
+static const AES_KAT_t kat_vectors[] = {
+    {"FIPS-197 C.1 (AES-128)", AES128_FIXED_KEY_SIZE,
+     "000102030405060708090a0b0c0d0e0f", NULL,
+     "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a",
+     NULL},
+    {"FIPS-197 C.2 (AES-192)", AES192_FIXED_KEY_SIZE,
+     "000102030405060708090a0b0c0d0e0f1011121314151617", NULL,
+     "00112233445566778899aabbccddeeff", "dda97ca4864cdfe06eaf70a0ec0d7191",
+     NULL},
+    {"FIPS-197 C.3 (AES-256)", AES256_FIXED_KEY_SIZE,
+     "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", NULL,
+     "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089",
+     NULL},
+    {"SP 800-38A (AES-128)", AES128_FIXED_KEY_SIZE,
+     "2b7e151628aed2a6abf7158809cf4f3c", "000102030405060708090a0b0c0d0e0f",
+     "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+     "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+     "3ad77bb40d7a3660a89ecaf32466ef97f5d3d58503b9699de785895a96fdbaaf"
+     "43b1cd7f598ece23881b00e3ed0306887b0c785e27e8ad3f8223207104725dd4",
+     "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+     "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7"},
+    {"SP 800-38A (AES-192)", AES192_FIXED_KEY_SIZE,
+     "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+     "000102030405060708090a0b0c0d0e0f",
+     "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+     "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+     "bd334f1d6e45f25ff712a214571fa5cc974104846d0ad3ad7734ecb3ecee4eef"
+     "ef7afd2270e2e60adce0ba2face6444e9a4b41ba738d6c72fb16691603c18e0e",
+     "4f021db243bc633d7178183a9fa071e8b4d9ada9ad7dedf4e5e738763f69145a"
+     "571b242012fb7ae07fa9baac3df102e008b0e27988598881d920a9e64f5615cd"},
+    {"SP 800-38A (AES-256)", AES256_FIXED_KEY_SIZE,
+     "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+     "000102030405060708090a0b0c0d0e0f",
+     "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+     "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710",
+     "f3eed1bdb5d2a03c064b5a7e3db181f8591ccb10d410ed26dc5ba74a31362870"
+     "b6ed21b99ca6f4f9f153e7b1beafed1d23304b7a39f9f3ff067d8d8f9e24ecc7",
+     "f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d"
+     "39f23369a9d9bacfa530e26304231461b2eb05e2c39be9fcda6c19078c6a9d1b"},
+};
+
+#define KAT_VECTORS_COUNT (sizeof(kat_vectors) / sizeof(kat_vectors[0]))
+
+static size_t hex_to_bytes(const char *hex, uint8_t *out) {
+    size_t len = strlen(hex) / 2;
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        sscanf(hex + (2 * i), "%2x", &byte);
+        out[i] = (uint8_t)byte;
+    }
+    return len;
+}
+
+/**
+ * @brief Runs one cipher operation for the key size of the vector
+ */
+static AES_errcode_t kat_crypt(size_t key_size, bool cbc, bool encrypt,
+                               const uint8_t *key, const uint8_t *iv,
+                               uint8_t *in, uint8_t *out, size_t len,
+                               size_t *out_len) {
+    switch (key_size) {
+        case AES128_FIXED_KEY_SIZE: {
+            AES128_ctx_t ctx;
+            AES128_init_ctx(&ctx, key, iv);
+            if (cbc) {
+                return encrypt ? AES128_CBC_encrypt(&ctx, in, out, len,
+                                                    out_len, false)
+                               : AES128_CBC_decrypt(&ctx, in, out, len,
+                                                    out_len, false);
+            }
+            return encrypt
+                       ? AES128_ECB_encrypt(&ctx, in, out, len, out_len, false)
+                       : AES128_ECB_decrypt(&ctx, in, out, len, out_len, false);
+        }
+        case AES192_FIXED_KEY_SIZE: {
+            AES192_ctx_t ctx;
+            AES192_init_ctx(&ctx, key, iv);
+            if (cbc) {
+                return encrypt ? AES192_CBC_encrypt(&ctx, in, out, len,
+                                                    out_len, false)
+                               : AES192_CBC_decrypt(&ctx, in, out, len,
+                                                    out_len, false);
+            }
+            return encrypt
+                       ? AES192_ECB_encrypt(&ctx, in, out, len, out_len, false)
+                       : AES192_ECB_decrypt(&ctx, in, out, len, out_len, false);
+        }
+        default: {
+            AES256_ctx_t ctx;
+            AES256_init_ctx(&ctx, key, iv);
+            if (cbc) {
+                return encrypt ? AES256_CBC_encrypt(&ctx, in, out, len,
+                                                    out_len, false)
+                               : AES256_CBC_decrypt(&ctx, in, out, len,
+                                                    out_len, false);
+            }
+            return encrypt
+                       ? AES256_ECB_encrypt(&ctx, in, out, len, out_len, false)
+                       : AES256_ECB_decrypt(&ctx, in, out, len, out_len, false);
+        }
+    }
+}
+
+static bool check_direction(const AES_KAT_t *kat, bool cbc, bool encrypt,
+                            const uint8_t *key, const uint8_t *iv,
+                            const uint8_t *from, const uint8_t *to,
+                            size_t len) {
+    uint8_t in[KAT_MAX_DATA_LEN];
+    uint8_t out[KAT_MAX_DATA_LEN];
+    size_t out_len = 0;
+
+    memcpy(in, from, len);
+    AES_errcode_t err =
+        kat_crypt(kat->key_size, cbc, encrypt, key, iv, in, out, len, &out_len);
+
+    bool passed = (err == AES_CODE_OK) && bytes_equal(out, out_len, to, len);
+    printf("  %s %s: %s\n", cbc ? "CBC" : "ECB",
+           encrypt ? "encrypt" : "decrypt", passed ? "PASSED" : "FAILED");
+    if (!passed) {
+        printf("    Expected: ");
+        print_hex(to, len);
+        printf("    Got:      ");
+        print_hex(out, out_len);
+    }
+    return passed;
+}
+
+static bool run_single_test(const AES_KAT_t *kat, size_t test_number) {
+    uint8_t key[32];
+    uint8_t iv[AES_BLOCK_LEN] = {0};
+    uint8_t plain[KAT_MAX_DATA_LEN];
+    uint8_t cipher[KAT_MAX_DATA_LEN];
+    bool test_passed = true;
+
+    printf("\n--- Test %zu: %s ---\n", test_number + 1, kat->description);
+
+    hex_to_bytes(kat->key, key);
+    size_t len = hex_to_bytes(kat->plain, plain);
+
+    hex_to_bytes(kat->ecb_cipher, cipher);
+    test_passed &= check_direction(kat, false, true, key, NULL, plain, cipher,
+                                   len);
+    test_passed &= check_direction(kat, false, false, key, NULL, cipher, plain,
+                                   len);
+
+    if (kat->cbc_cipher != NULL) {
+        hex_to_bytes(kat->iv, iv);
+        hex_to_bytes(kat->cbc_cipher, cipher);
+        test_passed &= check_direction(kat, true, true, key, iv, plain, cipher,
+                                       len);
+        test_passed &= check_direction(kat, true, false, key, iv, cipher,
+                                       plain, len);
+    }
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/**
+ * @brief Rekeying a context must behave exactly like a fresh initialization
+ * with the new key, while keeping the IV already stored in the context
+ */
+static bool run_rekey_test(void) {
+    uint8_t key_a[AES256_FIXED_KEY_SIZE];
+    uint8_t key_b[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    uint8_t plain[KAT_MAX_DATA_LEN];
+    uint8_t out_fresh[KAT_MAX_DATA_LEN];
+    uint8_t out_rekey[KAT_MAX_DATA_LEN];
+    size_t len_fresh = 0;
+    size_t len_rekey = 0;
+    bool test_passed = true;
+
+    printf("\n--- Rekey test ---\n");
+
+    for (size_t i = 0; i < sizeof(key_a); i++) {
+        key_a[i] = (uint8_t)i;
+        key_b[i] = (uint8_t)(0xA5 ^ (i * 7));
+    }
+    for (size_t i = 0; i < sizeof(iv); i++) {
+        iv[i] = (uint8_t)(0xF0 + i);
+    }
+    for (size_t i = 0; i < sizeof(plain); i++) {
+        plain[i] = (uint8_t)(i * 3);
+    }
+
+    AES128_ctx_t ctx128_fresh, ctx128_rekey;
+    AES128_init_ctx(&ctx128_fresh, key_b, iv);
+    AES128_init_ctx(&ctx128_rekey, key_a, iv);
+    AES128_rekey(&ctx128_rekey, key_b);
+    AES128_CBC_encrypt(&ctx128_fresh, plain, out_fresh, sizeof(plain),
+                       &len_fresh, false);
+    AES128_CBC_encrypt(&ctx128_rekey, plain, out_rekey, sizeof(plain),
+                       &len_rekey, false);
+    bool passed = bytes_equal(out_fresh, len_fresh, out_rekey, len_rekey);
+    printf("  AES-128 rekey: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES192_ctx_t ctx192_fresh, ctx192_rekey;
+    AES192_init_ctx(&ctx192_fresh, key_b, iv);
+    AES192_init_ctx(&ctx192_rekey, key_a, iv);
+    AES192_rekey(&ctx192_rekey, key_b);
+    AES192_CBC_encrypt(&ctx192_fresh, plain, out_fresh, sizeof(plain),
+                       &len_fresh, false);
+    AES192_CBC_encrypt(&ctx192_rekey, plain, out_rekey, sizeof(plain),
+                       &len_rekey, false);
+    passed = bytes_equal(out_fresh, len_fresh, out_rekey, len_rekey);
+    printf("  AES-192 rekey: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES256_ctx_t ctx256_fresh, ctx256_rekey;
+    AES256_init_ctx(&ctx256_fresh, key_b, iv);
+    AES256_init_ctx(&ctx256_rekey, key_a, iv);
+    AES256_rekey(&ctx256_rekey, key_b);
+    AES256_CBC_encrypt(&ctx256_fresh, plain, out_fresh, sizeof(plain),
+                       &len_fresh, false);
+    AES256_CBC_encrypt(&ctx256_rekey, plain, out_rekey, sizeof(plain),
+                       &len_rekey, false);
+    passed = bytes_equal(out_fresh, len_fresh, out_rekey, len_rekey);
+    printf("  AES-256 rekey: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Rekey test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    bool all_tests_passed = true;
+
+    for (size_t i = 0; i < KAT_VECTORS_COUNT; i++) {
+        if (!run_single_test(&kat_vectors[i], i)) {
+            all_tests_passed = false;
+        }
+    }
+
+    if (!run_rekey_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", KAT_VECTORS_COUNT + 1);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,238 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "AES_mb.h"
+#include "AES_ni.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES multi-buffer CBC encryption tester";
+
+/* More jobs than lanes in every set, with lengths of 0 to 5 blocks */
+#define MB_NUM_JOBS 60
+#define MB_MAX_LEN (5 * AES_BLOCK_LEN + 7)
+#define MB_OUT_LEN (MB_MAX_LEN + AES_BLOCK_LEN)
+
+typedef struct {
+    AES128_ctx_t ctx128;
+    AES192_ctx_t ctx192;
+    AES256_ctx_t ctx256;
+    size_t key_bits;
+    uint8_t plain[MB_MAX_LEN];
+    uint8_t expected[MB_OUT_LEN];
+    size_t expected_len;
+    AES_errcode_t expected_status;
+    uint8_t out[MB_OUT_LEN];
+    size_t returned;
+} mb_case_t;
+
+static mb_case_t cases[MB_NUM_JOBS];
+static AES_mb_job_t jobs[MB_NUM_JOBS];
+
+/* Mixed key sizes and lengths, each with its one-shot reference */
+static void prepare_cases(void) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+
+    for (size_t i = 0; i < MB_NUM_JOBS; i++) {
+        mb_case_t *c = &cases[i];
+        size_t len = next_random() % (MB_MAX_LEN + 1);
+        bool use_padding = (next_random() & 1) != 0;
+
+        // Some whole-block lengths, with and without padding
+        if (i % 5 == 0) {
+            len -= len % AES_BLOCK_LEN;
+        }
+        c->key_bits = 128 + (64 * (i % 3));
+        fill_random(key, sizeof(key));
+        fill_random(iv, sizeof(iv));
+        fill_random(c->plain, sizeof(c->plain));
+        memset(c->out, 0, sizeof(c->out));
+        c->returned = 0;
+
+        switch (c->key_bits) {
+            case 128:
+                AES128_init_ctx(&c->ctx128, key, iv);
+                c->expected_status =
+                    AES128_CBC_encrypt(&c->ctx128, c->plain, c->expected, len,
+                                       &c->expected_len, use_padding);
+                AES128_CBC_mb_job(&c->ctx128, &jobs[i], c->plain, c->out, len,
+                                  use_padding);
+                break;
+            case 192:
+                AES192_init_ctx(&c->ctx192, key, iv);
+                c->expected_status =
+                    AES192_CBC_encrypt(&c->ctx192, c->plain, c->expected, len,
+                                       &c->expected_len, use_padding);
+                AES192_CBC_mb_job(&c->ctx192, &jobs[i], c->plain, c->out, len,
+                                  use_padding);
+                break;
+            default:
+                AES256_init_ctx(&c->ctx256, key, iv);
+                c->expected_status =
+                    AES256_CBC_encrypt(&c->ctx256, c->plain, c->expected, len,
+                                       &c->expected_len, use_padding);
+                AES256_CBC_mb_job(&c->ctx256, &jobs[i], c->plain, c->out, len,
+                                  use_padding);
+                break;
+        }
+        if (c->expected_status != AES_CODE_OK) {
+            c->expected_len = 0;
+        }
+        jobs[i].user_data = c;
+    }
+}
+
+static bool check_cases(void) {
+    bool test_passed = true;
+    for (size_t i = 0; i < MB_NUM_JOBS; i++) {
+        mb_case_t *c = &cases[i];
+        bool passed = (jobs[i].status == c->expected_status) &&
+                      (jobs[i].out_len == c->expected_len) &&
+                      bytes_equal(c->out, jobs[i].out_len, c->expected,
+                                  c->expected_len);
+        if (!passed) {
+            printf("  Job %zu (AES-%zu, %zu bytes): FAILED\n", i, c->key_bits,
+                   jobs[i].len);
+        }
+        test_passed &= passed;
+    }
+    return test_passed;
+}
+
+/* Every job comes back exactly once from submit or flush */
+static bool run_manager_test(const char *label) {
+    AES_mb_mgr_t mgr;
+    AES_mb_stats_t stats;
+    AES_mb_job_t *job;
+    size_t returned = 0;
+    bool test_passed = true;
+
+    prepare_cases();
+    AES_mb_mgr_init(&mgr);
+
+    for (size_t i = 0; i < MB_NUM_JOBS; i++) {
+        job = AES_mb_submit(&mgr, &jobs[i]);
+        if (job != NULL) {
+            ((mb_case_t *)job->user_data)->returned++;
+            returned++;
+        }
+    }
+    while ((job = AES_mb_flush(&mgr)) != NULL) {
+        ((mb_case_t *)job->user_data)->returned++;
+        returned++;
+    }
+
+    for (size_t i = 0; i < MB_NUM_JOBS; i++) {
+        test_passed &= (cases[i].returned == 1);
+    }
+    test_passed &= (returned == MB_NUM_JOBS);
+    test_passed &= check_cases();
+
+    AES_mb_mgr_get_stats(&mgr, &stats);
+    test_passed &= (stats.jobs == MB_NUM_JOBS) && (stats.blocks > 0) &&
+                   (stats.lane_occupancy > 0.0) &&
+                   (stats.lane_occupancy <= 1.0);
+
+    printf("  %s manager, lane occupancy %.2f: %s\n", label,
+           stats.lane_occupancy, test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_batch_test(const char *label) {
+    AES_mb_stats_t stats;
+    AES_errcode_t expected = AES_CODE_OK;
+
+    prepare_cases();
+    for (size_t i = 0; i < MB_NUM_JOBS; i++) {
+        if (cases[i].expected_status != AES_CODE_OK) {
+            expected = cases[i].expected_status;
+            break;
+        }
+    }
+
+    bool passed = (AES_mb_process(jobs, MB_NUM_JOBS, &stats) == expected) &&
+                  check_cases() && (stats.jobs == MB_NUM_JOBS);
+    printf("  %s batch: %s\n", label, passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+static bool run_jobs_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Mixed jobs test ---\n");
+
+    AES_set_backend(AES_BACKEND_PORTABLE);
+    test_passed &= run_manager_test("Portable");
+    test_passed &= run_batch_test("Portable");
+
+    if (AES_set_backend(AES_BACKEND_AESNI)) {
+        test_passed &= run_manager_test("AES-NI");
+        test_passed &= run_batch_test("AES-NI");
+    }
+
+    printf("Mixed jobs test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Rejected jobs are returned at once and leave the lanes untouched */
+static bool run_invalid_job_test(void) {
+    uint8_t key[AES128_FIXED_KEY_SIZE] = {0};
+    uint8_t iv[AES_BLOCK_LEN] = {0};
+    uint8_t buf[AES_BLOCK_LEN] = {0};
+    AES128_ctx_t ctx;
+    AES_mb_mgr_t mgr;
+    AES_mb_job_t job;
+    bool test_passed = true;
+
+    printf("\n--- Invalid job test ---\n");
+
+    AES128_init_ctx(&ctx, key, iv);
+    AES_mb_mgr_init(&mgr);
+
+    AES128_CBC_mb_job(&ctx, &job, buf, buf, 0, true);
+    bool passed = (AES_mb_submit(&mgr, &job) == &job) &&
+                  (job.status == AES_CODE_EMPTY_INPUT_BUFFER);
+    printf("  Empty input: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES128_CBC_mb_job(&ctx, &job, buf, buf, sizeof(buf), false);
+    job.num_rounds = 11;
+    passed = (AES_mb_submit(&mgr, &job) == &job) &&
+             (job.status == AES_CODE_INVALID_ARGUMENT) &&
+             (AES_mb_flush(&mgr) == NULL);
+    printf("  Invalid rounds: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Invalid job test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x3B0F0001);
+    bool all_tests_passed = true;
+
+    if (!run_jobs_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_invalid_job_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AES128.h"
+#include "AES192.h"
+#include "AES256.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "AES streaming API tester";
+
+/* Well above the former 256/1024 byte limits, and not block aligned */
+#define STREAM_DATA_LEN (64 * 1024 + 7)
+#define STREAM_BUFFER_LEN (STREAM_DATA_LEN + 2 * AES_BLOCK_LEN)
+
+static uint8_t plain[STREAM_DATA_LEN];
+static uint8_t oneshot[STREAM_BUFFER_LEN];
+static uint8_t streamed[STREAM_BUFFER_LEN];
+static uint8_t decrypted[STREAM_BUFFER_LEN];
+
+/* Piece sizes fed to update(), cycled through */
+static const size_t piece_sizes[] = {1, 15, 16, 17, 0, 31, 100, 4096, 3, 48};
+#define PIECE_SIZES_COUNT (sizeof(piece_sizes) / sizeof(piece_sizes[0]))
+
+typedef struct {
+    const char *description;
+    AES_mode_t mode;
+    bool use_padding;
+    bool in_place;
+} StreamTestCase;
+
+static const StreamTestCase test_cases[] = {
+    {"ECB, PKCS7", AES_MODE_ECB, true, false},
+    {"ECB, zero padding", AES_MODE_ECB, false, false},
+    {"CBC, PKCS7", AES_MODE_CBC, true, false},
+    {"CBC, zero padding", AES_MODE_CBC, false, false},
+    {"ECB, PKCS7, in place", AES_MODE_ECB, true, true},
+    {"CBC, PKCS7, in place", AES_MODE_CBC, true, true},
+    {"CBC, zero padding, in place", AES_MODE_CBC, false, true},
+};
+
+#define STREAM_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+/*
+ * Streams src through an already started context in pieces of varying size.
+ * When in_place is set, every piece is first copied to its position in dst
+ * and processed there (in == out), which is how callers encrypt a buffer
+ * without a second copy.
+ */
+#define DEFINE_STREAM_RUNNER(BITS)                                            \
+    static AES_errcode_t stream_##BITS(AES##BITS##_ctx_t *ctx,                \
+                                       const uint8_t *src, size_t len,        \
+                                       uint8_t *dst, bool in_place,           \
+                                       size_t *total) {                       \
+        size_t in_pos = 0, out_pos = 0, written, piece = 0;                   \
+        while (in_pos < len) {                                                \
+            size_t chunk = piece_sizes[piece++ % PIECE_SIZES_COUNT];          \
+            if (chunk > len - in_pos) chunk = len - in_pos;                   \
+            const uint8_t *chunk_in = src + in_pos;                           \
+            if (in_place) {                                                   \
+                memmove(dst + out_pos, src + in_pos, chunk);                  \
+                chunk_in = dst + out_pos;                                     \
+            }                                                                 \
+            AES##BITS##_update(ctx, chunk_in, dst + out_pos, chunk,           \
+                               &written);                                     \
+            in_pos += chunk;                                                  \
+            out_pos += written;                                               \
+        }                                                                     \
+        AES_errcode_t err = AES##BITS##_final(ctx, dst + out_pos, &written);  \
+        *total = out_pos + written;                                           \
+        return err;                                                           \
+    }
+
+DEFINE_STREAM_RUNNER(128)
+DEFINE_STREAM_RUNNER(192)
+DEFINE_STREAM_RUNNER(256)
+
+static bool run_single_test(const StreamTestCase *tc, size_t test_number) {
+    uint8_t key[AES256_FIXED_KEY_SIZE];
+    uint8_t iv[AES_BLOCK_LEN];
+    size_t oneshot_len, streamed_len, decrypted_len;
+    bool test_passed = true;
+    bool passed;
+    AES_errcode_t err;
+
+    printf("\n--- Test %zu: %s ---\n", test_number + 1, tc->description);
+
+    fill_random(key, sizeof(key));
+    fill_random(iv, sizeof(iv));
+
+    // AES-128: streaming matches the one-shot functions
+    AES128_ctx_t ctx128;
+    AES128_init_ctx(&ctx128, key, iv);
+    if (tc->mode == AES_MODE_CBC) {
+        err = AES128_CBC_encrypt(&ctx128, plain, oneshot, STREAM_DATA_LEN,
+                                 &oneshot_len, tc->use_padding);
+    } else {
+        err = AES128_ECB_encrypt(&ctx128, plain, oneshot, STREAM_DATA_LEN,
+                                 &oneshot_len, tc->use_padding);
+    }
+    passed = (err == AES_CODE_OK) &&
+             (oneshot_len == AES_ROUNDUP_TO_NEAREST_MULTIPLE_OF_16(
+                                 STREAM_DATA_LEN + (tc->use_padding ? 1 : 0)));
+    printf("  AES-128 one-shot encrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES128_encrypt_init(&ctx128, tc->mode, tc->use_padding);
+    err = stream_128(&ctx128, plain, STREAM_DATA_LEN, streamed, tc->in_place,
+                     &streamed_len);
+    passed = (err == AES_CODE_OK) &&
+             bytes_equal(oneshot, oneshot_len, streamed, streamed_len) &&
+             (ctx128.encrypted_chunks == streamed_len / AES_BLOCK_LEN);
+    printf("  AES-128 streamed encrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES128_decrypt_init(&ctx128, tc->mode, tc->use_padding);
+    err = stream_128(&ctx128, streamed, streamed_len, decrypted, tc->in_place,
+                     &decrypted_len);
+    passed = (err == AES_CODE_OK) &&
+             (decrypted_len >= STREAM_DATA_LEN) &&
+             (memcmp(decrypted, plain, STREAM_DATA_LEN) == 0);
+    if (tc->use_padding) {
+        passed &= (decrypted_len == STREAM_DATA_LEN);
+    }
+    printf("  AES-128 streamed decrypt: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // AES-192 / AES-256: streamed round trip against the one-shot decrypt
+    AES192_ctx_t ctx192;
+    AES192_init_ctx(&ctx192, key, iv);
+    AES192_encrypt_init(&ctx192, tc->mode, tc->use_padding);
+    err = stream_192(&ctx192, plain, STREAM_DATA_LEN, streamed, tc->in_place,
+                     &streamed_len);
+    if (tc->mode == AES_MODE_CBC) {
+        err |= AES192_CBC_decrypt(&ctx192, streamed, decrypted, streamed_len,
+                                  &decrypted_len, tc->use_padding);
+    } else {
+        err |= AES192_ECB_decrypt(&ctx192, streamed, decrypted, streamed_len,
+                                  &decrypted_len, tc->use_padding);
+    }
+    passed = (err == AES_CODE_OK) &&
+             (memcmp(decrypted, plain, STREAM_DATA_LEN) == 0);
+    printf("  AES-192 round trip: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES256_ctx_t ctx256;
+    AES256_init_ctx(&ctx256, key, iv);
+    AES256_encrypt_init(&ctx256, tc->mode, tc->use_padding);
+    err = stream_256(&ctx256, plain, STREAM_DATA_LEN, streamed, tc->in_place,
+                     &streamed_len);
+    if (tc->mode == AES_MODE_CBC) {
+        err |= AES256_CBC_decrypt(&ctx256, streamed, decrypted, streamed_len,
+                                  &decrypted_len, tc->use_padding);
+    } else {
+        err |= AES256_ECB_decrypt(&ctx256, streamed, decrypted, streamed_len,
+                                  &decrypted_len, tc->use_padding);
+    }
+    passed = (err == AES_CODE_OK) &&
+             (memcmp(decrypted, plain, STREAM_DATA_LEN) == 0);
+    printf("  AES-256 round trip: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Malformed padding and truncated ciphertext must be reported */
+static bool run_error_test(void) {
+    uint8_t key[AES128_FIXED_KEY_SIZE] = {0};
+    uint8_t block[AES_BLOCK_LEN] = {0};
+    uint8_t out[2 * AES_BLOCK_LEN];
+    size_t out_len;
+    bool test_passed = true;
+
+    printf("\n--- Error handling test ---\n");
+
+    AES128_ctx_t ctx;
+    AES128_init_ctx(&ctx, key, NULL);
+
+    // Encrypting a block of zeros without padding yields a block whose
+    // decryption ends in 0x00, which is not valid PKCS7
+    AES128_ECB_encrypt(&ctx, block, out, AES_BLOCK_LEN, &out_len, false);
+    AES_errcode_t err =
+        AES128_ECB_decrypt(&ctx, out, out, AES_BLOCK_LEN, &out_len, true);
+    bool passed = (err == AES_CODE_INVALID_PADDING);
+    printf("  Invalid padding detected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    AES128_decrypt_init(&ctx, AES_MODE_ECB, false);
+    AES128_update(&ctx, block, out, AES_BLOCK_LEN - 1, &out_len);
+    err = AES128_final(&ctx, out, &out_len);
+    passed = (err == AES_CODE_INCORRECT_BUFFER_SIZE);
+    printf("  Truncated ciphertext detected: %s\n",
+           passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0xC0FFEE11);
+    bool all_tests_passed = true;
+
+    fill_random(plain, sizeof(plain));
+
+    for (size_t i = 0; i < STREAM_TESTS_COUNT; i++) {
+        if (!run_single_test(&test_cases[i], i)) {
+            all_tests_passed = false;
+        }
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", STREAM_TESTS_COUNT + 1);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
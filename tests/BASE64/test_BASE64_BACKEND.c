@@ -0,0 +1,127 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base64.h"
+#include "base64_simd.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "BASE64 backend cross-check tester";
+
+/* Covers partial and full blocks of every kernel */
+#define BACKEND_MAX_LEN BASE64_MAX_INPUT_SIZE
+
+static const struct {
+    base64_backend_t backend;
+    const char *name;
+} backends[] = {
+    {BASE64_BACKEND_SSSE3, "SSSE3"},
+    {BASE64_BACKEND_AVX2, "AVX2"},
+};
+
+#define BACKENDS_COUNT (sizeof(backends) / sizeof(backends[0]))
+
+static uint8_t input[BACKEND_MAX_LEN];
+static uint8_t expected_enc[BASE64_MAX_ENCODED_BUFFER];
+static uint8_t work_buffer[BASE64_MAX_ENCODED_BUFFER];
+static uint8_t decoded[BASE64_MAX_ENCODED_BUFFER];
+
+/* Every length against the scalar encoding, then a round trip */
+static bool run_round_trip_test(base64_converter_t *converter,
+                                base64_backend_t backend) {
+    bool passed = true;
+
+    for (size_t len = 0; len <= BACKEND_MAX_LEN && passed; len++) {
+        const uint8_t *encoded;
+        size_t enc_size, scalar_size, dec_size;
+
+        base64_set_backend(BASE64_BACKEND_SCALAR);
+        passed &= base64_encode(converter, input, len, &encoded,
+                                &scalar_size) == BASE64_SUCCESS;
+        memcpy(expected_enc, encoded, scalar_size);
+
+        base64_set_backend(backend);
+        passed &= base64_encode(converter, input, len, &encoded, &enc_size) ==
+                  BASE64_SUCCESS;
+        passed &= bytes_equal(encoded, enc_size, expected_enc, scalar_size);
+        passed &= base64_decode(converter, expected_enc, scalar_size, decoded,
+                                &dec_size) == BASE64_SUCCESS;
+        passed &= bytes_equal(decoded, dec_size, input, len);
+        if (!passed) {
+            printf("  Mismatch at %zu bytes\n", len);
+        }
+    }
+    return passed;
+}
+
+/* A character outside the alphabet anywhere must be reported */
+static bool run_invalid_test(base64_converter_t *converter,
+                             base64_backend_t backend) {
+    const uint8_t bad_chars[] = {'!', '-', '_', ' ', 0x80, 0xFF, '\n'};
+    const uint8_t *encoded;
+    size_t enc_size, dec_size;
+    bool passed = true;
+
+    base64_set_backend(backend);
+    passed &= base64_encode(converter, input, 600, &encoded, &enc_size) ==
+              BASE64_SUCCESS;
+    memcpy(expected_enc, encoded, enc_size);
+
+    for (size_t pos = 0; pos + 4 < enc_size && passed; pos += 7) {
+        uint8_t saved = expected_enc[pos];
+        expected_enc[pos] = bad_chars[pos % sizeof(bad_chars)];
+        passed = base64_decode(converter, expected_enc, enc_size, decoded,
+                               &dec_size) == BASE64_INVALID_CHARACTER;
+        if (!passed) {
+            printf("  Invalid character at %zu not detected\n", pos);
+        }
+        expected_enc[pos] = saved;
+    }
+    return passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x2545F491);
+
+    base64_converter_t converter;
+    if (base64_init(&converter, work_buffer, sizeof(work_buffer)) !=
+        BASE64_SUCCESS) {
+        printf("Failed to initialize converter\n");
+        return EXIT_FAILURE;
+    }
+    fill_random(input, sizeof(input));
+
+    bool all_tests_passed = true;
+    size_t tests_run = 0;
+
+    for (size_t b = 0; b < BACKENDS_COUNT; b++) {
+        if (!base64_set_backend(backends[b].backend)) {
+            printf("--- %s: not available, skipped ---\n", backends[b].name);
+            continue;
+        }
+        printf("--- %s ---\n", backends[b].name);
+
+        bool passed = run_round_trip_test(&converter, backends[b].backend);
+        printf("  Round trip, 0 to %d bytes: %s\n", BACKEND_MAX_LEN,
+               passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+
+        passed = run_invalid_test(&converter, backends[b].backend);
+        printf("  Invalid characters: %s\n", passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+        tests_run += 2;
+    }
+    base64_set_backend(BASE64_BACKEND_SCALAR);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", tests_run);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,188 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base64.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "BASE64 caller buffer tester";
+
+/* Well above BASE64_MAX_INPUT_SIZE, not a multiple of 3 */
+#define LARGE_INPUT_SIZE (3 * 1024 * 1024 + 1)
+
+/* Chunks of the converter API, a multiple of 3 so encodings concatenate */
+#define CONVERTER_CHUNK 1020
+
+static bool run_size_test(void) {
+    const struct {
+        const char *encoded;
+        size_t decoded_size;
+    } padded[] = {{"", 0}, {"QQ==", 1}, {"QUI=", 2}, {"QUJD", 3},
+                  {"QUJDRA==", 4}, {"QUJD=", 0}};
+    bool test_passed = true;
+
+    printf("\n--- Size queries ---\n");
+    for (size_t len = 0; len < 12; len++) {
+        test_passed &= base64_encoded_size(len) == (len + 2) / 3 * 4;
+    }
+    test_passed &= base64_encoded_size(SIZE_MAX) == 0;
+    for (size_t i = 0; i < sizeof(padded) / sizeof(padded[0]); i++) {
+        const uint8_t *text = (const uint8_t *)padded[i].encoded;
+        test_passed &= base64_decoded_size(text, strlen(padded[i].encoded)) ==
+                       padded[i].decoded_size;
+    }
+    printf("Size queries test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Multi-MB round trip, and the same text as the chunked converter API */
+static bool run_large_test(const uint8_t *input) {
+    size_t enc_capacity = base64_encoded_size(LARGE_INPUT_SIZE);
+    uint8_t *encoded = malloc(enc_capacity);
+    uint8_t *decoded = malloc(LARGE_INPUT_SIZE);
+    uint8_t *chunked = malloc(enc_capacity);
+    uint8_t buffer[BASE64_MAX_ENCODED_BUFFER];
+    base64_converter_t converter;
+    size_t enc_size = 0, dec_size = 0;
+    bool test_passed = encoded && decoded && chunked;
+
+    printf("\n--- %d bytes through caller buffers ---\n", LARGE_INPUT_SIZE);
+    test_passed = test_passed &&
+                  base64_encode_to(input, LARGE_INPUT_SIZE, encoded,
+                                   enc_capacity, &enc_size) ==
+                      BASE64_SUCCESS &&
+                  enc_size == enc_capacity &&
+                  base64_decode_to(encoded, enc_size, decoded,
+                                   LARGE_INPUT_SIZE, &dec_size) ==
+                      BASE64_SUCCESS &&
+                  bytes_equal(decoded, dec_size, input, LARGE_INPUT_SIZE);
+
+    // The chunk-and-concatenate loop the new functions replace
+    size_t pos = 0;
+    test_passed = test_passed &&
+                  base64_init(&converter, buffer, sizeof(buffer)) ==
+                      BASE64_SUCCESS;
+    for (size_t i = 0; test_passed && i < LARGE_INPUT_SIZE;
+         i += CONVERTER_CHUNK) {
+        size_t n = LARGE_INPUT_SIZE - i;
+        const uint8_t *out;
+        size_t out_size;
+        n = (n < CONVERTER_CHUNK) ? n : CONVERTER_CHUNK;
+        test_passed = base64_encode(&converter, input + i, n, &out,
+                                    &out_size) == BASE64_SUCCESS;
+        memcpy(chunked + pos, out, out_size);
+        pos += out_size;
+    }
+    test_passed = test_passed && bytes_equal(chunked, pos, encoded, enc_size);
+
+    free(encoded);
+    free(decoded);
+    free(chunked);
+    printf("Large buffer test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Decoding over the encoded text itself, at every length */
+static bool run_in_place_test(const uint8_t *input) {
+    uint8_t buffer[(600 + 2) / 3 * 4];
+    bool test_passed = true;
+
+    printf("\n--- In-place decoding ---\n");
+    for (size_t len = 0; len <= 600 && test_passed; len++) {
+        size_t enc_size = 0, dec_size = 0;
+        test_passed = base64_encode_to(input, len, buffer, sizeof(buffer),
+                                       &enc_size) == BASE64_SUCCESS &&
+                      base64_decode_to(buffer, enc_size, buffer, enc_size,
+                                       &dec_size) == BASE64_SUCCESS &&
+                      bytes_equal(buffer, dec_size, input, len);
+        if (!test_passed) {
+            printf("  Mismatch at %zu bytes\n", len);
+        }
+    }
+    printf("In-place test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_error_test(const uint8_t *input) {
+    uint8_t out[64];
+    uint8_t work[4096];
+    base64_converter_t converter;
+    const uint8_t *encoded;
+    size_t size;
+    bool test_passed = true;
+
+    printf("\n--- Error handling ---\n");
+    test_passed &= base64_encode_to(input, 30, out, 39, &size) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_to(input, 30, NULL, 40, &size) ==
+                   BASE64_INVALID_INPUT;
+    test_passed &= base64_decode_to((const uint8_t *)"QUJD", 4, out, 2,
+                                    &size) == BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_decode_to((const uint8_t *)"QUJDR", 5, out, 64,
+                                    &size) == BASE64_INVALID_LENGTH;
+    test_passed &= base64_decode_to((const uint8_t *)"QU!D", 4, out, 64,
+                                    &size) == BASE64_INVALID_CHARACTER;
+    test_passed &= base64_decode_to((const uint8_t *)"QQ==QQ==", 8, out, 64,
+                                    &size) == BASE64_INVALID_CHARACTER;
+    test_passed &= base64_decode_to((const uint8_t *)"QQ==QUJD", 8, out, 64,
+                                    &size) == BASE64_INVALID_CHARACTER;
+    test_passed &= base64_encode_to(NULL, 0, out, 0, &size) ==
+                       BASE64_SUCCESS &&
+                   size == 0;
+
+    // The converter API is bounded by its buffer, not by a fixed maximum
+    test_passed &= base64_init(&converter, work, sizeof(work)) ==
+                   BASE64_SUCCESS;
+    test_passed &= base64_encode(&converter, input, 3000, &encoded, &size) ==
+                       BASE64_SUCCESS &&
+                   size == 4000 && encoded[size] == '\0';
+    test_passed &= base64_encode(&converter, input, 3072, &encoded, &size) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x6C078965);
+
+    uint8_t *input = malloc(LARGE_INPUT_SIZE);
+    if (input == NULL) {
+        printf("Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    fill_random(input, LARGE_INPUT_SIZE);
+
+    bool all_tests_passed = true;
+
+    if (!run_size_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_large_test(input)) {
+        all_tests_passed = false;
+    }
+
+    if (!run_in_place_test(input)) {
+        all_tests_passed = false;
+    }
+
+    if (!run_error_test(input)) {
+        all_tests_passed = false;
+    }
+    free(input);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 4\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,278 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base64.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "BASE64 alphabet and layout tester";
+
+/* Several MIME and PEM lines, and every partial line length below */
+#define FORMAT_MAX_LEN 1200
+#define FORMAT_BUFFER_SIZE 4096
+
+static const struct {
+    base64_backend_t backend;
+    const char *name;
+} backends[] = {
+    {BASE64_BACKEND_SCALAR, "Scalar"},
+    {BASE64_BACKEND_SSSE3, "SSSE3"},
+    {BASE64_BACKEND_AVX2, "AVX2"},
+};
+
+#define BACKENDS_COUNT (sizeof(backends) / sizeof(backends[0]))
+
+static uint8_t input[FORMAT_MAX_LEN];
+static uint8_t encoded[FORMAT_BUFFER_SIZE];
+static uint8_t reference[FORMAT_BUFFER_SIZE];
+static uint8_t decoded[FORMAT_BUFFER_SIZE];
+
+/* RFC 4648 alphabets and padding, and a JWT header */
+static bool run_vector_test(void) {
+    static const uint8_t bytes[] = {0xFB, 0xFF, 0xBF};
+    static const struct {
+        const base64_options_t *options;
+        size_t len;
+        const char *text;
+    } vectors[] = {
+        {&base64_options_standard, 3, "+/+/"},
+        {&base64_options_standard, 2, "+/8="},
+        {&base64_options_url, 3, "-_-_"},
+        {&base64_options_url, 2, "-_8"},
+        {&base64_options_url, 1, "-w"},
+    };
+    static const char jwt[] = "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9";
+    static const char header[] = "{\"alg\":\"HS256\",\"typ\":\"JWT\"}";
+    size_t size;
+    bool test_passed = true;
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        size_t text_len = strlen(vectors[i].text);
+        test_passed &= base64_encoded_size_ex(vectors[i].len,
+                                              vectors[i].options) == text_len;
+        test_passed &= base64_encode_ex(bytes, vectors[i].len, encoded,
+                                        sizeof(encoded), &size,
+                                        vectors[i].options) ==
+                           BASE64_SUCCESS &&
+                       bytes_equal(encoded, size,
+                                   (const uint8_t *)vectors[i].text, text_len);
+        test_passed &= base64_decode_ex((const uint8_t *)vectors[i].text,
+                                        text_len, decoded, sizeof(decoded),
+                                        &size, vectors[i].options) ==
+                           BASE64_SUCCESS &&
+                       bytes_equal(decoded, size, bytes, vectors[i].len);
+    }
+    test_passed &= base64_decode_ex((const uint8_t *)jwt, strlen(jwt), decoded,
+                                    sizeof(decoded), &size,
+                                    &base64_options_url) == BASE64_SUCCESS &&
+                   bytes_equal(decoded, size, (const uint8_t *)header,
+                               strlen(header));
+    return test_passed;
+}
+
+/* Lines of MIME/PEM output, the same text once line breaks are removed */
+static bool check_lines(const uint8_t *text, size_t size, size_t line_length,
+                        size_t len) {
+    size_t plain_size, pos = 0, column = 0;
+
+    if (size != base64_encoded_size_ex(len, line_length == 64
+                                                ? &base64_options_pem
+                                                : &base64_options_mime) ||
+        base64_encode_ex(input, len, reference, sizeof(reference),
+                         &plain_size, NULL) != BASE64_SUCCESS) {
+        return false;
+    }
+    for (size_t i = 0; i < size; i++) {
+        if (text[i] == '\r') {
+            // A break ends a full line and is followed by more text
+            if (column != line_length || i + 2 >= size ||
+                text[i + 1] != '\n') {
+                return false;
+            }
+            i++;
+            column = 0;
+        } else if (pos >= plain_size || text[i] != reference[pos++] ||
+                   ++column > line_length) {
+            return false;
+        }
+    }
+    return pos == plain_size;
+}
+
+/* Every length wrapped, unpadded and in the URL alphabet, decoded back
+ * into another buffer and in place */
+static bool run_layout_test(void) {
+    const base64_options_t url_padded = {BASE64_ALPHABET_URL, true, 0, false};
+    const base64_options_t *variants[] = {
+        &base64_options_mime, &base64_options_pem, &base64_options_url,
+        &url_padded};
+    bool test_passed = true;
+
+    for (size_t len = 0; len <= FORMAT_MAX_LEN && test_passed; len++) {
+        for (size_t v = 0; v < 4 && test_passed; v++) {
+            const base64_options_t *options = variants[v];
+            size_t enc_size = 0, dec_size = 0;
+            test_passed =
+                base64_encode_ex(input, len, encoded, sizeof(encoded),
+                                 &enc_size, options) == BASE64_SUCCESS &&
+                base64_decode_ex(encoded, enc_size, decoded, sizeof(decoded),
+                                 &dec_size, options) == BASE64_SUCCESS &&
+                bytes_equal(decoded, dec_size, input, len) &&
+                base64_decode_ex(encoded, enc_size, encoded, enc_size,
+                                 &dec_size, options) == BASE64_SUCCESS &&
+                bytes_equal(encoded, dec_size, input, len);
+            if (test_passed) {
+                test_passed = base64_encode_ex(input, len, encoded,
+                                               sizeof(encoded), &enc_size,
+                                               options) == BASE64_SUCCESS;
+            }
+            if (test_passed && options->line_length != 0) {
+                test_passed = check_lines(encoded, enc_size,
+                                          options->line_length, len);
+            }
+            if (test_passed && options == &base64_options_url) {
+                test_passed =
+                    enc_size == base64_encoded_size_ex(len, options) &&
+                    memchr(encoded, '=', enc_size) == NULL &&
+                    memchr(encoded, '+', enc_size) == NULL &&
+                    memchr(encoded, '/', enc_size) == NULL;
+            }
+            if (!test_passed) {
+                printf("  Mismatch at %zu bytes, variant %zu\n", len, v);
+            }
+        }
+    }
+    return test_passed;
+}
+
+/* Whitespace anywhere is skipped when asked, and rejected otherwise */
+static bool run_whitespace_test(void) {
+    static const uint8_t spaces[] = {' ', '\t', '\r', '\n'};
+    bool test_passed = true;
+
+    for (size_t len = 0; len <= FORMAT_MAX_LEN && test_passed; len += 7) {
+        size_t enc_size = 0, dec_size = 0, pos = 0;
+        test_passed = base64_encode_ex(input, len, reference,
+                                       sizeof(reference), &enc_size,
+                                       NULL) == BASE64_SUCCESS;
+        for (size_t i = 0; i < enc_size; i++) {
+            uint32_t r = next_random();
+            // Mostly runs between groups, some inside them
+            if ((r & 0x1F) == 0 || ((r & 0x3) == 0 && i % 4 == 0)) {
+                size_t run = 1 + (r >> 8) % 5;
+                for (size_t k = 0; k < run; k++) {
+                    encoded[pos++] = spaces[(r >> (12 + 2 * k)) & 3];
+                }
+            }
+            encoded[pos++] = reference[i];
+        }
+        encoded[pos++] = '\n';
+
+        test_passed = test_passed &&
+                      base64_decode_ex(encoded, pos, decoded, sizeof(decoded),
+                                       &dec_size, &base64_options_mime) ==
+                          BASE64_SUCCESS &&
+                      bytes_equal(decoded, dec_size, input, len) &&
+                      base64_decode_ex(encoded, pos, decoded,
+                                       sizeof(decoded), &dec_size, NULL) ==
+                          BASE64_INVALID_CHARACTER;
+        if (!test_passed) {
+            printf("  Mismatch at %zu bytes\n", len);
+        }
+    }
+    return test_passed;
+}
+
+static bool run_error_test(void) {
+    const base64_options_t bad_lines = {BASE64_ALPHABET_STANDARD, true, 10,
+                                        false};
+    const struct {
+        const char *text;
+        const base64_options_t *options;
+        base64_status_t status;
+    } cases[] = {
+        {"QUJD+/==", &base64_options_url, BASE64_INVALID_CHARACTER},
+        {"QUJD-_==", NULL, BASE64_INVALID_CHARACTER},
+        {"QUI", NULL, BASE64_INVALID_LENGTH},
+        {"QUI", &base64_options_url, BASE64_SUCCESS},
+        {"QUI=", &base64_options_url, BASE64_SUCCESS},
+        {"Q", &base64_options_url, BASE64_INVALID_LENGTH},
+        {"QQ=", NULL, BASE64_INVALID_LENGTH},
+        {"Q===", NULL, BASE64_INVALID_CHARACTER},
+        {"QQ=A", NULL, BASE64_INVALID_CHARACTER},
+        {"QQ==QUJD", NULL, BASE64_INVALID_CHARACTER},
+        {"QQ==\r\n", &base64_options_mime, BASE64_SUCCESS},
+        {"QQ\r\n==", &base64_options_pem, BASE64_SUCCESS},
+        {"QUJD", &bad_lines, BASE64_INVALID_INPUT},
+    };
+    size_t size;
+    bool test_passed = true;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        base64_status_t status = base64_decode_ex(
+            (const uint8_t *)cases[i].text, strlen(cases[i].text), decoded,
+            sizeof(decoded), &size, cases[i].options);
+        if (status != cases[i].status) {
+            printf("  \"%s\": %s\n", cases[i].text,
+                   base64_get_error_string(status));
+            test_passed = false;
+        }
+    }
+    test_passed &= base64_encode_ex(input, 3, encoded, sizeof(encoded), &size,
+                                    &bad_lines) == BASE64_INVALID_INPUT;
+    test_passed &= base64_encoded_size_ex(3, &bad_lines) == 0;
+    test_passed &= base64_encode_ex(input, 100, encoded, 137, &size,
+                                    &base64_options_mime) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_decode_ex((const uint8_t *)"QUJD", 4, decoded, 2,
+                                    &size, NULL) == BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_decoded_max_size(7) == 5;
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x1B873593);
+    fill_random(input, sizeof(input));
+
+    bool all_tests_passed = true;
+    size_t tests_run = 0;
+
+    for (size_t b = 0; b < BACKENDS_COUNT; b++) {
+        if (!base64_set_backend(backends[b].backend)) {
+            printf("--- %s: not available, skipped ---\n", backends[b].name);
+            continue;
+        }
+        printf("--- %s ---\n", backends[b].name);
+
+        bool passed = run_vector_test();
+        printf("  Alphabet vectors: %s\n", passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+
+        passed = run_layout_test();
+        printf("  Lines and padding, 0 to %d bytes: %s\n", FORMAT_MAX_LEN,
+               passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+
+        passed = run_whitespace_test();
+        printf("  Whitespace skipping: %s\n", passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+
+        passed = run_error_test();
+        printf("  Error handling: %s\n", passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+        tests_run += 4;
+    }
+    base64_set_backend(BASE64_BACKEND_SCALAR);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", tests_run);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base64.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "BASE64 multi-threaded tester";
+
+/* Well above BASE64_PARALLEL_THRESHOLD, not a multiple of 3 */
+#define PARALLEL_INPUT_SIZE (1024 * 1024 + 1)
+
+/* Enough text for any of the layouts below, and for a space after every
+ * MIME line */
+#define PARALLEL_TEXT_SIZE \
+    (PARALLEL_INPUT_SIZE / 3 * 4 + 4 + PARALLEL_INPUT_SIZE / 16)
+
+typedef struct {
+    const char *description;
+    size_t num_threads;  // 0 selects the process-wide default pool
+} ParallelTestCase;
+
+static const ParallelTestCase test_cases[] = {
+    {"Process-wide pool", 0},
+    {"Own pool, four threads", 4},
+    {"Own pool, three threads", 3},
+    {"Own pool, single thread", 1},
+};
+
+#define PARALLEL_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+/* Standard, URL, MIME and PEM, and unwrapped text without padding */
+static const base64_options_t unpadded = {BASE64_ALPHABET_STANDARD, false, 0,
+                                          false};
+static const base64_options_t *variants[] = {
+    &base64_options_standard, &base64_options_url, &base64_options_mime,
+    &base64_options_pem, &unpadded};
+
+#define VARIANTS_COUNT (sizeof(variants) / sizeof(variants[0]))
+
+static uint8_t input[PARALLEL_INPUT_SIZE];
+static uint8_t expected[PARALLEL_TEXT_SIZE];
+static uint8_t encoded[PARALLEL_TEXT_SIZE];
+static uint8_t decoded[PARALLEL_TEXT_SIZE];
+
+/* Split output must match the single-threaded functions for every layout,
+ * for sizes around the threshold and odd remainders */
+static bool run_round_trip_test(void) {
+    static const size_t sizes[] = {0, 100, BASE64_PARALLEL_THRESHOLD - 1,
+                                   BASE64_PARALLEL_THRESHOLD,
+                                   BASE64_PARALLEL_THRESHOLD + 1,
+                                   PARALLEL_INPUT_SIZE - 1,
+                                   PARALLEL_INPUT_SIZE};
+    bool test_passed = true;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for (size_t v = 0; v < VARIANTS_COUNT && test_passed; v++) {
+            const base64_options_t *options = variants[v];
+            size_t len = sizes[s];
+            size_t exp_size = 0, enc_size = 0, dec_size = 0;
+            test_passed =
+                base64_encode_ex(input, len, expected, sizeof(expected),
+                                 &exp_size, options) == BASE64_SUCCESS &&
+                base64_encode_parallel(input, len, encoded, sizeof(encoded),
+                                       &enc_size, options) ==
+                    BASE64_SUCCESS &&
+                bytes_equal(encoded, enc_size, expected, exp_size) &&
+                base64_decode_parallel(encoded, enc_size, decoded,
+                                       sizeof(decoded), &dec_size,
+                                       options) == BASE64_SUCCESS &&
+                bytes_equal(decoded, dec_size, input, len);
+            if (!test_passed) {
+                printf("  Mismatch at %zu bytes, variant %zu\n", len, v);
+            }
+        }
+    }
+    return test_passed;
+}
+
+/* Errors in any segment are reported as by base64_decode_ex() */
+static bool run_error_test(void) {
+    size_t enc_size = 0, size;
+    bool test_passed = true;
+
+    test_passed &= base64_encode_parallel(input, PARALLEL_INPUT_SIZE - 2,
+                                          encoded, sizeof(encoded),
+                                          &enc_size, NULL) == BASE64_SUCCESS;
+    // First, middle and last segment
+    const size_t positions[] = {0, enc_size / 2, enc_size - 8};
+    for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        size_t pos = positions[i] / 4 * 4;
+        uint8_t saved[4];
+        memcpy(saved, encoded + pos, 4);
+
+        // Padding before the end, then a character outside the alphabet
+        memcpy(encoded + pos, "QQ==", 4);
+        test_passed &= base64_decode_parallel(encoded, enc_size, decoded,
+                                              sizeof(decoded), &size,
+                                              NULL) ==
+                       BASE64_INVALID_CHARACTER;
+        memcpy(encoded + pos, "QU!D", 4);
+        test_passed &= base64_decode_parallel(encoded, enc_size, decoded,
+                                              sizeof(decoded), &size,
+                                              NULL) ==
+                       BASE64_INVALID_CHARACTER;
+        memcpy(encoded + pos, saved, 4);
+    }
+    test_passed &= base64_decode_parallel(encoded, enc_size - 1, decoded,
+                                          sizeof(decoded), &size, NULL) ==
+                   BASE64_INVALID_LENGTH;
+    test_passed &= base64_decode_parallel(encoded, enc_size, decoded,
+                                          PARALLEL_INPUT_SIZE - 3, &size,
+                                          NULL) == BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_parallel(input, PARALLEL_INPUT_SIZE, encoded,
+                                          PARALLEL_INPUT_SIZE / 3 * 4, &size,
+                                          NULL) == BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_parallel(NULL, 3, encoded, sizeof(encoded),
+                                          &size, NULL) ==
+                   BASE64_INVALID_INPUT;
+    return test_passed;
+}
+
+/* MIME text with stray whitespace is decoded by the calling thread */
+static bool run_whitespace_test(void) {
+    size_t enc_size = 0, dec_size = 0;
+    bool test_passed =
+        base64_encode_parallel(input, PARALLEL_INPUT_SIZE, encoded,
+                               sizeof(encoded), &enc_size,
+                               &base64_options_mime) == BASE64_SUCCESS;
+
+    // A space in each line, so the text is no longer evenly laid out
+    size_t pos = 0;
+    for (size_t i = 0; test_passed && i < enc_size; i++) {
+        expected[pos++] = encoded[i];
+        if (encoded[i] == '\n') {
+            expected[pos++] = ' ';
+        }
+    }
+    test_passed = test_passed &&
+                  base64_decode_parallel(expected, pos, decoded,
+                                         sizeof(decoded), &dec_size,
+                                         &base64_options_mime) ==
+                      BASE64_SUCCESS &&
+                  bytes_equal(decoded, dec_size, input, PARALLEL_INPUT_SIZE);
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x85EBCA6B);
+    printf("Online processors: %zu\n", thread_pool_get_cpu_count());
+    printf("Threshold: %d bytes\n\n", BASE64_PARALLEL_THRESHOLD);
+    fill_random(input, sizeof(input));
+
+    bool all_tests_passed = true;
+
+    for (size_t i = 0; i < PARALLEL_TESTS_COUNT; i++) {
+        const ParallelTestCase *tc = &test_cases[i];
+        // Own pools are forced to a thread count, so splitting runs on any
+        // machine
+        thread_pool_t *pool = NULL;
+        if (tc->num_threads != 0) {
+            pool = thread_pool_create(tc->num_threads);
+            if (pool == NULL) {
+                printf("Failed to create a pool of %zu threads\n",
+                       tc->num_threads);
+                all_tests_passed = false;
+                continue;
+            }
+        }
+        base64_set_thread_pool(pool);
+
+        bool passed = run_round_trip_test();
+        printf("Test %zu (%s): %s\n", i + 1, tc->description,
+               passed ? "PASSED" : "FAILED");
+        all_tests_passed &= passed;
+
+        base64_set_thread_pool(NULL);
+        thread_pool_destroy(pool);
+    }
+
+    thread_pool_t *pool = thread_pool_create(4);
+    base64_set_thread_pool(pool);
+    bool passed = pool != NULL && run_error_test();
+    printf("Test %zu (Error handling): %s\n", PARALLEL_TESTS_COUNT + 1,
+           passed ? "PASSED" : "FAILED");
+    all_tests_passed &= passed;
+
+    passed = pool != NULL && run_whitespace_test();
+    printf("Test %zu (Whitespace skipping): %s\n", PARALLEL_TESTS_COUNT + 2,
+           passed ? "PASSED" : "FAILED");
+    all_tests_passed &= passed;
+    base64_set_thread_pool(NULL);
+    thread_pool_destroy(pool);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", PARALLEL_TESTS_COUNT + 2);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base64.h"
+#include "test_random.h"
+#include "test_utils.h"
+
+static const char *TEST_NAME = "BASE64 streaming tester";
+
+/* Not a multiple of 3, so the stream always ends with padding */
+#define STREAM_INPUT_SIZE (64 * 1024 + 2)
+#define STREAM_ENCODED_SIZE (((STREAM_INPUT_SIZE + 2) / 3) * 4)
+
+/* Chunk sizes cycled through while feeding a stream */
+static const size_t chunk_sizes[] = {1, 2, 3, 4, 5, 7, 16, 61, 64, 1000, 4099};
+
+#define CHUNK_SIZES_COUNT (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))
+
+static uint8_t input[STREAM_INPUT_SIZE];
+static uint8_t expected[STREAM_ENCODED_SIZE];
+static uint8_t streamed[STREAM_ENCODED_SIZE];
+static uint8_t decoded[STREAM_INPUT_SIZE];
+
+/* Encodes input[0..len) in chunks starting at chunk_sizes[first] */
+static bool stream_encode(size_t len, size_t first, size_t *out_len) {
+    base64_converter_t converter;
+    size_t pos = 0, out = 0, k = first;
+    size_t size;
+
+    if (base64_init(&converter, NULL, 0) != BASE64_SUCCESS) {
+        return false;
+    }
+    while (pos < len) {
+        size_t n = chunk_sizes[k++ % CHUNK_SIZES_COUNT];
+        n = (n < len - pos) ? n : len - pos;
+        if (base64_encode_update(&converter, input + pos, n, streamed + out,
+                                 base64_encoded_size(n), &size) !=
+            BASE64_SUCCESS) {
+            return false;
+        }
+        pos += n;
+        out += size;
+    }
+    if (base64_encode_final(&converter, streamed + out, 4, &size) !=
+        BASE64_SUCCESS) {
+        return false;
+    }
+    *out_len = out + size;
+    return true;
+}
+
+/* Decodes text[0..len) in chunks starting at chunk_sizes[first] */
+static base64_status_t stream_decode(const uint8_t *text, size_t len,
+                                     size_t first, size_t *out_len) {
+    base64_converter_t converter;
+    size_t pos = 0, out = 0, k = first;
+    size_t size;
+    base64_status_t status = base64_init(&converter, NULL, 0);
+
+    while (status == BASE64_SUCCESS && pos < len) {
+        size_t n = chunk_sizes[k++ % CHUNK_SIZES_COUNT];
+        n = (n < len - pos) ? n : len - pos;
+        status = base64_decode_update(&converter, text + pos, n,
+                                      decoded + out, (n + 3) / 4 * 3, &size);
+        if (status == BASE64_SUCCESS) {
+            pos += n;
+            out += size;
+        }
+    }
+    if (status == BASE64_SUCCESS) {
+        status = base64_decode_final(&converter);
+    }
+    *out_len = out;
+    return status;
+}
+
+/* Streamed output must match the one-shot functions for every split */
+static bool run_round_trip_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Chunked round trips ---\n");
+    for (size_t len = 0; len <= STREAM_INPUT_SIZE && test_passed;
+         len = (len < 64) ? len + 1 : len * 3 + 1) {
+        for (size_t first = 0; first < CHUNK_SIZES_COUNT && test_passed;
+             first++) {
+            size_t enc_size = 0, stream_size = 0, dec_size = 0;
+            test_passed =
+                base64_encode_to(input, len, expected, sizeof(expected),
+                                 &enc_size) == BASE64_SUCCESS &&
+                stream_encode(len, first, &stream_size) &&
+                bytes_equal(streamed, stream_size, expected, enc_size) &&
+                stream_decode(expected, enc_size, first, &dec_size) ==
+                    BASE64_SUCCESS &&
+                bytes_equal(decoded, dec_size, input, len);
+            if (!test_passed) {
+                printf("  Mismatch at %zu bytes, first chunk %zu\n", len,
+                       chunk_sizes[first]);
+            }
+        }
+    }
+    printf("Round trip test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Padding inside the stream, truncated streams and small buffers */
+static bool run_error_test(void) {
+    base64_converter_t converter;
+    uint8_t out[16];
+    size_t size;
+    bool test_passed = true;
+
+    printf("\n--- Error handling ---\n");
+    test_passed &= stream_decode((const uint8_t *)"QQ==QUJD", 8, 0, &size) ==
+                   BASE64_INVALID_CHARACTER;
+    test_passed &= stream_decode((const uint8_t *)"QQ==QUJD", 8, 9, &size) ==
+                   BASE64_INVALID_CHARACTER;
+    test_passed &= stream_decode((const uint8_t *)"QQ=A", 4, 0, &size) ==
+                   BASE64_INVALID_CHARACTER;
+    test_passed &= stream_decode((const uint8_t *)"QUJDR", 5, 0, &size) ==
+                   BASE64_INVALID_LENGTH;
+    test_passed &= stream_decode((const uint8_t *)"QU!D", 4, 1, &size) ==
+                   BASE64_INVALID_CHARACTER;
+
+    // A padded group completed across calls ends the stream
+    test_passed &= base64_init(&converter, NULL, 0) == BASE64_SUCCESS;
+    test_passed &= base64_decode_update(&converter, (const uint8_t *)"QUJDQQ=",
+                                        7, out, sizeof(out), &size) ==
+                       BASE64_SUCCESS &&
+                   size == 3;
+    test_passed &= base64_decode_update(&converter, (const uint8_t *)"=", 1,
+                                        out, sizeof(out), &size) ==
+                       BASE64_SUCCESS &&
+                   size == 1 && out[0] == 'A';
+    test_passed &= base64_decode_update(&converter, NULL, 0, out, sizeof(out),
+                                        &size) == BASE64_SUCCESS;
+    test_passed &= base64_decode_update(&converter, (const uint8_t *)"QUJD", 4,
+                                        out, sizeof(out), &size) ==
+                   BASE64_INVALID_CHARACTER;
+
+    // Output buffers too small for the groups completed by a chunk
+    test_passed &= base64_init(&converter, NULL, 0) == BASE64_SUCCESS;
+    test_passed &= base64_encode_update(&converter, input, 2, out, 0, &size) ==
+                       BASE64_SUCCESS &&
+                   size == 0;
+    test_passed &= base64_encode_update(&converter, input, 2, out, 3, &size) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_final(&converter, out, 3, &size) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_final(&converter, out, 4, &size) ==
+                       BASE64_SUCCESS &&
+                   size == 4;
+    test_passed &= base64_encode_final(&converter, out, 0, &size) ==
+                       BASE64_SUCCESS &&
+                   size == 0;
+    test_passed &= base64_decode_update(&converter, (const uint8_t *)"QUJD", 4,
+                                        out, 2, &size) ==
+                   BASE64_BUFFER_TOO_SMALL;
+    test_passed &= base64_encode_update(NULL, input, 2, out, 4, &size) ==
+                   BASE64_INVALID_INPUT;
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("%s\n\n", TEST_NAME);
+    seed_random(0x9E3779B9);
+    fill_random(input, sizeof(input));
+
+    bool all_tests_passed = true;
+
+    if (!run_round_trip_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
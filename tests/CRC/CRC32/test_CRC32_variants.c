@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc.h"
+#include "crc_clmul.h"
+#include "crc_sse42.h"
+#include "test_utils.h"
+
+/* Lengths around the slicing step at every alignment, and around the
+ * folding threshold */
+#define SHORT_MAX_LEN 64
+#define FOLD_MAX_LEN (CRC_CLMUL_MIN_LEN + 80)
+#define MAX_OFFSET 16
+#define LONG_LEN (64 * 1024 + 13)
+
+/* Lengths around the interleaved blocks of the SSE4.2 engine */
+static const size_t block_lens[] = {
+    3 * CRC_SSE42_SHORT_BLOCK - 1,  3 * CRC_SSE42_SHORT_BLOCK,
+    3 * CRC_SSE42_SHORT_BLOCK + 9,  4096,
+    3 * CRC_SSE42_LONG_BLOCK - 1,   3 * CRC_SSE42_LONG_BLOCK,
+    3 * CRC_SSE42_LONG_BLOCK + 777,
+};
+
+static uint8_t long_buf[LONG_LEN + MAX_OFFSET];
+
+/**
+ * @brief Catalogue check value (CRC of "123456789") of every CRC32 variant
+ */
+static const struct {
+    crc_t type;
+    uint32_t check;
+} crc32_checks[] = {
+    {CRC32_D, 0x87315576},     {CRC32_Q, 0x3010BF7F},
+    {CRC32_C, 0xE3069283},     {CRC32_ISO, 0xCBF43926},
+    {CRC32_BZIP2, 0xFC891918}, {CRC32_MPEG_2, 0x0376E6E7},
+    {CRC32_POSIX, 0x765E7680}, {CRC32_JAMCRC, 0x340BC6D9},
+    {CRC32_XFER, 0xBD0BE338},
+};
+
+#define NUM_VARIANTS (sizeof(crc32_checks) / sizeof(crc32_checks[0]))
+
+static uint32_t reflect32(uint32_t value) {
+    uint32_t reflected = 0;
+    for (int i = 0; i < 32; i++) {
+        if (value & (1UL << i)) {
+            reflected |= 1UL << (31 - i);
+        }
+    }
+    return reflected;
+}
+
+/**
+ * @brief Bit-by-bit reference of the Rocksoft model
+ */
+static uint32_t reference_crc32(const uint8_t *data, size_t len, crc_t type) {
+    uint32_t poly = CRC32_getPoly(type);
+    uint32_t crc = CRC32_getSeed(type);
+    bool refin = CRC_getInputReflected(type);
+
+    for (size_t i = 0; i < len; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            int in = refin ? (data[i] >> bit) & 1 : (data[i] >> (7 - bit)) & 1;
+            bool msb = ((crc >> 31) & 1) != (uint32_t)in;
+            crc <<= 1;
+            if (msb) {
+                crc ^= poly;
+            }
+        }
+    }
+    if (CRC_getOutputReflected(type)) {
+        crc = reflect32(crc);
+    }
+    return crc ^ CRC32_getFinalXOR(type);
+}
+
+static void print_engine(void) {
+    printf("=== CRC32 Engine ===\n");
+#if CRC32_USE_LOOKUP_TABLE
+    printf("Lookup tables: slice-by-%d\n", CRC32_SLICE_BY);
+#else
+    printf("Lookup tables: none (bit-by-bit)\n");
+#endif
+    printf("Carry-less multiplication: %s\n",
+           CRC_clmul_available() ? "yes" : "no");
+    printf("SSE4.2 CRC32C: %s\n", CRC_sse42_available() ? "yes" : "no");
+    printf("====================\n");
+}
+
+static bool run_check_value_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Check value test ---\n");
+    for (size_t i = 0; i < NUM_VARIANTS; i++) {
+        uint32_t crc = 0;
+        crc_error_t err = CRC32_Calculate("123456789", 9, crc32_checks[i].type,
+                                          &crc);
+        bool passed = (err == CRC_SUCCESS) && (crc == crc32_checks[i].check);
+        printf("  %-14s 0x%08X: %s\n",
+               get_crc_implementation_name(crc32_checks[i].type), crc,
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Check value test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Every length and alignment against the bit-by-bit reference */
+static bool run_reference_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Reference test ---\n");
+    for (size_t i = 0; i < sizeof(long_buf); i++) {
+        long_buf[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    for (size_t i = 0; i < NUM_VARIANTS; i++) {
+        crc_t type = crc32_checks[i].type;
+        bool passed = true;
+        for (size_t offset = 0; offset < MAX_OFFSET; offset++) {
+            for (size_t len = 0; len <= SHORT_MAX_LEN; len++) {
+                passed &= CRC32(long_buf + offset, len, type) ==
+                          reference_crc32(long_buf + offset, len, type);
+            }
+        }
+        for (size_t len = CRC_CLMUL_MIN_LEN - 1; len <= FOLD_MAX_LEN; len++) {
+            passed &= CRC32(long_buf + 1, len, type) ==
+                      reference_crc32(long_buf + 1, len, type);
+        }
+        for (size_t j = 0; j < sizeof(block_lens) / sizeof(block_lens[0]);
+             j++) {
+            passed &= CRC32(long_buf + 5, block_lens[j], type) ==
+                      reference_crc32(long_buf + 5, block_lens[j], type);
+        }
+        passed &= CRC32(long_buf + 3, LONG_LEN, type) ==
+                  reference_crc32(long_buf + 3, LONG_LEN, type);
+        printf("  %-14s: %s\n", get_crc_implementation_name(type),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Reference test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC32 Variants Test ===\n\n");
+    print_engine();
+
+    bool all_tests_passed = true;
+
+    if (!run_check_value_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_reference_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc.h"
+#include "crc_clmul.h"
+#include "test_utils.h"
+
+/* Lengths around the slicing step at every alignment, and around the
+ * folding threshold */
+#define SHORT_MAX_LEN 64
+#define FOLD_MAX_LEN (CRC_CLMUL_MIN_LEN + 80)
+#define MAX_OFFSET 16
+#define LONG_LEN (64 * 1024 + 13)
+
+static uint8_t long_buf[LONG_LEN + MAX_OFFSET];
+
+/**
+ * @brief Catalogue check value (CRC of "123456789") of every CRC64 variant
+ */
+static const struct {
+    crc_t type;
+    uint64_t check;
+} crc64_checks[] = {
+    {CRC64_ECMA_182, 0x6C40DF5F0B497347ULL},
+    {CRC64_GO_ISO, 0xB90956C775A41001ULL},
+    {CRC64_XZ, 0x995DC9BBDF1939FAULL},
+    {CRC64_NVME, 0xAE8B14860A799888ULL},
+};
+
+#define NUM_VARIANTS (sizeof(crc64_checks) / sizeof(crc64_checks[0]))
+
+static uint64_t reflect64(uint64_t value) {
+    uint64_t reflected = 0;
+    for (int i = 0; i < 64; i++) {
+        if (value & (1ULL << i)) {
+            reflected |= 1ULL << (63 - i);
+        }
+    }
+    return reflected;
+}
+
+/**
+ * @brief Bit-by-bit reference of the Rocksoft model
+ */
+static uint64_t reference_crc64(const uint8_t *data, size_t len, crc_t type) {
+    uint64_t poly = CRC64_getPoly(type);
+    uint64_t crc = CRC64_getSeed(type);
+    bool refin = CRC_getInputReflected(type);
+
+    for (size_t i = 0; i < len; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            int in = refin ? (data[i] >> bit) & 1 : (data[i] >> (7 - bit)) & 1;
+            bool msb = ((crc >> 63) & 1) != (uint64_t)in;
+            crc <<= 1;
+            if (msb) {
+                crc ^= poly;
+            }
+        }
+    }
+    if (CRC_getOutputReflected(type)) {
+        crc = reflect64(crc);
+    }
+    return crc ^ CRC64_getFinalXOR(type);
+}
+
+static void print_engine(void) {
+    printf("=== CRC64 Engine ===\n");
+#if CRC64_USE_LOOKUP_TABLE
+    printf("Lookup tables: slice-by-%d\n", CRC64_SLICE_BY);
+#else
+    printf("Lookup tables: none (bit-by-bit)\n");
+#endif
+    printf("Carry-less multiplication: %s\n",
+           CRC_clmul_available() ? "yes" : "no");
+    printf("====================\n");
+}
+
+static bool run_check_value_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Check value test ---\n");
+    for (size_t i = 0; i < NUM_VARIANTS; i++) {
+        uint64_t crc = 0;
+        crc_error_t err = CRC64_Calculate("123456789", 9, crc64_checks[i].type,
+                                          &crc);
+        bool passed = (err == CRC_SUCCESS) && (crc == crc64_checks[i].check);
+        printf("  %-14s 0x%016llX: %s\n",
+               get_crc_implementation_name(crc64_checks[i].type),
+               (unsigned long long)crc, passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Check value test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Every length and alignment against the bit-by-bit reference */
+static bool run_reference_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Reference test ---\n");
+    for (size_t i = 0; i < sizeof(long_buf); i++) {
+        long_buf[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    for (size_t i = 0; i < NUM_VARIANTS; i++) {
+        crc_t type = crc64_checks[i].type;
+        bool passed = true;
+        for (size_t offset = 0; offset < MAX_OFFSET; offset++) {
+            for (size_t len = 0; len <= SHORT_MAX_LEN; len++) {
+                passed &= CRC64(long_buf + offset, len, type) ==
+                          reference_crc64(long_buf + offset, len, type);
+            }
+        }
+        for (size_t len = CRC_CLMUL_MIN_LEN - 1; len <= FOLD_MAX_LEN; len++) {
+            passed &= CRC64(long_buf + 1, len, type) ==
+                      reference_crc64(long_buf + 1, len, type);
+        }
+        passed &= CRC64(long_buf + 3, LONG_LEN, type) ==
+                  reference_crc64(long_buf + 3, LONG_LEN, type);
+        printf("  %-14s: %s\n", get_crc_implementation_name(type),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Reference test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Streamed in uneven pieces, then validated with the CRC appended */
+static bool run_stream_validation_test(void) {
+    static const size_t pieces[] = {1, 7, 200, 8, 3000, 13};
+    bool test_passed = true;
+
+    printf("\n--- Streaming and validation test ---\n");
+    for (size_t i = 0; i < NUM_VARIANTS; i++) {
+        crc_t type = crc64_checks[i].type;
+        crc_ctx_t ctx;
+        uint64_t crc = 0;
+        bool passed = CRC_Init(&ctx, type) == CRC_SUCCESS;
+        size_t pos = 0;
+        for (size_t j = 0; passed && pos < LONG_LEN; j++) {
+            size_t n = pieces[j % (sizeof(pieces) / sizeof(pieces[0]))];
+            n = (n < LONG_LEN - pos) ? n : LONG_LEN - pos;
+            passed &= CRC_Update(&ctx, long_buf + pos, n) == CRC_SUCCESS;
+            pos += n;
+        }
+        passed &= (CRC64_Finalize(&ctx, &crc) == CRC_SUCCESS) &&
+                  (crc == CRC64(long_buf, LONG_LEN, type));
+
+        uint8_t frame[64 + 8];
+        memcpy(frame, long_buf, 64);
+        crc = CRC64(frame, 64, type);
+        for (int b = 0; b < 8; b++) {
+            frame[64 + b] = (uint8_t)(crc >> (56 - 8 * b));
+        }
+        passed &= CRC64_ValidateAppended(frame, sizeof(frame), type) ==
+                  CRC_SUCCESS;
+        frame[10] ^= 0x01;
+        passed &= CRC64_ValidateAppended(frame, sizeof(frame), type) ==
+                  CRC_ERROR_CRC_MISMATCH;
+
+        printf("  %-14s: %s\n", get_crc_implementation_name(type),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+    uint32_t crc32 = 0;
+    crc_ctx_t ctx;
+    bool passed = (CRC_Init(&ctx, CRC64_XZ) == CRC_SUCCESS) &&
+                  (CRC_Finalize(&ctx, &crc32) == CRC_ERROR_INVALID_TYPE) &&
+                  (CRC64_Calculate("1", 1, CRC32_ISO, NULL) ==
+                   CRC_ERROR_NULL_DATA) &&
+                  (CRC64(long_buf, 1, CRC32_ISO) == 0) &&
+                  (CRC64_ValidateAppended(long_buf, 7, CRC64_XZ) ==
+                   CRC_ERROR_ZERO_LENGTH);
+    printf("  Invalid arguments rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Streaming and validation test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC64 Variants Test ===\n\n");
+    print_engine();
+
+    bool all_tests_passed = true;
+
+    if (!run_check_value_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_reference_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_stream_validation_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 3\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "test_utils.h"
+
+#define COMBINE_DATA_LEN (256 * 1024 + 3)
+
+static uint8_t data[COMBINE_DATA_LEN];
+
+/* Split points of the buffer, from both ends */
+static const size_t split_points[] = {1,    2,    7,     16,   100,
+                                      4096, 4097, 65536, 99999};
+#define SPLIT_POINTS_COUNT (sizeof(split_points) / sizeof(split_points[0]))
+
+static uint64_t crc_of(const void *buf, size_t len, crc_t type) {
+    if (type <= CRC8_LTE) {
+        return CRC8(buf, len, type);
+    }
+    if (type <= CRC16_CDMA2000) {
+        return CRC16(buf, len, type);
+    }
+    if (type <= CRC32_XFER) {
+        return CRC32(buf, len, type);
+    }
+    return CRC64(buf, len, type);
+}
+
+static uint64_t combine(uint64_t crc_a, uint64_t crc_b, uint64_t len_b,
+                        crc_t type) {
+    if (type <= CRC8_LTE) {
+        return CRC8_combine((uint8_t)crc_a, (uint8_t)crc_b, len_b, type);
+    }
+    if (type <= CRC16_CDMA2000) {
+        return CRC16_combine((uint16_t)crc_a, (uint16_t)crc_b, len_b, type);
+    }
+    if (type <= CRC32_XFER) {
+        return CRC32_combine((uint32_t)crc_a, (uint32_t)crc_b, len_b, type);
+    }
+    return CRC64_combine(crc_a, crc_b, len_b, type);
+}
+
+/* Two segments split at various points, for every variant */
+static bool run_split_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Two segments test ---\n");
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        crc_t type = (crc_t)t;
+        uint64_t whole = crc_of(data, COMBINE_DATA_LEN, type);
+        bool passed = true;
+        for (size_t i = 0; i < SPLIT_POINTS_COUNT; i++) {
+            for (int from_end = 0; from_end < 2; from_end++) {
+                size_t len_a = from_end ? COMBINE_DATA_LEN - split_points[i]
+                                        : split_points[i];
+                size_t len_b = COMBINE_DATA_LEN - len_a;
+                uint64_t crc_a = crc_of(data, len_a, type);
+                uint64_t crc_b = crc_of(data + len_a, len_b, type);
+                passed &= combine(crc_a, crc_b, len_b, type) == whole;
+            }
+        }
+        printf("  %-20s: %s\n", get_crc_implementation_name(type),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Two segments test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Per-block CRCs folded left to right, as a parallel checksum would */
+static bool run_blocks_test(void) {
+    const size_t block_len = 10000;
+    bool test_passed = true;
+
+    printf("\n--- Block list test ---\n");
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        crc_t type = (crc_t)t;
+        uint64_t crc = crc_of(data, block_len, type);
+        for (size_t pos = block_len; pos < COMBINE_DATA_LEN;
+             pos += block_len) {
+            size_t len = COMBINE_DATA_LEN - pos;
+            len = (len < block_len) ? len : block_len;
+            crc = combine(crc, crc_of(data + pos, len, type), len, type);
+        }
+        bool passed = crc == crc_of(data, COMBINE_DATA_LEN, type);
+        // Appending nothing leaves the CRC unchanged
+        passed &= combine(crc, 0x1234, 0, type) == crc;
+        if (!passed) {
+            printf("  %-20s: FAILED\n", get_crc_implementation_name(type));
+        }
+        test_passed &= passed;
+    }
+    printf("Block list test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Combine Test ===\n");
+
+    for (size_t i = 0; i < COMBINE_DATA_LEN; i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 11);
+    }
+
+    bool all_tests_passed = true;
+
+    if (!run_split_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_blocks_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
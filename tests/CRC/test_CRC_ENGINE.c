@@ -0,0 +1,240 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "crc_engine.h"
+#include "test_utils.h"
+
+#define ENGINE_DATA_LEN (16 * 1024 + 5)
+
+static uint8_t data[ENGINE_DATA_LEN];
+
+typedef struct {
+    const char *name;
+    crc_params_t params;
+    uint64_t check;  // CRC of "123456789"
+} EngineTestCase;
+
+/* Entries of the reveng catalogue without a crc_t variant */
+static const EngineTestCase test_cases[] = {
+    {"CRC-3/GSM", {3, 0x3, 0x0, false, false, 0x7}, 0x4},
+    {"CRC-4/G-704", {4, 0x3, 0x0, true, true, 0x0}, 0x7},
+    {"CRC-5/USB", {5, 0x05, 0x1F, true, true, 0x1F}, 0x19},
+    {"CRC-6/G-704", {6, 0x03, 0x0, true, true, 0x0}, 0x06},
+    {"CRC-7/MMC", {7, 0x09, 0x0, false, false, 0x0}, 0x75},
+    {"CRC-10/ATM", {10, 0x233, 0x0, false, false, 0x0}, 0x199},
+    {"CRC-12/UMTS", {12, 0x80F, 0x0, false, true, 0x0}, 0xDAF},
+    {"CRC-15/CAN", {15, 0x4599, 0x0, false, false, 0x0}, 0x059E},
+    {"CRC-17/CAN-FD", {17, 0x1685B, 0x0, false, false, 0x0}, 0x04F03},
+    {"CRC-21/CAN-FD", {21, 0x102899, 0x0, false, false, 0x0}, 0x0ED841},
+    {"CRC-24/OPENPGP", {24, 0x864CFB, 0xB704CE, false, false, 0x0}, 0x21CF02},
+    {"CRC-31/PHILIPS",
+     {31, 0x04C11DB7, 0x7FFFFFFF, false, false, 0x7FFFFFFF},
+     0x0CE9E46C},
+    {"CRC-32/AUTOSAR",
+     {32, 0xF4ACFB13, 0xFFFFFFFF, true, true, 0xFFFFFFFF},
+     0x1697D06A},
+    {"CRC-40/GSM",
+     {40, 0x0004820009ULL, 0x0, false, false, 0xFFFFFFFFFFULL},
+     0xD4164FC646ULL},
+    {"CRC-64/WE",
+     {64, 0x42F0E1EBA9EA3693ULL, ~0ULL, false, false, ~0ULL},
+     0x62EC59E3F1A4F00AULL},
+    {"CRC-64/MS",
+     {64, 0x259C84CBA6426349ULL, ~0ULL, true, true, 0x0},
+     0x75D4B74F024ECEEAULL},
+};
+
+#define ENGINE_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+/* Straight bit-by-bit Rocksoft model, as in the catalogue definition */
+static uint64_t reflect(uint64_t value, uint8_t width) {
+    uint64_t out = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        out = (out << 1) | ((value >> i) & 1);
+    }
+    return out;
+}
+
+static uint64_t reference_crc(const crc_params_t *p, const uint8_t *buf,
+                              size_t len) {
+    uint64_t top = 1ULL << (p->width - 1);
+    uint64_t mask = top | (top - 1);
+    uint64_t reg = p->init & mask;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = p->refin ? (uint8_t)reflect(buf[i], 8) : buf[i];
+        for (int bit = 7; bit >= 0; bit--) {
+            bool feedback = ((reg & top) != 0) != (((byte >> bit) & 1) != 0);
+            reg = (reg << 1) & mask;
+            if (feedback) {
+                reg ^= p->poly;
+            }
+        }
+    }
+    if (p->refout) {
+        reg = reflect(reg, p->width);
+    }
+    return reg ^ (p->xorout & mask);
+}
+
+/* Streams buf in pieces of growing size through the engine */
+static bool engine_crc(const crc_params_t *p, const uint8_t *buf, size_t len,
+                       uint64_t *result) {
+    crc_engine_ctx_t ctx;
+    if (CRC_Engine_Init(&ctx, p) != CRC_SUCCESS) {
+        return false;
+    }
+    size_t pos = 0;
+    for (size_t piece = 1; pos < len; piece = piece * 3 + 1) {
+        size_t n = (len - pos < piece) ? len - pos : piece;
+        if (CRC_Engine_Update(&ctx, buf + pos, n) != CRC_SUCCESS) {
+            return false;
+        }
+        pos += n;
+    }
+    return CRC_Engine_Finalize(&ctx, result) == CRC_SUCCESS;
+}
+
+/* Check values and random data against the bit-by-bit model */
+static bool run_catalogue_test(void) {
+    const uint8_t check_data[] = "123456789";
+    const size_t lens[] = {0, 1, 7, 8, 9, 63, 1000, ENGINE_DATA_LEN};
+    bool test_passed = true;
+
+    printf("\n--- Catalogue test ---\n");
+    for (size_t i = 0; i < ENGINE_TESTS_COUNT; i++) {
+        const EngineTestCase *tc = &test_cases[i];
+        uint64_t crc = 0;
+        bool passed = (CRC_Engine_Calculate(&tc->params, check_data, 9,
+                                            &crc) == CRC_SUCCESS) &&
+                      (crc == tc->check);
+        for (size_t j = 0; j < sizeof(lens) / sizeof(lens[0]); j++) {
+            uint64_t streamed = 0;
+            passed &= engine_crc(&tc->params, data, lens[j], &streamed) &&
+                      (streamed == reference_crc(&tc->params, data, lens[j]));
+        }
+        printf("  %-16s: 0x%016llX %s\n", tc->name, (unsigned long long)crc,
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Catalogue test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Every crc_t variant through the engine against CRC8/16/32/64 */
+static bool run_variants_test(void) {
+    const size_t lens[] = {1, 2, 8, 9, 100, ENGINE_DATA_LEN};
+    bool test_passed = true;
+
+    printf("\n--- Library variants test ---\n");
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        crc_t type = (crc_t)t;
+        crc_params_t params;
+        bool passed = CRC_getParams(type, &params) == CRC_SUCCESS;
+        for (size_t j = 0; passed && j < sizeof(lens) / sizeof(lens[0]);
+             j++) {
+            uint64_t crc = 0;
+            uint64_t expected = (type <= CRC8_LTE)
+                                    ? CRC8(data, lens[j], type)
+                                : (type <= CRC16_CDMA2000)
+                                    ? CRC16(data, lens[j], type)
+                                : (type <= CRC32_XFER)
+                                    ? CRC32(data, lens[j], type)
+                                    : CRC64(data, lens[j], type);
+            passed &= engine_crc(&params, data, lens[j], &crc) &&
+                      (crc == expected);
+        }
+        if (!passed) {
+            printf("  %-20s: FAILED\n", get_crc_implementation_name(type));
+        }
+        test_passed &= passed;
+    }
+    printf("Library variants test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* More polynomials than cache slots, so the last ones run bit by bit */
+static bool run_cache_overflow_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Cache overflow test ---\n");
+    for (uint64_t i = 0; i < 2 * CRC_ENGINE_CACHE_SLOTS; i++) {
+        crc_params_t params = {24, 0x800001 | (i << 4), 0xABCDEF, (i & 1) != 0,
+                               (i & 2) != 0, 0x123456};
+        uint64_t crc = 0;
+        test_passed &= engine_crc(&params, data, 1000, &crc) &&
+                       (crc == reference_crc(&params, data, 1000));
+    }
+    printf("Cache overflow test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_error_test(void) {
+    crc_params_t zero_width = {0, 0x1, 0, false, false, 0};
+    crc_params_t wide = {65, 0x1, 0, false, false, 0};
+    crc_params_t bad_poly = {8, 0x107, 0, false, false, 0};
+    crc_params_t params;
+    crc_engine_ctx_t ctx;
+    uint64_t crc = 0;
+    bool test_passed = true;
+
+    printf("\n--- Error handling test ---\n");
+
+    bool passed =
+        (CRC_Engine_Calculate(&zero_width, data, 1, &crc) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Engine_Calculate(&wide, data, 1, &crc) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Engine_Calculate(&bad_poly, data, 1, &crc) ==
+         CRC_ERROR_INVALID_POLYNOMIAL) &&
+        (CRC_getParams(CRC_IMPL_COUNT, &params) == CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Engine_Init(&ctx, NULL) == CRC_ERROR_NULL_DATA) &&
+        (CRC_Engine_Calculate(&test_cases[0].params, NULL, 1, &crc) ==
+         CRC_ERROR_NULL_DATA) &&
+        (CRC_Engine_Calculate(&test_cases[0].params, data, 1, NULL) ==
+         CRC_ERROR_NULL_DATA);
+    printf("  Invalid arguments rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Generic Engine Test ===\n");
+
+    for (size_t i = 0; i < ENGINE_DATA_LEN; i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 9);
+    }
+
+    bool all_tests_passed = true;
+
+    if (!run_catalogue_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_variants_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_cache_overflow_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 4\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "crc_engine.h"
+#include "test_utils.h"
+#include "thread_pool.h"
+
+/* Callers starting each polynomial at the same time */
+#define CACHE_THREADS 8
+
+/* Polynomials started concurrently, each expected to take a single slot */
+#define CACHE_KEYS 8
+
+typedef struct {
+    crc_params_t params;
+    const uint64_t (*tables[CACHE_THREADS])[256];
+    crc_error_t status[CACHE_THREADS];
+} CacheJob;
+
+static void init_task(void *arg, size_t index) {
+    CacheJob *job = (CacheJob *)arg;
+    crc_engine_ctx_t ctx;
+    job->status[index] = CRC_Engine_Init(&ctx, &job->params);
+    job->tables[index] = ctx.tables;
+}
+
+/* Parameters never used before in this process */
+static crc_params_t fresh_params(uint64_t i) {
+    crc_params_t params = {32, 0x04C11DB7 ^ (i << 8), 0xFFFFFFFF,
+                           (i & 1) != 0, (i & 1) != 0, 0xFFFFFFFF};
+    return params;
+}
+
+/* Every caller gets the tables of the one slot, or runs bit by bit */
+static bool run_first_use_test(thread_pool_t *pool) {
+    bool test_passed = true;
+
+    printf("\n--- Concurrent first use test ---\n");
+    for (uint64_t k = 0; k < CACHE_KEYS; k++) {
+        CacheJob job = {.params = fresh_params(k)};
+        crc_engine_ctx_t ctx;
+        thread_pool_run(pool, init_task, &job, CACHE_THREADS);
+
+        // The tables every later caller gets
+        bool passed = CRC_Engine_Init(&ctx, &job.params) == CRC_SUCCESS &&
+                      ctx.tables != NULL;
+        size_t sharing = 0;
+        for (size_t t = 0; t < CACHE_THREADS && passed; t++) {
+            passed = job.status[t] == CRC_SUCCESS &&
+                     (job.tables[t] == NULL || job.tables[t] == ctx.tables);
+            sharing += job.tables[t] != NULL;
+        }
+        printf("  Key %llu: %zu of %d callers on the cached tables: %s\n",
+               (unsigned long long)k, sharing, CACHE_THREADS,
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Concurrent first use test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* The slots left are exactly those not taken by the keys above */
+static bool run_slot_count_test(void) {
+    size_t cached = 0;
+    bool test_passed = true;
+
+    printf("\n--- Slot count test ---\n");
+    for (uint64_t k = CACHE_KEYS; k < CACHE_KEYS + CRC_ENGINE_CACHE_SLOTS;
+         k++) {
+        crc_params_t params = fresh_params(k);
+        crc_engine_ctx_t ctx;
+        test_passed &= CRC_Engine_Init(&ctx, &params) == CRC_SUCCESS;
+        cached += ctx.tables != NULL;
+    }
+    test_passed &= cached == CRC_ENGINE_CACHE_SLOTS - CACHE_KEYS;
+    printf("  New keys cached: %zu, expected %d\n", cached,
+           CRC_ENGINE_CACHE_SLOTS - CACHE_KEYS);
+    printf("Slot count test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Engine Table Cache Test ===\n");
+    printf("Online processors: %zu\n", thread_pool_get_cpu_count());
+
+    // Forced to one thread per caller, so first uses overlap on any machine
+    thread_pool_t *pool = thread_pool_create(CACHE_THREADS);
+    bool all_tests_passed = (pool != NULL);
+
+    if (!all_tests_passed || !run_first_use_test(pool)) {
+        all_tests_passed = false;
+    }
+
+    if (!run_slot_count_test()) {
+        all_tests_passed = false;
+    }
+    thread_pool_destroy(pool);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 2\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
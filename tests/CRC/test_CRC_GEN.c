@@ -0,0 +1,134 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "crc_engine.h"
+#include "test_utils.h"
+
+/* Generated at build time by crc_generate() in CMakeLists.txt */
+#include "crc8_maxim.h"
+#include "crc8_ccitt_s8.h"
+#include "crc16_modbus.h"
+#include "crc16_xmodem_s8.h"
+#include "crc32_iso_s8.h"
+#include "crc32_mpeg_2.h"
+#include "crc64_xz_s8.h"
+#include "crc64_ecma_182.h"
+#include "crc5_usb.h"
+#include "crc12_umts_s8.h"
+#include "crc40_gsm.h"
+
+#define GEN_DATA_LEN (4 * 1024 + 13)
+
+static uint8_t data[GEN_DATA_LEN];
+
+/* One-shot (piece 0) or streamed in pieces through a generated function */
+#define GENERATED_RUNNER(fn)                                                 \
+    static uint64_t run_##fn(const uint8_t *buf, size_t len, size_t piece) { \
+        if (piece == 0) {                                                    \
+            return fn(buf, len);                                             \
+        }                                                                    \
+        fn##_reg_t reg = fn##_init();                                        \
+        for (size_t pos = 0; pos < len; pos += piece) {                      \
+            size_t n = (len - pos < piece) ? len - pos : piece;              \
+            reg = fn##_update(reg, buf + pos, n);                            \
+        }                                                                    \
+        return fn##_finalize(reg);                                           \
+    }
+
+GENERATED_RUNNER(crc8_maxim)
+GENERATED_RUNNER(crc8_ccitt_s8)
+GENERATED_RUNNER(crc16_modbus)
+GENERATED_RUNNER(crc16_xmodem_s8)
+GENERATED_RUNNER(crc32_iso_s8)
+GENERATED_RUNNER(crc32_mpeg_2)
+GENERATED_RUNNER(crc64_xz_s8)
+GENERATED_RUNNER(crc64_ecma_182)
+GENERATED_RUNNER(crc5_usb)
+GENERATED_RUNNER(crc12_umts_s8)
+GENERATED_RUNNER(crc40_gsm)
+
+typedef struct {
+    const char *name;
+    uint64_t (*run)(const uint8_t *buf, size_t len, size_t piece);
+    uint64_t check;      // Generated CRC of "123456789"
+    crc_t crc_type;      // CRC_IMPL_COUNT for custom parameters
+    crc_params_t params;
+} GenTestCase;
+
+static GenTestCase test_cases[] = {
+    {"crc8_maxim", run_crc8_maxim, CRC8_MAXIM_CHECK, CRC8_MAXIM, {0}},
+    {"crc8_ccitt_s8", run_crc8_ccitt_s8, CRC8_CCITT_S8_CHECK, CRC8_CCITT, {0}},
+    {"crc16_modbus", run_crc16_modbus, CRC16_MODBUS_CHECK, CRC16_MODBUS, {0}},
+    {"crc16_xmodem_s8", run_crc16_xmodem_s8, CRC16_XMODEM_S8_CHECK,
+     CRC16_XMODEM, {0}},
+    {"crc32_iso_s8", run_crc32_iso_s8, CRC32_ISO_S8_CHECK, CRC32_ISO, {0}},
+    {"crc32_mpeg_2", run_crc32_mpeg_2, CRC32_MPEG_2_CHECK, CRC32_MPEG_2, {0}},
+    {"crc64_xz_s8", run_crc64_xz_s8, CRC64_XZ_S8_CHECK, CRC64_XZ, {0}},
+    {"crc64_ecma_182", run_crc64_ecma_182, CRC64_ECMA_182_CHECK,
+     CRC64_ECMA_182, {0}},
+    {"crc5_usb", run_crc5_usb, CRC5_USB_CHECK, CRC_IMPL_COUNT,
+     {5, 0x05, 0x1F, true, true, 0x1F}},
+    {"crc12_umts_s8", run_crc12_umts_s8, CRC12_UMTS_S8_CHECK, CRC_IMPL_COUNT,
+     {12, 0x80F, 0x0, false, true, 0x0}},
+    {"crc40_gsm", run_crc40_gsm, CRC40_GSM_CHECK, CRC_IMPL_COUNT,
+     {40, 0x0004820009ULL, 0x0, false, false, 0xFFFFFFFFFFULL}},
+};
+
+#define GEN_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+static bool run_single_test(GenTestCase *tc) {
+    const uint8_t check_data[] = "123456789";
+    const size_t lens[] = {0, 1, 7, 8, 9, 63, 1000, GEN_DATA_LEN};
+    const size_t pieces[] = {0, 1, 5, 8, 100};
+    bool passed = true;
+
+    if (tc->crc_type != CRC_IMPL_COUNT) {
+        passed &= CRC_getParams(tc->crc_type, &tc->params) == CRC_SUCCESS;
+    }
+
+    uint64_t expected = 0;
+    passed &= CRC_Engine_Calculate(&tc->params, check_data, 9, &expected) ==
+              CRC_SUCCESS;
+    passed &= (tc->check == expected) &&
+              (tc->run(check_data, 9, 0) == expected);
+
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        passed &= CRC_Engine_Calculate(&tc->params, data, lens[i],
+                                       &expected) == CRC_SUCCESS;
+        for (size_t j = 0; j < sizeof(pieces) / sizeof(pieces[0]); j++) {
+            passed &= tc->run(data, lens[i], pieces[j]) == expected;
+        }
+    }
+
+    printf("  %-16s: check 0x%016llX %s\n", tc->name,
+           (unsigned long long)tc->check, passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+int main(void) {
+    printf("=== CRC Generated Functions Test ===\n");
+
+    for (size_t i = 0; i < GEN_DATA_LEN; i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 11);
+    }
+
+    bool all_tests_passed = true;
+
+    printf("\n--- Generated functions against the generic engine ---\n");
+    for (size_t i = 0; i < GEN_TESTS_COUNT; i++) {
+        if (!run_single_test(&test_cases[i])) {
+            all_tests_passed = false;
+        }
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", GEN_TESTS_COUNT);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,237 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "crc_multi.h"
+#include "test_utils.h"
+
+#define MULTI_DATA_LEN (3 * CRC_MULTI_BLOCK_LEN + 21)
+
+static uint8_t data[MULTI_DATA_LEN + 8];
+
+/* CRC of one variant through the single-variant API */
+static uint64_t single_crc(const uint8_t *buf, size_t len, crc_t type) {
+    return (type <= CRC8_LTE)         ? CRC8(buf, len, type)
+           : (type <= CRC16_CDMA2000) ? CRC16(buf, len, type)
+           : (type <= CRC32_XFER)     ? CRC32(buf, len, type)
+                                      : CRC64(buf, len, type);
+}
+
+/* A frame protected by two CRCs */
+static bool run_pair_test(void) {
+    const crc_t types[] = {CRC16_MODBUS, CRC32_ISO};
+    uint64_t results[2] = {0};
+    bool test_passed = true;
+
+    printf("\n--- Two variants over one frame ---\n");
+    for (size_t len = 1; len <= 300; len += 13) {
+        test_passed &=
+            (CRC_Calculate_multi(data, len, types, 2, results) ==
+             CRC_SUCCESS) &&
+            (results[0] == single_crc(data, len, CRC16_MODBUS)) &&
+            (results[1] == single_crc(data, len, CRC32_ISO));
+    }
+    printf("Two variants test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Every variant at once, at several lengths and alignments */
+static bool run_all_variants_test(void) {
+    crc_t types[CRC_IMPL_COUNT];
+    uint64_t results[CRC_IMPL_COUNT];
+    const size_t lens[] = {1, 7, 8, 9, 100, CRC_MULTI_BLOCK_LEN + 1,
+                           MULTI_DATA_LEN};
+    bool test_passed = true;
+
+    printf("\n--- All %d variants in one pass ---\n", CRC_IMPL_COUNT);
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        types[t] = (crc_t)t;
+    }
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        for (size_t offset = 0; offset < 8; offset += 3) {
+            const uint8_t *buf = data + offset;
+            bool passed = CRC_Calculate_multi(buf, lens[i], types,
+                                              CRC_IMPL_COUNT,
+                                              results) == CRC_SUCCESS;
+            for (int t = 0; passed && t < CRC_IMPL_COUNT; t++) {
+                if (results[t] != single_crc(buf, lens[i], (crc_t)t)) {
+                    printf("  %s, %zu bytes: FAILED\n",
+                           get_crc_implementation_name((crc_t)t), lens[i]);
+                    passed = false;
+                }
+            }
+            test_passed &= passed;
+        }
+    }
+    printf("All variants test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Chunks of any size, repeated variants */
+static bool run_stream_test(void) {
+    const crc_t types[] = {CRC8_MAXIM, CRC32_C, CRC16_X25, CRC64_XZ,
+                           CRC8_MAXIM, CRC16_XMODEM, CRC32_BZIP2};
+    const size_t count = sizeof(types) / sizeof(types[0]);
+    const size_t pieces[] = {1, 5, 64, 4099, CRC_MULTI_BLOCK_LEN + 3};
+    uint64_t expected[sizeof(types) / sizeof(types[0])];
+    uint64_t results[sizeof(types) / sizeof(types[0])];
+    crc_multi_ctx_t ctx;
+    bool test_passed = true;
+
+    printf("\n--- Streamed chunks ---\n");
+    for (size_t i = 0; i < count; i++) {
+        expected[i] = single_crc(data, MULTI_DATA_LEN, types[i]);
+    }
+    for (size_t j = 0; j < sizeof(pieces) / sizeof(pieces[0]); j++) {
+        bool passed = CRC_Multi_Init(&ctx, types, count) == CRC_SUCCESS;
+        for (size_t pos = 0; passed && pos < MULTI_DATA_LEN;
+             pos += pieces[j]) {
+            size_t n = MULTI_DATA_LEN - pos;
+            n = (n < pieces[j]) ? n : pieces[j];
+            passed = CRC_Multi_Update(&ctx, data + pos, n) == CRC_SUCCESS;
+        }
+        passed &= CRC_Multi_Finalize(&ctx, results) == CRC_SUCCESS;
+        for (size_t i = 0; passed && i < count; i++) {
+            passed = results[i] == expected[i];
+        }
+        printf("  Chunks of %5zu bytes: %s\n", pieces[j],
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Streamed chunks test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Identification of the algorithm of a captured frame */
+static bool run_identify_test(void) {
+    const crc_t captured[] = {CRC16_MODBUS, CRC32_C, CRC8_MAXIM, CRC64_XZ};
+    crc_t matches[CRC_IMPL_COUNT];
+    bool test_passed = true;
+
+    printf("\n--- Identification ---\n");
+    for (size_t i = 0; i < sizeof(captured) / sizeof(captured[0]); i++) {
+        uint64_t crc = single_crc(data, 200, captured[i]);
+        size_t found = CRC_Multi_Identify(data, 200, crc, matches,
+                                          CRC_IMPL_COUNT);
+        bool passed = found >= 1 && found <= CRC_IMPL_COUNT;
+        bool listed = false;
+        for (size_t m = 0; passed && m < found; m++) {
+            listed |= matches[m] == captured[i];
+            passed = single_crc(data, 200, matches[m]) == crc;
+        }
+        passed &= listed;
+        printf("  %-14s: %zu match(es) %s\n",
+               get_crc_implementation_name(captured[i]), found,
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Identification test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/* Empty input gives what the single-variant API gives */
+static bool run_empty_test(void) {
+    crc_t types[CRC_MULTI_MAX_STREAMS];
+    uint64_t results[CRC_MULTI_MAX_STREAMS];
+    bool test_passed = true;
+
+    printf("\n--- Empty input ---\n");
+    for (int first = 0; first < CRC_IMPL_COUNT;
+         first += CRC_MULTI_MAX_STREAMS) {
+        size_t count = 0;
+        for (int t = first;
+             t < CRC_IMPL_COUNT && count < CRC_MULTI_MAX_STREAMS; t++) {
+            types[count++] = (crc_t)t;
+        }
+        bool passed = CRC_Calculate_multi(data, 0, types, count, results) ==
+                      CRC_SUCCESS;
+        for (size_t i = 0; passed && i < count; i++) {
+            if (results[i] != single_crc(data, 0, types[i])) {
+                printf("  %s: FAILED\n",
+                       get_crc_implementation_name(types[i]));
+                passed = false;
+            }
+        }
+        test_passed &= passed;
+    }
+    printf("Empty input test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_error_test(void) {
+    const crc_t types[] = {CRC16_MODBUS, CRC_IMPL_COUNT};
+    uint64_t results[2];
+    crc_multi_ctx_t ctx;
+    bool test_passed = true;
+
+    printf("\n--- Error handling test ---\n");
+
+    bool passed =
+        (CRC_Calculate_multi(data, 16, types, 0, results) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Calculate_multi(data, 16, types, CRC_MULTI_MAX_STREAMS + 1,
+                             results) == CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Calculate_multi(data, 16, types, 2, results) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC_Calculate_multi(NULL, 16, types, 1, results) ==
+         CRC_ERROR_NULL_DATA) &&
+        (CRC_Calculate_multi(data, 16, types, 1, NULL) ==
+         CRC_ERROR_NULL_DATA) &&
+        (CRC_Multi_Init(&ctx, NULL, 1) == CRC_ERROR_NULL_DATA) &&
+        (CRC_Multi_Identify(NULL, 16, 0, NULL, 0) == 0);
+    printf("  Invalid arguments rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Multi-Stream Test ===\n");
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 15);
+    }
+
+    bool all_tests_passed = true;
+
+    if (!run_pair_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_all_variants_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_stream_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_identify_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_empty_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 6\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
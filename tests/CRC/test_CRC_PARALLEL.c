@@ -0,0 +1,164 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "crc.h"
+#include "crc_parallel.h"
+#include "test_utils.h"
+
+#define PARALLEL_DATA_LEN (8 * 1024 * 1024 + 5)
+
+static uint8_t data[PARALLEL_DATA_LEN];
+
+typedef struct {
+    const char *description;
+    size_t threshold;
+    size_t num_threads;
+    size_t slice_len;
+    bool own_pool;
+} ParallelTestCase;
+
+static const ParallelTestCase test_cases[] = {
+    {"Defaults, process-wide pool", 0, 0, 0, false},
+    {"Own pool, one slice per thread", 1, 0, 0, true},
+    {"Own pool, odd slices", 1, 0, 1000003, true},
+    {"Own pool, small slices", 1, 0, 64 * 1024, true},
+    {"Own pool, two threads", 1, 2, 0, true},
+    {"Own pool, two threads, small slices", 1, 2, 64 * 1024, true},
+    {"Own pool, three threads, odd slices", 1, 3, 1000003, true},
+    {"Own pool, single thread", 1, 1, 0, true},
+    {"Own pool, above threshold", PARALLEL_DATA_LEN + 1, 0, 0, true},
+};
+
+#define PARALLEL_TESTS_COUNT (sizeof(test_cases) / sizeof(test_cases[0]))
+
+#if CRC_TEST_WRAP_THREAD_POOL
+/* Linked with --wrap=thread_pool_run: largest batch handed to the pool, so
+ * the thread limit can be checked */
+static size_t max_batch = 0;
+
+void __real_thread_pool_run(thread_pool_t *pool, thread_pool_task_t task,
+                            void *arg, size_t num_tasks);
+
+void __wrap_thread_pool_run(thread_pool_t *pool, thread_pool_task_t task,
+                            void *arg, size_t num_tasks) {
+    if (num_tasks > max_batch) {
+        max_batch = num_tasks;
+    }
+    __real_thread_pool_run(pool, task, arg, num_tasks);
+}
+#endif
+
+static const crc_t crc16_types[] = {CRC16_XMODEM, CRC16_MODBUS,
+                                    CRC16_RIELLO};
+static const crc_t crc32_types[] = {CRC32_ISO, CRC32_C, CRC32_MPEG_2,
+                                    CRC32_Q};
+
+static bool run_single_test(const ParallelTestCase *tc, size_t test_number,
+                            thread_pool_t *pool) {
+    crc_parallel_config_t config = {
+        .threshold = tc->threshold,
+        .num_threads = tc->num_threads,
+        .slice_len = tc->slice_len,
+        .pool = tc->own_pool ? pool : NULL,
+    };
+    bool test_passed = true;
+
+    printf("\n--- Test %zu: %s ---\n", test_number + 1, tc->description);
+#if CRC_TEST_WRAP_THREAD_POOL
+    max_batch = 0;
+#endif
+
+    for (size_t i = 0; i < sizeof(crc16_types) / sizeof(crc16_types[0]); i++) {
+        uint16_t crc = 0;
+        crc_error_t err = CRC16_Calculate_parallel(
+            data, PARALLEL_DATA_LEN, crc16_types[i], &config, &crc);
+        bool passed = (err == CRC_SUCCESS) &&
+                      (crc == CRC16(data, PARALLEL_DATA_LEN, crc16_types[i]));
+        printf("  %-14s: %s\n", get_crc_implementation_name(crc16_types[i]),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    for (size_t i = 0; i < sizeof(crc32_types) / sizeof(crc32_types[0]); i++) {
+        uint32_t crc = 0;
+        crc_error_t err = CRC32_Calculate_parallel(
+            data, PARALLEL_DATA_LEN, crc32_types[i], &config, &crc);
+        bool passed = (err == CRC_SUCCESS) &&
+                      (crc == CRC32(data, PARALLEL_DATA_LEN, crc32_types[i]));
+        printf("  %-14s: %s\n", get_crc_implementation_name(crc32_types[i]),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+
+#if CRC_TEST_WRAP_THREAD_POOL
+    // No more tasks than threads allowed, whatever the slice length
+    if (tc->num_threads != 0) {
+        bool passed = max_batch <= tc->num_threads;
+        printf("  Largest batch %zu, limit %zu: %s\n", max_batch,
+               tc->num_threads, passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+#endif
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_error_test(void) {
+    uint32_t crc32 = 0;
+    uint16_t crc16 = 0;
+    bool test_passed = true;
+
+    printf("\n--- Error handling test ---\n");
+
+    bool passed =
+        (CRC32_Calculate_parallel(data, 16, CRC16_XMODEM, NULL, &crc32) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC16_Calculate_parallel(data, 16, CRC32_ISO, NULL, &crc16) ==
+         CRC_ERROR_INVALID_TYPE) &&
+        (CRC32_Calculate_parallel(NULL, 16, CRC32_ISO, NULL, &crc32) ==
+         CRC_ERROR_NULL_DATA) &&
+        (CRC16_Calculate_parallel(data, 16, CRC16_XMODEM, NULL, NULL) ==
+         CRC_ERROR_NULL_DATA);
+    printf("  Invalid arguments rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Parallel Test ===\n");
+    printf("Online processors: %zu\n", thread_pool_get_cpu_count());
+
+    for (size_t i = 0; i < PARALLEL_DATA_LEN; i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    // Forced to four threads, so slicing and merging run on any machine
+    thread_pool_t *pool = thread_pool_create(4);
+    bool all_tests_passed = (pool != NULL);
+
+    for (size_t i = 0; i < PARALLEL_TESTS_COUNT; i++) {
+        if (!run_single_test(&test_cases[i], i, pool)) {
+            all_tests_passed = false;
+        }
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    thread_pool_destroy(pool);
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", PARALLEL_TESTS_COUNT + 1);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc.h"
+#include "test_utils.h"
+
+/* Long enough for the folding and interleaved engines, and odd sized */
+#define STREAM_DATA_LEN (64 * 1024 + 7)
+
+static uint8_t data[STREAM_DATA_LEN];
+
+/* Piece sizes fed to CRC_Update(), cycled through */
+static const size_t piece_sizes[] = {1, 15, 16, 17, 0, 31, 100, 4096, 3, 777};
+#define PIECE_SIZES_COUNT (sizeof(piece_sizes) / sizeof(piece_sizes[0]))
+
+static uint64_t oneshot_crc(const void *buf, size_t len, crc_t type) {
+    if (type <= CRC8_LTE) {
+        return CRC8(buf, len, type);
+    }
+    if (type <= CRC16_CDMA2000) {
+        return CRC16(buf, len, type);
+    }
+    if (type <= CRC32_XFER) {
+        return CRC32(buf, len, type);
+    }
+    return CRC64(buf, len, type);
+}
+
+static uint8_t crc_width(crc_t type) {
+    return (type <= CRC8_LTE)         ? 8
+           : (type <= CRC16_CDMA2000) ? 16
+           : (type <= CRC32_XFER)     ? 32
+                                      : 64;
+}
+
+/* CRC_Finalize, or CRC64_Finalize for CRC64 contexts */
+static crc_error_t finalize(const crc_ctx_t *ctx, uint64_t *result) {
+    if (ctx->width == 64) {
+        return CRC64_Finalize(ctx, result);
+    }
+    uint32_t crc = 0;
+    crc_error_t err = CRC_Finalize(ctx, &crc);
+    *result = crc;
+    return err;
+}
+
+/* Every variant streamed in pieces of varying size against the one-shot */
+static bool run_stream_test(void) {
+    bool test_passed = true;
+
+    printf("\n--- Streamed vs one-shot test ---\n");
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        crc_t type = (crc_t)t;
+        crc_ctx_t ctx;
+        bool passed = (CRC_Init(&ctx, type) == CRC_SUCCESS) &&
+                      (ctx.width == crc_width(type));
+
+        size_t pos = 0, piece = 0;
+        while (pos < STREAM_DATA_LEN) {
+            size_t chunk = piece_sizes[piece++ % PIECE_SIZES_COUNT];
+            if (chunk > STREAM_DATA_LEN - pos) {
+                chunk = STREAM_DATA_LEN - pos;
+            }
+            passed &= CRC_Update(&ctx, data + pos, chunk) == CRC_SUCCESS;
+            pos += chunk;
+        }
+        uint64_t crc = 0;
+        passed &= (finalize(&ctx, &crc) == CRC_SUCCESS) &&
+                  (crc == oneshot_crc(data, STREAM_DATA_LEN, type));
+
+        printf("  %-20s: %s\n", get_crc_implementation_name(type),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Streamed vs one-shot test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+/*
+ * CRC_Finalize leaves the context untouched: the CRC of every prefix can be
+ * read while streaming, and a second finalize gives the same value.
+ */
+static bool run_prefix_test(void) {
+    const crc_t types[] = {CRC8_MAXIM, CRC16_MODBUS, CRC16_XMODEM, CRC32_ISO,
+                           CRC32_C,    CRC32_MPEG_2, CRC64_XZ,
+                           CRC64_ECMA_182};
+    bool test_passed = true;
+
+    printf("\n--- Running CRC test ---\n");
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        crc_ctx_t ctx;
+        bool passed = CRC_Init(&ctx, types[i]) == CRC_SUCCESS;
+        for (size_t len = 1; len <= 300; len++) {
+            uint64_t crc = 0, again = 0;
+            CRC_Update(&ctx, data + len - 1, 1);
+            finalize(&ctx, &crc);
+            finalize(&ctx, &again);
+            passed &= (crc == again) &&
+                      (crc == oneshot_crc(data, len, types[i]));
+        }
+        printf("  %-20s: %s\n", get_crc_implementation_name(types[i]),
+               passed ? "PASSED" : "FAILED");
+        test_passed &= passed;
+    }
+    printf("Running CRC test result: %s\n", test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+static bool run_error_test(void) {
+    crc_ctx_t ctx;
+    uint32_t crc = 0;
+    bool test_passed = true;
+    bool passed;
+
+    printf("\n--- Error handling test ---\n");
+
+    passed = CRC_Init(&ctx, CRC_IMPL_COUNT) == CRC_ERROR_INVALID_TYPE;
+    printf("  Invalid type rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    passed = (CRC_Init(NULL, CRC32_ISO) == CRC_ERROR_NULL_DATA) &&
+             (CRC_Init(&ctx, CRC32_ISO) == CRC_SUCCESS) &&
+             (CRC_Update(&ctx, NULL, 1) == CRC_ERROR_NULL_DATA) &&
+             (CRC_Finalize(&ctx, NULL) == CRC_ERROR_NULL_DATA);
+    printf("  NULL pointers rejected: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // An empty stream is the reflected seed XORed with the final mask
+    passed = (CRC_Update(&ctx, NULL, 0) == CRC_SUCCESS) &&
+             (CRC_Finalize(&ctx, &crc) == CRC_SUCCESS) && (crc == 0);
+    passed &= (CRC_Init(&ctx, CRC16_RIELLO) == CRC_SUCCESS) &&
+              (CRC_Finalize(&ctx, &crc) == CRC_SUCCESS) && (crc == 0x554D);
+    printf("  Empty stream: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    printf("Error handling test result: %s\n",
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    printf("=== CRC Streaming API Test ===\n");
+
+    for (size_t i = 0; i < STREAM_DATA_LEN; i++) {
+        data[i] = (uint8_t)((i * 2654435761u) >> 13);
+    }
+
+    bool all_tests_passed = true;
+
+    if (!run_stream_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_prefix_test()) {
+        all_tests_passed = false;
+    }
+
+    if (!run_error_test()) {
+        all_tests_passed = false;
+    }
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: 3\n");
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
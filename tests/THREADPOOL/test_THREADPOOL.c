@@ -0,0 +1,135 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "thread_pool.h"
+
+static const char *TEST_NAME = "Thread pool tester";
+
+#define TASKS_COUNT 1000
+
+typedef struct {
+    atomic_uint runs[TASKS_COUNT];
+    thread_pool_t *pool;  // Pool used for nested batches, if any
+    atomic_uint nested_runs;
+} task_state_t;
+
+static void count_nested(void *arg, size_t index) {
+    task_state_t *state = (task_state_t *)arg;
+    (void)index;
+    atomic_fetch_add(&state->nested_runs, 1);
+}
+
+static void count_task(void *arg, size_t index) {
+    task_state_t *state = (task_state_t *)arg;
+    atomic_fetch_add(&state->runs[index], 1);
+    if (state->pool != NULL && index % 100 == 0) {
+        thread_pool_run(state->pool, count_nested, state, 3);
+    }
+}
+
+/* Every task index must run exactly once */
+static bool check_runs(task_state_t *state, size_t num_tasks) {
+    for (size_t i = 0; i < num_tasks; i++) {
+        if (atomic_load(&state->runs[i]) != 1) {
+            printf("  Task %zu ran %u times\n", i,
+                   atomic_load(&state->runs[i]));
+            return false;
+        }
+    }
+    return true;
+}
+
+static void reset(task_state_t *state) {
+    for (size_t i = 0; i < TASKS_COUNT; i++) {
+        atomic_init(&state->runs[i], 0);
+    }
+    atomic_init(&state->nested_runs, 0);
+    state->pool = NULL;
+}
+
+static bool run_single_test(size_t num_threads, size_t test_number) {
+    static task_state_t state;
+    bool test_passed = true;
+    bool passed;
+
+    printf("\n--- Test %zu: pool of %zu threads ---\n", test_number + 1,
+           num_threads);
+
+    thread_pool_t *pool = thread_pool_create(num_threads);
+    if (pool == NULL) {
+        printf("  Pool creation: FAILED\n");
+        return false;
+    }
+    size_t threads = thread_pool_get_num_threads(pool);
+    passed = (threads >= 1) && (threads <= THREAD_POOL_MAX_THREADS) &&
+             (THREAD_POOL_USE_PTHREADS == 0 || num_threads == 0 ||
+              threads == num_threads);
+    printf("  Thread count (%zu): %s\n", threads, passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    // Several batches in a row reuse the same workers
+    for (size_t batch = 0; batch < 20; batch++) {
+        size_t num_tasks = (batch * 53) % TASKS_COUNT + 1;
+        reset(&state);
+        thread_pool_run(pool, count_task, &state, num_tasks);
+        if (!check_runs(&state, num_tasks)) {
+            test_passed = false;
+        }
+    }
+    printf("  Repeated batches: %s\n", test_passed ? "PASSED" : "FAILED");
+
+    // Batches submitted from inside a task run serially in that task
+    reset(&state);
+    state.pool = pool;
+    thread_pool_run(pool, count_task, &state, TASKS_COUNT);
+    passed = check_runs(&state, TASKS_COUNT) &&
+             (atomic_load(&state.nested_runs) == 3 * (TASKS_COUNT / 100));
+    printf("  Nested batches: %s\n", passed ? "PASSED" : "FAILED");
+    test_passed &= passed;
+
+    thread_pool_destroy(pool);
+
+    printf("Test %zu result: %s\n", test_number + 1,
+           test_passed ? "PASSED" : "FAILED");
+    return test_passed;
+}
+
+int main(void) {
+    static const size_t thread_counts[] = {1, 2, 4, 7, 0};
+    const size_t tests_count = sizeof(thread_counts) / sizeof(thread_counts[0]);
+    static task_state_t state;
+    bool all_tests_passed = true;
+
+    printf("%s\n\n", TEST_NAME);
+    printf("Online processors: %zu\n", thread_pool_get_cpu_count());
+
+    for (size_t i = 0; i < tests_count; i++) {
+        if (!run_single_test(thread_counts[i], i)) {
+            all_tests_passed = false;
+        }
+    }
+
+    // NULL pool and the shared default pool
+    reset(&state);
+    thread_pool_run(NULL, count_task, &state, TASKS_COUNT);
+    bool passed = check_runs(&state, TASKS_COUNT);
+    reset(&state);
+    thread_pool_run(thread_pool_get_default(), count_task, &state,
+                    TASKS_COUNT);
+    passed &= check_runs(&state, TASKS_COUNT) &&
+              (thread_pool_get_default() == thread_pool_get_default());
+    printf("\nNULL and default pools: %s\n", passed ? "PASSED" : "FAILED");
+    all_tests_passed &= passed;
+
+    // Print final summary
+    printf("\n=== Test Summary ===\n");
+    printf("Total tests: %zu\n", tests_count + 1);
+    printf("Final result: %s\n",
+           all_tests_passed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+
+    return all_tests_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
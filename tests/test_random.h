@@ -0,0 +1,41 @@
+/**
+ * @file test_random.h
+ * @brief Deterministic pseudo-random test data (xorshift32)
+ *
+ * Each test seeds the generator once, so its inputs are the same on every
+ * run and every machine.
+ */
+#ifndef TEST_RANDOM_H
+#define TEST_RANDOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static uint32_t test_random_state = 0x12345678;
+
+/**
+ * @brief Restarts the sequence
+ * @param seed Any non-zero value
+ */
+static inline void seed_random(uint32_t seed) { test_random_state = seed; }
+
+/**
+ * @brief Returns the next 32-bit value of the sequence
+ */
+static inline uint32_t next_random(void) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return test_random_state;
+}
+
+/**
+ * @brief Fills a buffer with the low byte of the next values
+ */
+static inline void fill_random(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)next_random();
+    }
+}
+
+#endif /* TEST_RANDOM_H */
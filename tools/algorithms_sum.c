@@ -0,0 +1,461 @@
+/**
+ * @file algorithms_sum.c
+ * @brief Checksums and digests of files with the algorithms of the library
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ *   algorithms-sum [-a <algorithm>] [-j <threads>] [-q] [-l] [file...]
+ *
+ * The algorithm is any crc_t variant (CRC32_ISO, CRC64_XZ, ...), SHA1, SHA256
+ * or CHECKSUM8_XOR / CHECKSUM8_MODULO256 / CHECKSUM8_2COMPLEMENT (SHA256 by
+ * default). Every file prints "<digest>  <name>" on stdout, in the order
+ * given, and its size, time and throughput on stderr unless -q is given.
+ * Without files, or for "-", standard input is read.
+ *
+ * Regular files are mapped and walked once with MADV_SEQUENTIAL, so the
+ * kernel reads ahead and drops pages behind. Pipes and devices go through
+ * two buffers: a reader thread fills one while the other is hashed. Files
+ * are spread over a thread pool (one thread per processor unless -j says
+ * otherwise).
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SHA1.h"
+#include "SHA256.h"
+#include "checksum8.h"
+#include "crc.h"
+#include "thread_pool.h"
+
+/* Size of each of the two buffers of the read pipeline */
+#define SUM_READ_BUFFER_LEN (1024 * 1024)
+
+/* Longest digest, in hexadecimal digits with the terminator */
+#define SUM_HEX_LEN (2 * SHA256_DIGEST_SIZE_BYTES + 1)
+
+typedef enum {
+    SUM_CRC,
+    SUM_SHA1,
+    SUM_SHA256,
+    SUM_CHECKSUM8
+} sum_kind_t;
+
+typedef struct {
+    sum_kind_t kind;
+    crc_t crc_type;              // SUM_CRC
+    CHECKSUM8_t checksum_type;   // SUM_CHECKSUM8
+} sum_algorithm_t;
+
+/* Running state of one file */
+typedef struct {
+    const sum_algorithm_t *algorithm;
+    union {
+        crc_ctx_t crc;
+        SHA1_ctx_t sha1;
+        SHA256_ctx_t sha256;
+        uint8_t checksum;
+    } u;
+} sum_state_t;
+
+/* One file of the command line and its result */
+typedef struct {
+    const char *path;
+    const char *method;     // "mmap" or "read"
+    char digest[SUM_HEX_LEN];
+    uint64_t bytes;
+    double seconds;
+    int error;              // errno of the failure, 0 on success
+} sum_file_t;
+
+typedef struct {
+    const sum_algorithm_t *algorithm;
+    sum_file_t *files;
+} sum_job_t;
+
+/* Two buffers handed back and forth between the reader and the hasher */
+typedef struct {
+    int fd;
+    uint8_t *buffers[2];
+    size_t lens[2];
+    bool full[2];
+    int error;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} sum_pipeline_t;
+
+static const char *const checksum8_names[] = {
+    "CHECKSUM8_XOR", "CHECKSUM8_MODULO256", "CHECKSUM8_2COMPLEMENT"};
+
+static void sum_init(sum_state_t *state, const sum_algorithm_t *algorithm) {
+    state->algorithm = algorithm;
+    switch (algorithm->kind) {
+        case SUM_CRC:
+            CRC_Init(&state->u.crc, algorithm->crc_type);
+            break;
+        case SUM_SHA1:
+            sha1_init(&state->u.sha1);
+            break;
+        case SUM_SHA256:
+            SHA256_init(&state->u.sha256);
+            break;
+        case SUM_CHECKSUM8:
+            state->u.checksum = 0;
+            break;
+    }
+}
+
+static void sum_update(sum_state_t *state, const uint8_t *data, size_t len) {
+    switch (state->algorithm->kind) {
+        case SUM_CRC:
+            CRC_Update(&state->u.crc, data, len);
+            break;
+        case SUM_SHA1:
+            sha1_hash(&state->u.sha1, data, len);
+            break;
+        case SUM_SHA256:
+            SHA256_hash(&state->u.sha256, data, len);
+            break;
+        case SUM_CHECKSUM8:
+            // checksum8 takes 16-bit lengths: XOR and sums of the pieces
+            // combine, the two's complement is taken once at the end
+            while (len != 0) {
+                uint16_t n = (len < 0x8000) ? (uint16_t)len : 0x8000;
+                if (state->algorithm->checksum_type == CHECKSUM8_XOR) {
+                    state->u.checksum ^=
+                        checksum8((void *)data, n, CHECKSUM8_XOR);
+                } else {
+                    state->u.checksum +=
+                        checksum8((void *)data, n, CHECKSUM8_modulo256);
+                }
+                data += n;
+                len -= n;
+            }
+            break;
+    }
+}
+
+static void sum_final(sum_state_t *state, char *hex) {
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES];
+    size_t digest_len = 0;
+
+    switch (state->algorithm->kind) {
+        case SUM_CRC: {
+            uint64_t crc = 0;
+            if (state->u.crc.width == 64) {
+                CRC64_Finalize(&state->u.crc, &crc);
+            } else {
+                uint32_t crc32 = 0;
+                CRC_Finalize(&state->u.crc, &crc32);
+                crc = crc32;
+            }
+            snprintf(hex, SUM_HEX_LEN, "%0*llx", state->u.crc.width / 4,
+                     (unsigned long long)crc);
+            return;
+        }
+        case SUM_SHA1:
+            sha1_end(&state->u.sha1, digest);
+            digest_len = SHA1_DIGEST_SIZE_BYTES;
+            break;
+        case SUM_SHA256:
+            SHA256_end(&state->u.sha256, digest);
+            digest_len = SHA256_DIGEST_SIZE_BYTES;
+            break;
+        case SUM_CHECKSUM8:
+            digest[0] = state->u.checksum;
+            if (state->algorithm->checksum_type == CHECKSUM8_2complement) {
+                digest[0] = (uint8_t)(0x100 - digest[0]);
+            }
+            digest_len = 1;
+            break;
+    }
+    for (size_t i = 0; i < digest_len; i++) {
+        snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+    }
+}
+
+/* Reads until the buffer is full or the input ends */
+static size_t read_full(int fd, uint8_t *buf, size_t len, int *error) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = read(fd, buf + done, len - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            *error = errno;
+            break;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+    return done;
+}
+
+/* Fills the buffers in turn; a short buffer marks the end of the input */
+static void *pipeline_reader(void *arg) {
+    sum_pipeline_t *pipeline = (sum_pipeline_t *)arg;
+
+    for (int i = 0;; i ^= 1) {
+        pthread_mutex_lock(&pipeline->lock);
+        while (pipeline->full[i]) {
+            pthread_cond_wait(&pipeline->cond, &pipeline->lock);
+        }
+        pthread_mutex_unlock(&pipeline->lock);
+
+        int error = 0;
+        size_t n = read_full(pipeline->fd, pipeline->buffers[i],
+                             SUM_READ_BUFFER_LEN, &error);
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->lens[i] = n;
+        pipeline->full[i] = true;
+        if (error != 0) {
+            pipeline->error = error;
+        }
+        pthread_cond_broadcast(&pipeline->cond);
+        pthread_mutex_unlock(&pipeline->lock);
+        if (n < SUM_READ_BUFFER_LEN) {
+            return NULL;
+        }
+    }
+}
+
+/* Hashes one buffer while the reader thread fills the other */
+static int sum_pipeline(int fd, sum_state_t *state, uint64_t *bytes) {
+    sum_pipeline_t pipeline = {.fd = fd};
+    pthread_t reader;
+    int error = 0;
+
+    pipeline.buffers[0] = malloc(2 * SUM_READ_BUFFER_LEN);
+    if (pipeline.buffers[0] == NULL) {
+        return ENOMEM;
+    }
+    pipeline.buffers[1] = pipeline.buffers[0] + SUM_READ_BUFFER_LEN;
+    pthread_mutex_init(&pipeline.lock, NULL);
+    pthread_cond_init(&pipeline.cond, NULL);
+
+    error = pthread_create(&reader, NULL, pipeline_reader, &pipeline);
+    for (int i = 0; error == 0; i ^= 1) {
+        pthread_mutex_lock(&pipeline.lock);
+        while (!pipeline.full[i]) {
+            pthread_cond_wait(&pipeline.cond, &pipeline.lock);
+        }
+        size_t n = pipeline.lens[i];
+        pthread_mutex_unlock(&pipeline.lock);
+
+        sum_update(state, pipeline.buffers[i], n);
+        *bytes += n;
+
+        pthread_mutex_lock(&pipeline.lock);
+        pipeline.full[i] = false;
+        pthread_cond_broadcast(&pipeline.cond);
+        pthread_mutex_unlock(&pipeline.lock);
+        if (n < SUM_READ_BUFFER_LEN) {
+            pthread_join(reader, NULL);
+            error = pipeline.error;
+            break;
+        }
+    }
+
+    pthread_cond_destroy(&pipeline.cond);
+    pthread_mutex_destroy(&pipeline.lock);
+    free(pipeline.buffers[0]);
+    return error;
+}
+
+/* Walks a mapping of a regular file once, front to back */
+static int sum_mapped(int fd, size_t len, sum_state_t *state,
+                      uint64_t *bytes) {
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        return errno;
+    }
+    madvise(map, len, MADV_SEQUENTIAL);
+    sum_update(state, (const uint8_t *)map, len);
+    *bytes = len;
+    munmap(map, len);
+    return 0;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void sum_file_task(void *arg, size_t index) {
+    sum_job_t *job = (sum_job_t *)arg;
+    sum_file_t *file = &job->files[index];
+    bool is_stdin = strcmp(file->path, "-") == 0;
+    sum_state_t state;
+    struct stat st;
+
+    double start = now_seconds();
+    int fd = is_stdin ? STDIN_FILENO : open(file->path, O_RDONLY);
+    if (fd < 0) {
+        file->error = errno;
+        return;
+    }
+    sum_init(&state, job->algorithm);
+    if (fstat(fd, &st) != 0) {
+        file->error = errno;
+    } else if (S_ISDIR(st.st_mode)) {
+        file->error = EISDIR;
+    } else if (S_ISREG(st.st_mode) && st.st_size > 0 &&
+               (uint64_t)st.st_size <= SIZE_MAX) {
+        file->method = "mmap";
+        file->error = sum_mapped(fd, (size_t)st.st_size, &state, &file->bytes);
+        if (file->error == ENOMEM || file->error == ENODEV) {
+            // No room for the mapping (32-bit) or a file system without mmap
+            file->method = "read";
+            file->error = sum_pipeline(fd, &state, &file->bytes);
+        }
+    } else {
+        file->method = "read";
+        file->error = sum_pipeline(fd, &state, &file->bytes);
+    }
+    if (file->error == 0) {
+        sum_final(&state, file->digest);
+    }
+    if (!is_stdin) {
+        close(fd);
+    }
+    file->seconds = now_seconds() - start;
+}
+
+static bool find_algorithm(const char *name, sum_algorithm_t *algorithm) {
+    if (strcasecmp(name, "SHA1") == 0) {
+        algorithm->kind = SUM_SHA1;
+        return true;
+    }
+    if (strcasecmp(name, "SHA256") == 0) {
+        algorithm->kind = SUM_SHA256;
+        return true;
+    }
+    for (int c = 0; c < 3; c++) {
+        if (strcasecmp(name, checksum8_names[c]) == 0) {
+            algorithm->kind = SUM_CHECKSUM8;
+            algorithm->checksum_type = (CHECKSUM8_t)c;
+            return true;
+        }
+    }
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        if (strcasecmp(name, get_crc_implementation_name((crc_t)t)) == 0) {
+            algorithm->kind = SUM_CRC;
+            algorithm->crc_type = (crc_t)t;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void list_algorithms(void) {
+    printf("SHA1\nSHA256\n");
+    for (int c = 0; c < 3; c++) {
+        printf("%s\n", checksum8_names[c]);
+    }
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        printf("%s\n", get_crc_implementation_name((crc_t)t));
+    }
+}
+
+static int usage(void) {
+    fprintf(stderr,
+            "usage: algorithms-sum [-a <algorithm>] [-j <threads>] [-q] "
+            "[file...]\n"
+            "       algorithms-sum -l\n"
+            "  -a  algorithm (default SHA256, -l lists them)\n"
+            "  -j  files processed at once (default one per processor)\n"
+            "  -q  no throughput report on stderr\n");
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+    sum_algorithm_t algorithm = {.kind = SUM_SHA256};
+    size_t threads = 0;
+    bool quiet = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:j:ql")) != -1) {
+        switch (opt) {
+            case 'a':
+                if (!find_algorithm(optarg, &algorithm)) {
+                    fprintf(stderr, "algorithms-sum: unknown algorithm '%s'\n",
+                            optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'j':
+                threads = (size_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            case 'l':
+                list_algorithms();
+                return EXIT_SUCCESS;
+            default:
+                return usage();
+        }
+    }
+
+    static char *const stdin_path[] = {"-"};
+    char *const *paths = (optind < argc) ? argv + optind : stdin_path;
+    size_t count = (optind < argc) ? (size_t)(argc - optind) : 1;
+
+    sum_file_t *files = calloc(count, sizeof(*files));
+    if (files == NULL) {
+        fprintf(stderr, "algorithms-sum: out of memory\n");
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        files[i].path = paths[i];
+        files[i].method = "read";
+    }
+
+    // A single file (or pipe) gains nothing from the pool
+    thread_pool_t *pool = NULL;
+    if (count > 1 && threads != 1) {
+        pool = thread_pool_create(threads);
+    }
+    sum_job_t job = {&algorithm, files};
+    thread_pool_run(pool, sum_file_task, &job, count);
+    thread_pool_destroy(pool);
+
+    int status = EXIT_SUCCESS;
+    for (size_t i = 0; i < count; i++) {
+        const sum_file_t *file = &files[i];
+        if (file->error != 0) {
+            fprintf(stderr, "algorithms-sum: %s: %s\n", file->path,
+                    strerror(file->error));
+            status = EXIT_FAILURE;
+            continue;
+        }
+        printf("%s  %s\n", file->digest, file->path);
+        if (!quiet) {
+            double mbps = (file->seconds > 0)
+                              ? (double)file->bytes / file->seconds / 1e6
+                              : 0.0;
+            fprintf(stderr, "%s: %llu bytes in %.3f s, %.1f MB/s (%s)\n",
+                    file->path, (unsigned long long)file->bytes,
+                    file->seconds, mbps, file->method);
+        }
+    }
+    free(files);
+    return status;
+}
@@ -0,0 +1,467 @@
+/**
+ * @file crc_gen.c
+ * @brief Build-time generator of CRC functions specialized for one variant
+ * @version 0.1
+ * @date 2025-03-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Emits <name>.h and <name>.c holding the tables of one CRC as literals and
+ * an update loop with every parameter folded in: no variant switch, no
+ * reflection on the hot path. Run through crc_generate() in CMake:
+ *
+ *   crc_gen <name> <out_dir> --variant <crc_t name> [--slice-by 1|8]
+ *   crc_gen <name> <out_dir> --params <width> <poly> <init> <refin> <refout>
+ *           <xorout> [--slice-by 1|8]
+ *
+ * Slice-by-1 keeps one table of the width of the CRC (for firmware), while
+ * slice-by-8 folds 8 bytes per step on 16 KiB of 64-bit tables.
+ */
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crc.h"
+#include "crc_engine.h"
+
+/* Parameters of the generated function */
+typedef struct {
+    const char *name;
+    const char *source;  // Variant name or "custom parameters"
+    crc_params_t params;
+    unsigned slice_by;   // 1 or 8
+    unsigned bits;       // Width of the result type: 8, 16, 32 or 64
+    unsigned reg_bits;   // Width of the register type
+} crc_gen_spec_t;
+
+static uint64_t reflect(uint64_t value, uint8_t width) {
+    uint64_t out = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        out = (out << 1) | ((value >> i) & 1);
+    }
+    return out;
+}
+
+static uint64_t width_mask(uint8_t width) {
+    return (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+}
+
+/* CRC of "123456789", bit by bit as in the catalogue definition */
+static uint64_t check_value(const crc_params_t *p) {
+    const char *check = "123456789";
+    uint64_t top = 1ULL << (p->width - 1);
+    uint64_t reg = p->init;
+    for (const char *c = check; *c != '\0'; c++) {
+        uint8_t byte = p->refin ? (uint8_t)reflect((uint8_t)*c, 8) : (uint8_t)*c;
+        for (int bit = 7; bit >= 0; bit--) {
+            bool feedback = ((reg & top) != 0) != (((byte >> bit) & 1) != 0);
+            reg = (reg << 1) & width_mask(p->width);
+            if (feedback) {
+                reg ^= p->poly;
+            }
+        }
+    }
+    if (p->refout) {
+        reg = reflect(reg, p->width);
+    }
+    return reg ^ p->xorout;
+}
+
+/*
+ * Tables in register alignment: reflected registers are right-aligned, normal
+ * ones left-aligned in reg_bits. table[k][b] is the contribution of byte b
+ * followed by k zero bytes.
+ */
+static void build_tables(const crc_gen_spec_t *spec, uint64_t table[8][256]) {
+    const crc_params_t *p = &spec->params;
+    unsigned shift = spec->reg_bits - p->width;
+    uint64_t mask = width_mask((uint8_t)spec->reg_bits);
+    uint64_t top = 1ULL << (spec->reg_bits - 1);
+    uint64_t poly =
+        p->refin ? reflect(p->poly, p->width) : (p->poly << shift) & mask;
+
+    for (uint32_t b = 0; b < 256; b++) {
+        uint64_t reg = p->refin ? b : ((uint64_t)b << (spec->reg_bits - 8));
+        for (uint8_t i = 0; i != 8; i++) {
+            if (p->refin) {
+                reg = (reg & 1) ? (reg >> 1) ^ poly : (reg >> 1);
+            } else {
+                reg = (reg & top) ? ((reg << 1) ^ poly) & mask
+                                  : (reg << 1) & mask;
+            }
+        }
+        table[0][b] = reg;
+    }
+    for (unsigned k = 1; k < spec->slice_by; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint64_t prev = table[k - 1][b];
+            table[k][b] = p->refin
+                              ? (prev >> 8) ^ table[0][prev & 0xFF]
+                              : ((prev << 8) & mask) ^
+                                    table[0][prev >> (spec->reg_bits - 8)];
+        }
+    }
+}
+
+static const char *hex_suffix(unsigned bits) {
+    return (bits == 64) ? "ULL" : "U";
+}
+
+static void emit_hex(FILE *out, uint64_t value, unsigned bits) {
+    fprintf(out, "0x%0*llX%s", (int)(bits / 4), (unsigned long long)value,
+            hex_suffix(bits));
+}
+
+static bool emit_header(const crc_gen_spec_t *spec, const char *path,
+                        const char *upper) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return false;
+    }
+    const crc_params_t *p = &spec->params;
+    const char *n = spec->name;
+    uint64_t reg_init = p->refin ? reflect(p->init, p->width)
+                                 : p->init << (spec->reg_bits - p->width);
+    size_t table_bytes = spec->slice_by * 256 * (spec->reg_bits / 8);
+
+    fprintf(out, "/**\n");
+    fprintf(out, " * @file %s.h\n", n);
+    fprintf(out, " * @brief %s specialized by crc_gen, do not edit\n",
+            spec->source);
+    fprintf(out, " *\n");
+    fprintf(out, " * width %u, poly 0x%llX, init 0x%llX, refin %s, refout %s, "
+                 "xorout 0x%llX\n",
+            p->width, (unsigned long long)p->poly,
+            (unsigned long long)p->init, p->refin ? "true" : "false",
+            p->refout ? "true" : "false", (unsigned long long)p->xorout);
+    fprintf(out, " * Slice-by-%u, %zu bytes of tables.\n", spec->slice_by,
+            table_bytes);
+    fprintf(out, " */\n\n");
+    fprintf(out, "#ifndef %s_H\n#define %s_H\n\n", upper, upper);
+    fprintf(out, "#include <stddef.h>\n#include <stdint.h>\n\n");
+    fprintf(out, "/** @brief CRC of \"123456789\" */\n");
+    fprintf(out, "#define %s_CHECK ", upper);
+    emit_hex(out, check_value(p), spec->bits);
+    fprintf(out, "\n\n");
+    fprintf(out, "/** @brief Register between updates%s */\n",
+            p->refin ? ", bit reversed" : "");
+    fprintf(out, "typedef uint%u_t %s_reg_t;\n\n", spec->reg_bits, n);
+    fprintf(out, "/** @brief Register value before the first byte */\n");
+    fprintf(out, "static inline %s_reg_t %s_init(void) {\n", n, n);
+    fprintf(out, "    return ");
+    emit_hex(out, reg_init, spec->reg_bits);
+    fprintf(out, ";\n}\n\n");
+    fprintf(out, "/** @brief Runs a chunk of data through the register */\n");
+    fprintf(out, "%s_reg_t %s_update(%s_reg_t reg, const void *data,\n", n, n,
+            n);
+    fprintf(out, "    size_t data_len);\n\n");
+    fprintf(out, "/** @brief CRC value of a register */\n");
+    fprintf(out, "uint%u_t %s_finalize(%s_reg_t reg);\n\n", spec->bits, n, n);
+    fprintf(out, "/** @brief CRC of a buffer */\n");
+    fprintf(out, "uint%u_t %s(const void *data, size_t data_len);\n\n",
+            spec->bits, n);
+    fprintf(out, "#endif /*%s_H*/\n", upper);
+    return fclose(out) == 0;
+}
+
+static void emit_table(FILE *out, const crc_gen_spec_t *spec,
+                       uint64_t table[8][256]) {
+    unsigned per_line = (spec->reg_bits <= 16) ? 8 : 128 / spec->reg_bits;
+    bool sliced = spec->slice_by > 1;
+
+    if (sliced) {
+        fprintf(out, "static const uint%u_t %s_table[%u][256] = {\n",
+                spec->reg_bits, spec->name, spec->slice_by);
+    } else {
+        fprintf(out, "static const uint%u_t %s_table[256] = {\n",
+                spec->reg_bits, spec->name);
+    }
+    for (unsigned k = 0; k < spec->slice_by; k++) {
+        const char *indent = sliced ? "        " : "    ";
+        if (sliced) {
+            fprintf(out, "    {\n");
+        }
+        for (unsigned b = 0; b < 256; b++) {
+            fprintf(out, "%s", (b % per_line == 0) ? indent : " ");
+            emit_hex(out, table[k][b], spec->reg_bits);
+            fprintf(out, "%s", (b == 255) ? "\n"
+                               : (b % per_line == per_line - 1) ? ",\n"
+                                                                : ",");
+        }
+        if (sliced) {
+            fprintf(out, "    }%s\n", (k + 1 < spec->slice_by) ? "," : "");
+        }
+    }
+    fprintf(out, "};\n\n");
+}
+
+/* Byte step of the register, "p" pointing at the input */
+static void emit_byte_step(FILE *out, const crc_gen_spec_t *spec,
+                           const char *table, const char *indent) {
+    unsigned rb = spec->reg_bits;
+    if (rb == 8) {
+        fprintf(out, "%sreg = %s[reg ^ *p++];\n", indent, table);
+    } else if (spec->params.refin) {
+        fprintf(out, "%sreg = (%s_reg_t)((reg >> 8) ^ %s[(uint8_t)(reg ^ "
+                     "*p++)]);\n",
+                indent, spec->name, table);
+    } else {
+        fprintf(out, "%sreg = (%s_reg_t)((reg << 8) ^ %s[(reg >> %u) ^ "
+                     "*p++]);\n",
+                indent, spec->name, table, rb - 8);
+    }
+}
+
+static void emit_update(FILE *out, const crc_gen_spec_t *spec) {
+    const char *n = spec->name;
+    fprintf(out, "%s_reg_t %s_update(%s_reg_t reg, const void *data,\n", n, n,
+            n);
+    fprintf(out, "    size_t data_len) {\n");
+    fprintf(out, "    const uint8_t *p = (const uint8_t *)data;\n");
+    if (spec->slice_by == 1) {
+        char table[300];
+        snprintf(table, sizeof(table), "%s_table", n);
+        fprintf(out, "    while (data_len-- != 0) {\n");
+        emit_byte_step(out, spec, table, "        ");
+        fprintf(out, "    }\n    return reg;\n}\n\n");
+        return;
+    }
+
+    fprintf(out, "    const uint64_t (*t)[256] = %s_table;\n", n);
+    fprintf(out, "    while (data_len >= 8) {\n");
+    if (spec->params.refin) {
+        fprintf(out, "        reg ^= load_le64(p);\n");
+        fprintf(out, "        p += 8;\n        data_len -= 8;\n");
+        fprintf(out, "        reg = t[7][reg & 0xFF] ^ t[6][(reg >> 8) & 0xFF] ^\n");
+        fprintf(out, "              t[5][(reg >> 16) & 0xFF] ^ t[4][(reg >> 24) & 0xFF] ^\n");
+        fprintf(out, "              t[3][(reg >> 32) & 0xFF] ^ t[2][(reg >> 40) & 0xFF] ^\n");
+        fprintf(out, "              t[1][(reg >> 48) & 0xFF] ^ t[0][reg >> 56];\n");
+    } else {
+        fprintf(out, "        reg ^= load_be64(p);\n");
+        fprintf(out, "        p += 8;\n        data_len -= 8;\n");
+        fprintf(out, "        reg = t[7][reg >> 56] ^ t[6][(reg >> 48) & 0xFF] ^\n");
+        fprintf(out, "              t[5][(reg >> 40) & 0xFF] ^ t[4][(reg >> 32) & 0xFF] ^\n");
+        fprintf(out, "              t[3][(reg >> 24) & 0xFF] ^ t[2][(reg >> 16) & 0xFF] ^\n");
+        fprintf(out, "              t[1][(reg >> 8) & 0xFF] ^ t[0][reg & 0xFF];\n");
+    }
+    fprintf(out, "    }\n");
+    fprintf(out, "    while (data_len-- != 0) {\n");
+    emit_byte_step(out, spec, "t[0]", "        ");
+    fprintf(out, "    }\n    return reg;\n}\n\n");
+}
+
+static void emit_finalize(FILE *out, const crc_gen_spec_t *spec) {
+    const crc_params_t *p = &spec->params;
+    const char *n = spec->name;
+    unsigned shift = spec->reg_bits - p->width;
+    // Normal registers are left-aligned, reflected ones already reversed
+    bool reverse = (p->refin != p->refout);
+
+    fprintf(out, "uint%u_t %s_finalize(%s_reg_t reg) {\n", spec->bits, n, n);
+    if (!p->refin && shift != 0) {
+        fprintf(out, "    reg >>= %u;\n", shift);
+    }
+    if (reverse) {
+        fprintf(out, "    reg = (%s_reg_t)%s_reflect(reg);\n", n, n);
+    }
+    fprintf(out, "    return (uint%u_t)", spec->bits);
+    if (p->xorout != 0) {
+        fprintf(out, "(reg ^ ");
+        emit_hex(out, p->xorout, spec->bits);
+        fprintf(out, ")");
+    } else {
+        fprintf(out, "reg");
+    }
+    fprintf(out, ";\n}\n\n");
+}
+
+static bool emit_source(const crc_gen_spec_t *spec, const char *path) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return false;
+    }
+    const crc_params_t *p = &spec->params;
+    const char *n = spec->name;
+    static uint64_t table[8][256];
+    build_tables(spec, table);
+
+    fprintf(out, "/**\n");
+    fprintf(out, " * @file %s.c\n", n);
+    fprintf(out, " * @brief %s specialized by crc_gen, do not edit\n",
+            spec->source);
+    fprintf(out, " */\n");
+    fprintf(out, "#include \"%s.h\"\n\n", n);
+    emit_table(out, spec, table);
+
+    if (spec->slice_by > 1) {
+        if (p->refin) {
+            fprintf(out,
+                    "static inline uint64_t load_le64(const uint8_t *p) {\n"
+                    "    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) |\n"
+                    "           ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |\n"
+                    "           ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |\n"
+                    "           ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);\n"
+                    "}\n\n");
+        } else {
+            fprintf(out,
+                    "static inline uint64_t load_be64(const uint8_t *p) {\n"
+                    "    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |\n"
+                    "           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |\n"
+                    "           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |\n"
+                    "           ((uint64_t)p[6] << 8) | (uint64_t)p[7];\n"
+                    "}\n\n");
+        }
+    }
+    if (p->refin != p->refout) {
+        // Only for a refin different from refout, at finalize
+        fprintf(out,
+                "static uint64_t %s_reflect(uint64_t v) {\n"
+                "    v = ((v >> 1) & 0x5555555555555555ULL) |\n"
+                "        ((v & 0x5555555555555555ULL) << 1);\n"
+                "    v = ((v >> 2) & 0x3333333333333333ULL) |\n"
+                "        ((v & 0x3333333333333333ULL) << 2);\n"
+                "    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) |\n"
+                "        ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);\n"
+                "    v = ((v >> 8) & 0x00FF00FF00FF00FFULL) |\n"
+                "        ((v & 0x00FF00FF00FF00FFULL) << 8);\n"
+                "    v = ((v >> 16) & 0x0000FFFF0000FFFFULL) |\n"
+                "        ((v & 0x0000FFFF0000FFFFULL) << 16);\n"
+                "    v = (v >> 32) | (v << 32);\n"
+                "    return v >> %u;\n"
+                "}\n\n",
+                n, 64 - p->width);
+    }
+
+    emit_update(out, spec);
+    emit_finalize(out, spec);
+    fprintf(out, "uint%u_t %s(const void *data, size_t data_len) {\n",
+            spec->bits, n);
+    fprintf(out, "    return %s_finalize(%s_update(%s_init(), data, "
+                 "data_len));\n}\n",
+            n, n, n);
+    return fclose(out) == 0;
+}
+
+static bool parse_bool(const char *arg, bool *value) {
+    if (strcmp(arg, "true") == 0 || strcmp(arg, "1") == 0) {
+        *value = true;
+    } else if (strcmp(arg, "false") == 0 || strcmp(arg, "0") == 0) {
+        *value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parse_u64(const char *arg, uint64_t *value) {
+    char *end = NULL;
+    *value = strtoull(arg, &end, 0);
+    return end != arg && *end == '\0';
+}
+
+static bool find_variant(const char *name, crc_params_t *params) {
+    for (int t = 0; t < CRC_IMPL_COUNT; t++) {
+        if (strcmp(get_crc_implementation_name((crc_t)t), name) == 0) {
+            return CRC_getParams((crc_t)t, params) == CRC_SUCCESS;
+        }
+    }
+    return false;
+}
+
+static int usage(void) {
+    fprintf(stderr,
+            "usage: crc_gen <name> <out_dir> --variant <crc_t name> "
+            "[--slice-by 1|8]\n"
+            "       crc_gen <name> <out_dir> --params <width> <poly> <init> "
+            "<refin> <refout> <xorout> [--slice-by 1|8]\n");
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+    crc_gen_spec_t spec = {0};
+    bool have_params = false;
+
+    if (argc < 5) {
+        return usage();
+    }
+    spec.name = argv[1];
+    spec.slice_by = 1;
+    for (const char *c = spec.name; *c != '\0'; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') {
+            fprintf(stderr, "crc_gen: invalid function name '%s'\n",
+                    spec.name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--variant") == 0 && i + 1 < argc) {
+            spec.source = argv[++i];
+            if (!find_variant(spec.source, &spec.params)) {
+                fprintf(stderr, "crc_gen: unknown variant '%s'\n",
+                        spec.source);
+                return EXIT_FAILURE;
+            }
+            have_params = true;
+        } else if (strcmp(argv[i], "--params") == 0 && i + 6 < argc) {
+            crc_params_t *p = &spec.params;
+            uint64_t width = 0;
+            if (!parse_u64(argv[i + 1], &width) || width == 0 || width > 64 ||
+                !parse_u64(argv[i + 2], &p->poly) ||
+                !parse_u64(argv[i + 3], &p->init) ||
+                !parse_bool(argv[i + 4], &p->refin) ||
+                !parse_bool(argv[i + 5], &p->refout) ||
+                !parse_u64(argv[i + 6], &p->xorout) ||
+                (p->poly & ~width_mask((uint8_t)width)) != 0) {
+                fprintf(stderr, "crc_gen: invalid parameters\n");
+                return EXIT_FAILURE;
+            }
+            p->width = (uint8_t)width;
+            p->init &= width_mask(p->width);
+            p->xorout &= width_mask(p->width);
+            spec.source = "Custom CRC";
+            have_params = true;
+            i += 6;
+        } else if (strcmp(argv[i], "--slice-by") == 0 && i + 1 < argc) {
+            spec.slice_by = (unsigned)strtoul(argv[++i], NULL, 10);
+            if (spec.slice_by != 1 && spec.slice_by != 8) {
+                fprintf(stderr, "crc_gen: slice-by must be 1 or 8\n");
+                return EXIT_FAILURE;
+            }
+        } else {
+            return usage();
+        }
+    }
+    if (!have_params) {
+        return usage();
+    }
+
+    uint8_t width = spec.params.width;
+    spec.bits = (width <= 8) ? 8 : (width <= 16) ? 16 : (width <= 32) ? 32 : 64;
+    spec.reg_bits = (spec.slice_by > 1) ? 64 : spec.bits;
+
+    char upper[256];
+    char path[4096];
+    size_t len = strlen(spec.name);
+    if (len >= sizeof(upper)) {
+        return usage();
+    }
+    for (size_t i = 0; i <= len; i++) {
+        upper[i] = (char)toupper((unsigned char)spec.name[i]);
+    }
+
+    snprintf(path, sizeof(path), "%s/%s.h", argv[2], spec.name);
+    if (!emit_header(&spec, path, upper)) {
+        fprintf(stderr, "crc_gen: cannot write %s\n", path);
+        return EXIT_FAILURE;
+    }
+    snprintf(path, sizeof(path), "%s/%s.c", argv[2], spec.name);
+    if (!emit_source(&spec, path)) {
+        fprintf(stderr, "crc_gen: cannot write %s\n", path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}